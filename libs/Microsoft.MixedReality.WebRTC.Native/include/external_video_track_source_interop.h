@@ -5,6 +5,87 @@
 
 #include "interop_api.h"
 
+/// Policy of an external video track source for the frame requests whose
+/// deadline passed while the source was late, for example because the capture
+/// thread was not scheduled in time.
+enum class mrsFrameSchedulePolicy : int32_t {
+  /// Skip the missed frame requests, and resume with the next deadline in the
+  /// future. This keeps the latency low at the expense of the frame rate.
+  kSkip = 0,
+
+  /// Issue the missed frame requests back-to-back to catch up with the
+  /// schedule, up to a few frames, so that the average frame rate is
+  /// preserved.
+  kCatchUp = 1,
+};
+
+/// Policy of a push-mode external video track source for the frames pushed
+/// while the source is still delivering a previous frame pushed from another
+/// thread.
+enum class mrsPushFrameDropPolicy : int32_t {
+  /// Drop the newly pushed frame and return immediately. This never blocks
+  /// the producer, at the expense of the frame rate.
+  kDrop = 0,
+
+  /// Block the producer until the previous frame is delivered, then deliver
+  /// the new frame. This applies back-pressure to the producer.
+  kWait = 1,
+};
+
+/// Policy of an external video track source for static frames, whose pixels
+/// are identical to the ones of the previous frame, for example the frames of
+/// an idle screen or document being shared. Static frames are detected with a
+/// hash of the frame, which is much cheaper than converting and encoding it.
+/// To bound the effect of two different frames having the same hash, a frame
+/// is always converted at least once per second, even if static.
+enum class mrsStaticFramePolicy : int32_t {
+  /// Convert and send all frames. This avoids the cost of hashing the frames
+  /// for sources which are rarely static, like camera captures.
+  kNone = 0,
+
+  /// Send static frames by repeating the buffer of the previous frame, without
+  /// converting them again. This keeps the frame rate constant for the remote
+  /// peer. Frames provided without copy are never repeated, to not delay the
+  /// release of their memory.
+  kRepeat = 1,
+
+  /// Drop static frames, so that the encoder does not encode them either. The
+  /// remote peer keeps showing the last frame received.
+  kDrop = 2,
+};
+
+/// Video format currently wanted by the video tracks of an external video
+/// track source. It is reduced when their encoders adapt to the CPU load or
+/// the available bandwidth. Frames larger or more frequent than wanted are
+/// cropped and scaled down, or dropped, by the source; producing the frames in
+/// the wanted format to begin with avoids that work and the rendering of
+/// pixels which are never sent.
+struct mrsWantedVideoFormat {
+  /// Wanted frame width, in pixels. This is at most the native width passed
+  /// to |mrsExternalVideoTrackSourceGetWantedFormat()|.
+  int32_t width_;
+
+  /// Wanted frame height, in pixels. This is at most the native height passed
+  /// to |mrsExternalVideoTrackSourceGetWantedFormat()|.
+  int32_t height_;
+
+  /// Maximum wanted frame rate, in frames per second, or |INT32_MAX| if the
+  /// frame rate is not limited.
+  int32_t max_framerate_;
+};
+
+/// Rectangular region of a video frame, in pixels from the top left corner.
+struct mrsVideoRect {
+  int32_t x_;
+  int32_t y_;
+  int32_t width_;
+  int32_t height_;
+};
+
+/// Callback invoked once the memory of a video frame passed to an external
+/// video track source without copy is not used anymore, and can be reused.
+using mrsVideoFrameReleaseCallback = void(MRS_CALL*)(void* user_data);
+
 extern "C" {
 
 //
@@ -41,15 +122,57 @@ MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromArgb32Callback(
     void* user_data,
     ExternalVideoTrackSourceHandle* source_handle_out) noexcept;
 
+/// Same as |mrsExternalVideoTrackSourceCreateFromArgb32Callback()|, with the
+/// frame provided as an NV12-encoded buffer, converted once to I420.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromNv12Callback(
+    mrsRequestExternalNv12VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept;
+
+/// Same as |mrsExternalVideoTrackSourceCreateFromArgb32Callback()|, with the
+/// frame provided as a YUY2-encoded buffer, converted once to I420.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromYuy2Callback(
+    mrsRequestExternalYuy2VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept;
+
+/// Same as |mrsExternalVideoTrackSourceCreateFromArgb32Callback()|, with the
+/// frame provided as a BGR24-encoded buffer, converted once to I420.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromBgr24Callback(
+    mrsRequestExternalBgr24VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept;
+
+/// Same as |mrsExternalVideoTrackSourceCreateFromArgb32Callback()|, with the
+/// frame provided as an RGBA32-encoded buffer, converted once to I420.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromRgba32Callback(
+    mrsRequestExternalRgba32VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept;
+
+/// Create a custom video track source external to the implementation, which
+/// delivers the frames pushed by the caller with
+/// |mrsExternalVideoTrackSourcePushI420AFrame()| or the other
+/// |mrsExternalVideoTrackSourcePushXxxFrame()| functions, instead of
+/// requesting them from a callback. This allows a producer with its own clock
+/// to deliver its frames as soon as they are available, without any request
+/// round trip. This returns a handle to a newly allocated object, which must be
+/// released once not used anymore with
+/// |mrsExternalVideoTrackSourceRemoveRef()|.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateForPush(
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept;
+
 /// Callback from the wrapper layer indicating that the wrapper has finished
 /// creation, and it is safe to start sending frame requests to it. This needs
-/// to be called after |mrsExternalVideoTrackSourceCreateFromI420ACallback()| or
-/// |mrsExternalVideoTrackSourceCreateFromArgb32Callback()| to finish the
+/// to be called after any of the
+/// |mrsExternalVideoTrackSourceCreateFromXxxCallback()| functions to finish the
 /// creation of the video track source and allow it to start capturing.
 MRS_API void MRS_CALL mrsExternalVideoTrackSourceFinishCreation(
     ExternalVideoTrackSourceHandle source_handle) noexcept;
 
-/// Complete a video frame request with a provided I420A video frame.
+/// Complete a video frame request with a provided I420A video frame. Any source
+/// accepts frames of any encoding, whatever the encoding of the frames it
+/// requests; frames not in I420 are converted once to I420.
 MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteI420AFrameRequest(
     ExternalVideoTrackSourceHandle handle,
     uint32_t request_id,
@@ -64,6 +187,193 @@ mrsExternalVideoTrackSourceCompleteArgb32FrameRequest(
     int64_t timestamp_ms,
     const mrsArgb32VideoFrame* frame_view) noexcept;
 
+/// Complete a video frame request with a provided NV12 video frame.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteNv12FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsNv12VideoFrame* frame_view) noexcept;
+
+/// Complete a video frame request with a provided YUY2 video frame.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteYuy2FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsYuy2VideoFrame* frame_view) noexcept;
+
+/// Complete a video frame request with a provided BGR24 video frame.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteBgr24FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsBgr24VideoFrame* frame_view) noexcept;
+
+/// Complete a video frame request with a provided RGBA32 video frame.
+MRS_API mrsResult MRS_CALL
+mrsExternalVideoTrackSourceCompleteRgba32FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsRgba32VideoFrame* frame_view) noexcept;
+
+/// Push a new I420A video frame to a source created with
+/// |mrsExternalVideoTrackSourceCreateForPush()|, to be delivered synchronously
+/// to its video tracks with the given timestamp. The frame is dropped if its
+/// timestamp is not strictly after the one of the last delivered frame, or if
+/// another frame is being delivered and the drop policy of the source is
+/// |mrsPushFrameDropPolicy::kDrop|, or if the video tracks of the source do
+/// not want it, for example because their encoders reduced the frame rate. On
+/// success, |dropped_out|, if not null, is set to indicate whether the frame
+/// was dropped.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushI420AFrame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsI420AVideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept;
+
+/// Push a new ARGB32 video frame to a source created with
+/// |mrsExternalVideoTrackSourceCreateForPush()|. See
+/// |mrsExternalVideoTrackSourcePushI420AFrame()| for details.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushArgb32Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept;
+
+/// Push a new NV12 video frame to a source created with
+/// |mrsExternalVideoTrackSourceCreateForPush()|. See
+/// |mrsExternalVideoTrackSourcePushI420AFrame()| for details.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushNv12Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsNv12VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept;
+
+/// Push a new YUY2 video frame to a source created with
+/// |mrsExternalVideoTrackSourceCreateForPush()|. See
+/// |mrsExternalVideoTrackSourcePushI420AFrame()| for details.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushYuy2Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsYuy2VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept;
+
+/// Push a new BGR24 video frame to a source created with
+/// |mrsExternalVideoTrackSourceCreateForPush()|. See
+/// |mrsExternalVideoTrackSourcePushI420AFrame()| for details.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushBgr24Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsBgr24VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept;
+
+/// Push a new RGBA32 video frame to a source created with
+/// |mrsExternalVideoTrackSourceCreateForPush()|. See
+/// |mrsExternalVideoTrackSourcePushI420AFrame()| for details.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushRgba32Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsRgba32VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept;
+
+/// Set the policy of a push source for frames pushed while a previous frame is
+/// still being delivered. The default is |mrsPushFrameDropPolicy::kDrop|.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceSetPushDropPolicy(
+    ExternalVideoTrackSourceHandle handle,
+    mrsPushFrameDropPolicy policy) noexcept;
+
+/// Complete a video frame request with a provided I420A video frame, without
+/// copying its memory, which the encoder reads directly. The frame memory must
+/// remain valid and unchanged until |release_callback| is invoked, which
+/// happens exactly once, on any thread, possibly before this call returns if
+/// the frame is not used, for example because the request is invalid. This can
+/// be used with any source, whatever its frame encoding. The alpha plane, if
+/// any, is ignored.
+MRS_API mrsResult MRS_CALL
+mrsExternalVideoTrackSourceCompleteI420AFrameRequestNoCopy(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsI420AVideoFrame* frame_view,
+    mrsVideoFrameReleaseCallback release_callback,
+    void* release_user_data) noexcept;
+
+/// Same as |mrsExternalVideoTrackSourcePushI420AFrame()|, without copying the
+/// frame memory. The memory must remain valid and unchanged until
+/// |release_callback| is invoked, as with
+/// |mrsExternalVideoTrackSourceCompleteI420AFrameRequestNoCopy()|.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushI420AFrameNoCopy(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsI420AVideoFrame* frame_view,
+    mrsVideoFrameReleaseCallback release_callback,
+    void* release_user_data,
+    mrsBool* dropped_out) noexcept;
+
+/// Complete a video frame request with a provided ARGB32 video frame of which
+/// only the given dirty regions changed since the previous frame provided to
+/// the source with dirty regions. The source keeps a persistent I420 frame, in
+/// which only the dirty regions are converted, so that the cost of the frames
+/// of mostly static sources, like user interfaces, scales with the changed
+/// area instead of the frame size. |frame_view| must still describe the entire
+/// frame, which is converted as a whole for the first frame, or if the frame
+/// size changed. Dirty regions are clipped to the frame, and expanded to even
+/// coordinates for chroma subsampling. If the previous frame is still being
+/// encoded, it is copied once before being updated. This can be used with any
+/// source, whatever its frame encoding. Return |kInvalidOperation| if the
+/// source was shut down.
+MRS_API mrsResult MRS_CALL
+mrsExternalVideoTrackSourceCompleteArgb32FrameRequestDirty(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view,
+    const mrsVideoRect* dirty_rects,
+    int32_t dirty_rect_count) noexcept;
+
+/// Same as |mrsExternalVideoTrackSourcePushArgb32Frame()|, updating only the
+/// given dirty regions as with
+/// |mrsExternalVideoTrackSourceCompleteArgb32FrameRequestDirty()|. Since
+/// dropping the frame would lose its update, the frame waits for any frame
+/// being delivered by another thread, whatever the drop policy of the source.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourcePushArgb32FrameDirty(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view,
+    const mrsVideoRect* dirty_rects,
+    int32_t dirty_rect_count,
+    mrsBool* dropped_out) noexcept;
+
+/// Set the rate at which the source requests frames, in frames per second.
+/// Frame requests are scheduled against absolute deadlines, so the effective
+/// frame rate does not drift over time. The default is 30 frames per second.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceSetFrameRate(
+    ExternalVideoTrackSourceHandle handle,
+    double frame_rate) noexcept;
+
+/// Set the policy of the source for frame requests whose deadline passed while
+/// the source was late. The default is |mrsFrameSchedulePolicy::kSkip|.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceSetSchedulePolicy(
+    ExternalVideoTrackSourceHandle handle,
+    mrsFrameSchedulePolicy policy) noexcept;
+
+/// Get the video format currently wanted by the video tracks of the source,
+/// for frames whose resolution would otherwise be the given native resolution.
+/// The wanted resolution preserves the aspect ratio of the native resolution.
+/// This is cheap enough to be called for each frame, for example from the
+/// frame request callback, to render the frame at the wanted resolution.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceGetWantedFormat(
+    ExternalVideoTrackSourceHandle handle,
+    int32_t native_width,
+    int32_t native_height,
+    mrsWantedVideoFormat* format_out) noexcept;
+
+/// Set the policy of the source for static frames, identical to the previous
+/// frame. The default is |mrsStaticFramePolicy::kNone|.
+MRS_API mrsResult MRS_CALL mrsExternalVideoTrackSourceSetStaticFramePolicy(
+    ExternalVideoTrackSourceHandle handle,
+    mrsStaticFramePolicy policy) noexcept;
+
 /// Irreversibly stop the video source frame production and shutdown the video
 /// source.
 MRS_API void MRS_CALL mrsExternalVideoTrackSourceShutdown(
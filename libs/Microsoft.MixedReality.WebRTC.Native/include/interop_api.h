@@ -107,6 +107,12 @@ using PeerConnectionHandle = void*;
 /// Opaque handle to a native LocalVideoTrack C++ object.
 using LocalVideoTrackHandle = void*;
 
+/// Opaque handle to a native RemoteVideoTrack C++ object.
+using RemoteVideoTrackHandle = void*;
+
+/// Opaque handle to a native RemoteAudioTrack C++ object.
+using RemoteAudioTrackHandle = void*;
+
 /// Opaque handle to a native DataChannel C++ object.
 using DataChannelHandle = void*;
 
@@ -197,6 +203,38 @@ using PeerConnectionTrackAddedCallback = void(MRS_CALL*)(void* user_data,
 using PeerConnectionTrackRemovedCallback =
     void(MRS_CALL*)(void* user_data, TrackKind track_kind);
 
+/// Callback fired when a remote video track is added to a connection. The
+/// track handle is valid until the remote video track removed callback is
+/// fired for the same track, unless a reference is added to it with
+/// |mrsRemoteVideoTrackAddRef()|.
+using PeerConnectionRemoteVideoTrackAddedCallback =
+    void(MRS_CALL*)(void* user_data,
+                    RemoteVideoTrackHandle track_handle,
+                    const char* track_id);
+
+/// Callback fired when a remote video track is removed from a connection. No
+/// frame is delivered by the track after this callback is fired.
+using PeerConnectionRemoteVideoTrackRemovedCallback =
+    void(MRS_CALL*)(void* user_data,
+                    RemoteVideoTrackHandle track_handle,
+                    const char* track_id);
+
+/// Callback fired when a remote audio track is added to a connection. The
+/// track handle is valid until the remote audio track removed callback is
+/// fired for the same track, unless a reference is added to it with
+/// |mrsRemoteAudioTrackAddRef()|.
+using PeerConnectionRemoteAudioTrackAddedCallback =
+    void(MRS_CALL*)(void* user_data,
+                    RemoteAudioTrackHandle track_handle,
+                    const char* track_id);
+
+/// Callback fired when a remote audio track is removed from a connection. No
+/// frame is delivered by the track after this callback is fired.
+using PeerConnectionRemoteAudioTrackRemovedCallback =
+    void(MRS_CALL*)(void* user_data,
+                    RemoteAudioTrackHandle track_handle,
+                    const char* track_id);
+
 /// Callback fired when a data channel is added to the peer connection after
 /// being negotiated with the remote peer.
 using PeerConnectionDataChannelAddedCallback =
@@ -210,6 +248,14 @@ using PeerConnectionDataChannelRemovedCallback =
                     mrsDataChannelInteropHandle data_channel_wrapper,
                     DataChannelHandle data_channel);
 
+using mrsVideoFrameFormat = Microsoft::MixedReality::WebRTC::VideoFrameFormat;
+
+using mrsVideoFrameDeliveryMode =
+    Microsoft::MixedReality::WebRTC::VideoFrameDeliveryMode;
+
+using mrsVideoFrameLatencyStats =
+    Microsoft::MixedReality::WebRTC::VideoFrameLatencyStats;
+
 using mrsI420AVideoFrame = Microsoft::MixedReality::WebRTC::I420AVideoFrame;
 
 /// Callback fired when a local or remote (depending on use) video frame is
@@ -226,6 +272,38 @@ using mrsArgb32VideoFrame = Microsoft::MixedReality::WebRTC::Argb32VideoFrame;
 using PeerConnectionArgb32VideoFrameCallback =
     void(MRS_CALL*)(void* user_data, const mrsArgb32VideoFrame& frame);
 
+using mrsNv12VideoFrame = Microsoft::MixedReality::WebRTC::Nv12VideoFrame;
+
+/// Callback fired when a remote video frame is available to be consumed by the
+/// caller. The video frame is encoded in NV12 biplanar format.
+using PeerConnectionNv12VideoFrameCallback =
+    void(MRS_CALL*)(void* user_data, const mrsNv12VideoFrame& frame);
+
+using mrsRgba32VideoFrame = Microsoft::MixedReality::WebRTC::Rgba32VideoFrame;
+
+/// Callback fired when a remote video frame is available to be consumed by the
+/// caller. The video frame is encoded in RGBA 32-bit per pixel.
+using PeerConnectionRgba32VideoFrameCallback =
+    void(MRS_CALL*)(void* user_data, const mrsRgba32VideoFrame& frame);
+
+using mrsBgr24VideoFrame = Microsoft::MixedReality::WebRTC::Bgr24VideoFrame;
+
+/// Callback fired when a remote video frame is available to be consumed by the
+/// caller. The video frame is encoded in BGR 24-bit per pixel.
+using PeerConnectionBgr24VideoFrameCallback =
+    void(MRS_CALL*)(void* user_data, const mrsBgr24VideoFrame& frame);
+
+using mrsYuy2VideoFrame = Microsoft::MixedReality::WebRTC::Yuy2VideoFrame;
+
+using mrsI420PackedVideoFrame =
+    Microsoft::MixedReality::WebRTC::I420PackedVideoFrame;
+
+/// Callback fired when a remote video frame is available to be consumed by the
+/// caller. The video frame is encoded in I420 triplanar format, with all
+/// planes packed in a single contiguous memory block.
+using PeerConnectionI420PackedVideoFrameCallback =
+    void(MRS_CALL*)(void* user_data, const mrsI420PackedVideoFrame& frame);
+
 using mrsAudioFrame = Microsoft::MixedReality::WebRTC::AudioFrame;
 
 /// Callback fired when a local or remote (depending on use) audio frame is
@@ -380,6 +458,38 @@ MRS_API void MRS_CALL mrsPeerConnectionRegisterTrackRemovedCallback(
     PeerConnectionTrackRemovedCallback callback,
     void* user_data) noexcept;
 
+/// Register a callback fired when a remote video track is added to the current
+/// peer connection. Unlike the callback registered with
+/// |mrsPeerConnectionRegisterTrackAddedCallback()|, this provides a handle to
+/// the track, which allows receiving its frames separately from other tracks.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterRemoteVideoTrackAddedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteVideoTrackAddedCallback callback,
+    void* user_data) noexcept;
+
+/// Register a callback fired when a remote video track is removed from the
+/// current peer connection.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterRemoteVideoTrackRemovedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteVideoTrackRemovedCallback callback,
+    void* user_data) noexcept;
+
+/// Register a callback fired when a remote audio track is added to the current
+/// peer connection. Unlike the callback registered with
+/// |mrsPeerConnectionRegisterTrackAddedCallback()|, this provides a handle to
+/// the track, which allows receiving its audio separately from other tracks.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteAudioTrackAddedCallback callback,
+    void* user_data) noexcept;
+
+/// Register a callback fired when a remote audio track is removed from the
+/// current peer connection.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterRemoteAudioTrackRemovedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteAudioTrackRemovedCallback callback,
+    void* user_data) noexcept;
+
 /// Register a callback fired when a remote data channel is removed from the
 /// current peer connection.
 MRS_API void MRS_CALL mrsPeerConnectionRegisterDataChannelAddedCallback(
@@ -408,6 +518,130 @@ MRS_API void MRS_CALL mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(
     PeerConnectionArgb32VideoFrameCallback callback,
     void* user_data) noexcept;
 
+/// Register a callback fired when a video frame from a video track was received
+/// from the remote peer, converted to NV12. The conversion is done directly
+/// from the decoded frame into a pooled buffer, in a single pass.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterNv12RemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionNv12VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Register a callback fired when a video frame from a video track was received
+/// from the remote peer, converted to RGBA32. The conversion is done directly
+/// from the decoded frame into a pooled buffer, in a single pass.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterRgba32RemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRgba32VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Register a callback fired when a video frame from a video track was received
+/// from the remote peer, converted to BGR24. The conversion is done directly
+/// from the decoded frame into a pooled buffer, in a single pass.
+MRS_API void MRS_CALL mrsPeerConnectionRegisterBgr24RemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionBgr24VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Register a callback fired when a video frame from a video track was received
+/// from the remote peer, copied as I420 into a single contiguous memory block.
+/// The copy is done directly from the decoded frame into a pooled buffer.
+MRS_API void MRS_CALL
+mrsPeerConnectionRegisterI420PackedRemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionI420PackedVideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Set the maximum number of threads used to convert each remote video frame
+/// for the ARGB32, NV12, RGBA32, BGR24 and packed I420 remote video frame
+/// callbacks, including the thread delivering the frame. The default of 1
+/// disables parallel conversion.
+/// Higher values split large frames (e.g. 1080p and above) into stripes
+/// converted on a shared worker pool, which reduces the per-frame latency at
+/// the expense of more CPU cores. The output is identical in all cases.
+MRS_API mrsResult MRS_CALL
+mrsPeerConnectionSetRemoteVideoConversionParallelism(
+    PeerConnectionHandle peerHandle,
+    int32_t max_parallelism) noexcept;
+
+/// Set the maximum dimensions of the remote video frames delivered to the
+/// callback registered for |format|. Larger frames are scaled down in a single
+/// pass, preserving their aspect ratio, before being converted to |format|, so
+/// that callbacks rendering small views like thumbnails only pay for the pixels
+/// they display. A zero |width| or |height| delivers frames at their decoded
+/// resolution, which is the default. Scaled frames have no alpha plane.
+/// When all registered callbacks have a target size, the largest one is also
+/// set as |rtc::VideoSinkWants::max_pixel_count| on the remote video tracks.
+MRS_API mrsResult MRS_CALL mrsPeerConnectionSetRemoteVideoFrameTargetSize(
+    PeerConnectionHandle peerHandle,
+    mrsVideoFrameFormat format,
+    int32_t width,
+    int32_t height) noexcept;
+
+/// Set the delivery mode of the remote video frames to the frame callbacks. By
+/// default, callbacks are invoked inline on the WebRTC decoder thread for each
+/// frame. In |kPolled| mode, the decoder thread only keeps a reference to the
+/// latest frame and returns immediately, and the frame is converted and
+/// delivered to the callbacks when the application calls
+/// |mrsPeerConnectionPollRemoteVideoFrame()|, typically once per render loop
+/// iteration. Frames replaced by a newer one before being polled are never
+/// converted.
+MRS_API mrsResult MRS_CALL mrsPeerConnectionSetRemoteVideoDeliveryMode(
+    PeerConnectionHandle peerHandle,
+    mrsVideoFrameDeliveryMode mode) noexcept;
+
+/// In |kPolled| delivery mode, deliver the latest remote video frame received
+/// since the previous call, if any, to the frame callbacks on the calling
+/// thread. Return |mrsBool::kTrue| if a frame was delivered.
+MRS_API mrsBool MRS_CALL
+mrsPeerConnectionPollRemoteVideoFrame(PeerConnectionHandle peerHandle) noexcept;
+
+/// Register a ring of |count| application-owned buffers of |size| bytes each,
+/// into which remote video frames for the callback registered with
+/// |mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback()| are converted
+/// directly, with rows |stride| bytes apart. This avoids copying the frame out
+/// of an internal buffer, for example when the buffers are persistently mapped
+/// staging buffers. The frame passed to the callback points into one of the
+/// buffers, which is then reserved until released with
+/// |mrsPeerConnectionReleaseArgb32RemoteVideoFrameDestination()|. Frames
+/// arriving while all buffers are reserved, or which do not fit into a buffer,
+/// are dropped. The buffers must remain valid until unregistered by calling
+/// this function again with a |count| of zero, which reverts to internal
+/// buffers. On return, previously registered buffers are not written anymore.
+MRS_API mrsResult MRS_CALL
+mrsPeerConnectionSetArgb32RemoteVideoFrameDestinations(
+    PeerConnectionHandle peerHandle,
+    void* const* buffers,
+    int32_t count,
+    uint64_t size,
+    int32_t stride) noexcept;
+
+/// Release a buffer registered with
+/// |mrsPeerConnectionSetArgb32RemoteVideoFrameDestinations()| once the
+/// application is done with the frame it holds, so it can receive a new frame.
+/// This can be called from any thread.
+MRS_API mrsResult MRS_CALL
+mrsPeerConnectionReleaseArgb32RemoteVideoFrameDestination(
+    PeerConnectionHandle peerHandle,
+    const void* buffer) noexcept;
+
+/// Opaque handle to a native reference-counted video frame buffer, as exposed
+/// by |mrsArgb32VideoFrame::buffer_handle_|.
+using VideoFrameBufferHandle = void*;
+
+/// Retain the video frame buffer associated with the given handle, to keep
+/// accessing the frame data after the frame callback returned. This avoids
+/// copying the frame data. Retained buffers are not reused for new frames, so
+/// consumers should release them as soon as possible with
+/// |mrsVideoFrameBufferRemoveRef()|, otherwise each new frame requires a fresh
+/// buffer allocation.
+MRS_API void MRS_CALL
+mrsVideoFrameBufferAddRef(VideoFrameBufferHandle handle) noexcept;
+
+/// Release a video frame buffer previously retained with
+/// |mrsVideoFrameBufferAddRef()|. This can be called from any thread.
+MRS_API void MRS_CALL
+mrsVideoFrameBufferRemoveRef(VideoFrameBufferHandle handle) noexcept;
+
 /// Kind of video profile. Equivalent to org::webRtc::VideoProfileKind.
 enum class VideoProfileKind : int32_t {
   kUnspecified,
@@ -436,7 +670,9 @@ MRS_API void MRS_CALL mrsPeerConnectionRegisterLocalAudioFrameCallback(
     void* user_data) noexcept;
 
 /// Register a callback fired when an audio frame from an audio track was
-/// received from the remote peer.
+/// received from the remote peer. Frames of all remote audio tracks are
+/// delivered to this callback; use |mrsRemoteAudioTrackRegisterFrameCallback()|
+/// to receive the frames of each track separately.
 MRS_API void MRS_CALL mrsPeerConnectionRegisterRemoteAudioFrameCallback(
     PeerConnectionHandle peerHandle,
     PeerConnectionAudioFrameCallback callback,
@@ -503,23 +739,44 @@ MRS_API mrsResult MRS_CALL mrsPeerConnectionAddLocalVideoTrack(
     VideoDeviceConfiguration config,
     LocalVideoTrackHandle* trackHandle) noexcept;
 
-using mrsRequestExternalI420AVideoFrameCallback =
+/// Callback requesting a new video frame from a custom video source external
+/// to the implementation. The callback must complete the request identified by
+/// |request_id| with one of the |mrsExternalVideoTrackSourceCompleteXxx()|
+/// functions, or return an error. The callback is invoked on a capture thread
+/// shared with other sources, so should return quickly, and may complete the
+/// request later from another thread.
+using mrsRequestExternalVideoFrameCallback =
     mrsResult(MRS_CALL*)(void* user_data,
                          ExternalVideoTrackSourceHandle source_handle,
                          uint32_t request_id,
                          int64_t timestamp_ms);
 
+using mrsRequestExternalI420AVideoFrameCallback =
+    mrsRequestExternalVideoFrameCallback;
+
 using mrsRequestExternalArgb32VideoFrameCallback =
-    mrsResult(MRS_CALL*)(void* user_data,
-                         ExternalVideoTrackSourceHandle source_handle,
-                         uint32_t request_id,
-                         int64_t timestamp_ms);
+    mrsRequestExternalVideoFrameCallback;
+
+using mrsRequestExternalNv12VideoFrameCallback =
+    mrsRequestExternalVideoFrameCallback;
+
+using mrsRequestExternalYuy2VideoFrameCallback =
+    mrsRequestExternalVideoFrameCallback;
+
+using mrsRequestExternalBgr24VideoFrameCallback =
+    mrsRequestExternalVideoFrameCallback;
+
+using mrsRequestExternalRgba32VideoFrameCallback =
+    mrsRequestExternalVideoFrameCallback;
 
 /// Add a local video track from a custom video source external to the
 /// implementation. This allows feeding into WebRTC frames from any source,
 /// including generated or synthetic frames, for example for testing.
 /// The track source initially starts as capuring. Capture can be stopped with
 /// |mrsExternalVideoTrackSourceShutdown|.
+/// The same source can be used to add tracks to several peer connections, in
+/// which case each frame is converted once and the same frame buffer is sent
+/// to all tracks.
 /// This returns a handle to a newly allocated object, which must be released
 /// once not used anymore with |mrsLocalVideoTrackRemoveRef()|.
 MRS_API mrsResult MRS_CALL
@@ -536,8 +793,8 @@ MRS_API mrsResult MRS_CALL mrsPeerConnectionRemoveLocalVideoTrack(
     LocalVideoTrackHandle track_handle) noexcept;
 
 /// Remove all local video tracks backed by the given video track source from
-/// the given peer connection and destroy the video track source.
-/// After this call returned, the video track source handle is invalid.
+/// the given peer connection. The video track source handle stays valid, and
+/// the source keeps feeding its tracks on other peer connections, if any.
 MRS_API mrsResult MRS_CALL mrsPeerConnectionRemoveLocalVideoTracksFromSource(
     PeerConnectionHandle peer_handle,
     ExternalVideoTrackSourceHandle source_handle) noexcept;
@@ -601,11 +858,30 @@ MRS_API mrsResult MRS_CALL mrsPeerConnectionRemoveLocalVideoTrack(
 MRS_API void MRS_CALL mrsPeerConnectionRemoveLocalAudioTrack(
     PeerConnectionHandle peerHandle) noexcept;
 
+/// Sample format in which an audio read stream resamples the remote audio,
+/// when its sample rate differs from the one read.
+enum class mrsAudioResampleMode : int32_t {
+  /// Resample 16-bit samples, then convert them to float. This is the default.
+  kInt16 = 0,
+
+  /// Convert samples to float, then resample them with a vectorized
+  /// windowed-sinc resampler. This avoids quantizing the resampled audio to
+  /// 16 bits, at a higher CPU cost.
+  kFloat = 1,
+};
+
 MRS_API mrsResult MRS_CALL
 mrsAudioReadStreamCreate(PeerConnectionHandle peerHandle,
                          int bufferMs,
                          AudioReadStreamHandle* readStreamOut);
 
+/// Same as |mrsAudioReadStreamCreate()|, with a given resampling mode.
+MRS_API mrsResult MRS_CALL
+mrsAudioReadStreamCreateWithResampleMode(PeerConnectionHandle peerHandle,
+                                         int bufferMs,
+                                         mrsAudioResampleMode resampleMode,
+                                         AudioReadStreamHandle* readStreamOut);
+
 MRS_API mrsResult MRS_CALL
 mrsAudioReadStreamRead(AudioReadStreamHandle readStream,
                        int sampleRate,
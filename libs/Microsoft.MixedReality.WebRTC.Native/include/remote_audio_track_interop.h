@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "interop_api.h"
+
+extern "C" {
+
+//
+// Wrapper
+//
+
+/// Add a reference to the native object associated with the given handle.
+MRS_API void MRS_CALL
+mrsRemoteAudioTrackAddRef(RemoteAudioTrackHandle handle) noexcept;
+
+/// Remove a reference from the native object associated with the given handle.
+MRS_API void MRS_CALL
+mrsRemoteAudioTrackRemoveRef(RemoteAudioTrackHandle handle) noexcept;
+
+/// Register a custom callback to be called when the remote audio track
+/// received a frame. Frames of other remote audio tracks of the same peer
+/// connection are not delivered to this callback.
+MRS_API void MRS_CALL mrsRemoteAudioTrackRegisterFrameCallback(
+    RemoteAudioTrackHandle trackHandle,
+    PeerConnectionAudioFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Same as |mrsAudioReadStreamCreateWithResampleMode()|, for a stream reading
+/// the audio of a single remote audio track. The stream holds a reference to
+/// the track, and outputs silence once the track is removed. The stream uses
+/// the frame callback of the track, replacing any callback registered with
+/// |mrsRemoteAudioTrackRegisterFrameCallback()|. Destroying the stream leaves
+/// in place any callback registered after the stream was created.
+MRS_API mrsResult MRS_CALL
+mrsRemoteAudioTrackCreateReadStream(RemoteAudioTrackHandle trackHandle,
+                                    int bufferMs,
+                                    mrsAudioResampleMode resampleMode,
+                                    AudioReadStreamHandle* readStreamOut);
+
+}  // extern "C"
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "interop_api.h"
+
+extern "C" {
+
+//
+// Wrapper
+//
+
+/// Add a reference to the native object associated with the given handle.
+MRS_API void MRS_CALL
+mrsRemoteVideoTrackAddRef(RemoteVideoTrackHandle handle) noexcept;
+
+/// Remove a reference from the native object associated with the given handle.
+MRS_API void MRS_CALL
+mrsRemoteVideoTrackRemoveRef(RemoteVideoTrackHandle handle) noexcept;
+
+/// Register a custom callback to be called when the remote video track
+/// received a frame. The received frames is passed to the registered callback
+/// in I420 encoding. Frames of other remote video tracks of the same peer
+/// connection are not delivered to this callback.
+MRS_API void MRS_CALL mrsRemoteVideoTrackRegisterI420AFrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionI420AVideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Register a custom callback to be called when the remote video track
+/// received a frame. The received frames is passed to the registered callback
+/// in ARGB32 encoding.
+MRS_API void MRS_CALL mrsRemoteVideoTrackRegisterArgb32FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionArgb32VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Same as |mrsRemoteVideoTrackRegisterArgb32FrameCallback()|, for NV12 frames.
+MRS_API void MRS_CALL mrsRemoteVideoTrackRegisterNv12FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionNv12VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Same as |mrsRemoteVideoTrackRegisterArgb32FrameCallback()|, for RGBA32
+/// frames.
+MRS_API void MRS_CALL mrsRemoteVideoTrackRegisterRgba32FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionRgba32VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Same as |mrsRemoteVideoTrackRegisterArgb32FrameCallback()|, for BGR24
+/// frames.
+MRS_API void MRS_CALL mrsRemoteVideoTrackRegisterBgr24FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionBgr24VideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Same as |mrsRemoteVideoTrackRegisterArgb32FrameCallback()|, for I420 frames
+/// packed into a single contiguous buffer.
+MRS_API void MRS_CALL mrsRemoteVideoTrackRegisterI420PackedFrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionI420PackedVideoFrameCallback callback,
+    void* user_data) noexcept;
+
+/// Same as |mrsPeerConnectionSetRemoteVideoFrameTargetSize()|, for the frame
+/// callbacks of a single remote video track.
+MRS_API mrsResult MRS_CALL
+mrsRemoteVideoTrackSetFrameTargetSize(RemoteVideoTrackHandle trackHandle,
+                                      mrsVideoFrameFormat format,
+                                      int32_t width,
+                                      int32_t height) noexcept;
+
+/// Same as |mrsPeerConnectionSetRemoteVideoDeliveryMode()|, for the frame
+/// callbacks of a single remote video track.
+MRS_API mrsResult MRS_CALL
+mrsRemoteVideoTrackSetDeliveryMode(RemoteVideoTrackHandle trackHandle,
+                                   mrsVideoFrameDeliveryMode mode) noexcept;
+
+/// Same as |mrsPeerConnectionPollRemoteVideoFrame()|, for a single remote
+/// video track.
+MRS_API mrsBool MRS_CALL
+mrsRemoteVideoTrackPollFrame(RemoteVideoTrackHandle trackHandle) noexcept;
+
+/// Same as |mrsPeerConnectionSetRemoteVideoConversionParallelism()|, for a
+/// single remote video track. This applies to the ARGB32, NV12, RGBA32, BGR24
+/// and packed I420 frame callbacks of the track.
+MRS_API mrsResult MRS_CALL mrsRemoteVideoTrackSetConversionParallelism(
+    RemoteVideoTrackHandle trackHandle,
+    int32_t max_parallelism) noexcept;
+
+/// Get the latency statistics of the frames delivered to the frame callbacks
+/// of a remote video track, from receiving each decoded frame to invoking a
+/// callback, and of the time spent inside the callbacks.
+MRS_API mrsResult MRS_CALL
+mrsRemoteVideoTrackGetLatencyStats(RemoteVideoTrackHandle trackHandle,
+                                   mrsVideoFrameLatencyStats* stats) noexcept;
+
+/// Reset the latency statistics of a remote video track.
+MRS_API mrsResult MRS_CALL mrsRemoteVideoTrackResetLatencyStats(
+    RemoteVideoTrackHandle trackHandle) noexcept;
+
+}  // extern "C"
@@ -7,6 +7,52 @@
 
 namespace Microsoft::MixedReality::WebRTC {
 
+/// Format of the video frames delivered to a frame callback.
+enum class VideoFrameFormat : int32_t {
+  kI420A = 0,
+  kArgb32 = 1,
+  kNv12 = 2,
+  kRgba32 = 3,
+  kBgr24 = 4,
+  kI420Packed = 5,
+};
+
+/// Delivery mode of the video frames to the frame callbacks.
+enum class VideoFrameDeliveryMode : int32_t {
+  /// Callbacks are invoked on the thread producing the frames, like the WebRTC
+  /// decoder thread, as soon as each frame is available.
+  kInline = 0,
+
+  /// Only the latest frame is kept until the application polls for it, and
+  /// callbacks are invoked on the polling thread. Frames replaced by a newer
+  /// one before being polled are never converted.
+  kPolled = 1,
+};
+
+/// Timing metadata of a video frame, to correlate it with the frame sent by
+/// the remote peer and measure latency. All local times use the same monotonic
+/// clock as |rtc::TimeMicros()|.
+struct VideoFrameTiming {
+  /// Sequence number assigned to each frame received by a frame observer,
+  /// starting from 1. Gaps indicate frames dropped before delivery.
+  std::int64_t frame_id_;
+
+  /// Local time at which the frame is expected to be rendered, in
+  /// microseconds, as set by the decoder.
+  std::int64_t timestamp_us_;
+
+  /// Capture time of the frame on the sender, in milliseconds since the NTP
+  /// epoch, or zero until the sender clock is estimated from RTCP reports.
+  std::int64_t ntp_time_ms_;
+
+  /// Local time at which the frame observer received the decoded frame, in
+  /// microseconds.
+  std::int64_t received_time_us_;
+
+  /// RTP timestamp of the frame, in units of the 90 kHz RTP video clock.
+  std::uint32_t rtp_timestamp_;
+};
+
 /// View over an existing buffer representing a video frame encoded in I420
 /// format with an extra Alpha plane for opacity.
 struct I420AVideoFrame {
@@ -52,6 +98,14 @@ struct I420AVideoFrame {
   /// This is ignored if there is no A plane (|adata_| is NULL).
   /// Otherwise, this is always greater than or equal to |width_|.
   std::int32_t astride_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// the frame data, or NULL if the frame data cannot be retained. See
+  /// |Argb32VideoFrame::buffer_handle_| for details.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame. See |Argb32VideoFrame::timing_|.
+  VideoFrameTiming timing_;
 };
 
 /// View over an existing buffer representing a video frame encoded in ARGB
@@ -70,6 +124,190 @@ struct Argb32VideoFrame {
   /// Stride in bytes between two consecutive rows in the ARGB buffer.
   /// This is always greater than or equal to |width_|.
   std::int32_t stride_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// |argb32_data_|, or NULL if the frame data cannot be retained. When
+  /// delivered to a frame callback, the frame data is only valid for the
+  /// duration of the callback, unless the handle is retained with
+  /// |mrsVideoFrameBufferAddRef()|, in which case the data remains valid
+  /// until the matching |mrsVideoFrameBufferRemoveRef()|.
+  /// This is ignored for frames passed from the caller to the library.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame, when delivered to a frame callback.
+  /// This is ignored for frames passed from the caller to the library.
+  VideoFrameTiming timing_;
+};
+
+/// View over an existing buffer representing a video frame encoded in NV12
+/// format, that is a full resolution Y plane followed by a half resolution
+/// plane of interleaved U and V samples (U first).
+struct Nv12VideoFrame {
+  /// Width of the video frame, in pixels.
+  std::uint32_t width_;
+
+  /// Height of the video frame, in pixels.
+  std::uint32_t height_;
+
+  /// Pointer to the raw contiguous memory block holding the Y plane data.
+  /// The size of the buffer is at least (|ystride_| * |height_|) bytes.
+  const void* ydata_;
+
+  /// Pointer to the raw contiguous memory block holding the interleaved UV
+  /// plane data. The size of the buffer is at least
+  /// (|uvstride_| * (|height_| + 1) / 2) bytes.
+  const void* uvdata_;
+
+  /// Stride in bytes between two consecutive rows in the Y plane buffer.
+  /// This is always greater than or equal to |width_|.
+  std::int32_t ystride_;
+
+  /// Stride in bytes between two consecutive rows in the UV plane buffer.
+  /// This is always greater than or equal to (2 * ((|width_| + 1) / 2)).
+  std::int32_t uvstride_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// the frame data. See |Argb32VideoFrame::buffer_handle_| for details.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame. See |Argb32VideoFrame::timing_|.
+  VideoFrameTiming timing_;
+};
+
+/// View over an existing buffer representing a video frame encoded in RGBA
+/// 32-bit-per-pixel format, in byte order (R first, A last).
+struct Rgba32VideoFrame {
+  /// Width of the video frame, in pixels.
+  std::uint32_t width_;
+
+  /// Height of the video frame, in pixels.
+  std::uint32_t height_;
+
+  /// Pointer to the raw contiguous memory block holding the video frame data.
+  /// The size of the buffer is at least (|stride_| * |height_|) bytes.
+  const void* rgba32_data_;
+
+  /// Stride in bytes between two consecutive rows in the RGBA buffer.
+  /// This is always greater than or equal to (4 * |width_|).
+  std::int32_t stride_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// the frame data. See |Argb32VideoFrame::buffer_handle_| for details.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame. See |Argb32VideoFrame::timing_|.
+  VideoFrameTiming timing_;
+};
+
+/// View over an existing buffer representing a video frame encoded in BGR
+/// 24-bit-per-pixel format, in byte order (B first, R last).
+struct Bgr24VideoFrame {
+  /// Width of the video frame, in pixels.
+  std::uint32_t width_;
+
+  /// Height of the video frame, in pixels.
+  std::uint32_t height_;
+
+  /// Pointer to the raw contiguous memory block holding the video frame data.
+  /// The size of the buffer is at least (|stride_| * |height_|) bytes.
+  const void* bgr24_data_;
+
+  /// Stride in bytes between two consecutive rows in the BGR buffer.
+  /// This is always greater than or equal to (3 * |width_|).
+  std::int32_t stride_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// the frame data. See |Argb32VideoFrame::buffer_handle_| for details.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame. See |Argb32VideoFrame::timing_|.
+  VideoFrameTiming timing_;
+};
+
+/// View over an existing buffer representing a video frame encoded in YUY2
+/// format, that is a single plane of packed 4:2:2 samples in byte order
+/// (Y0, U, Y1, V) for each pair of pixels.
+struct Yuy2VideoFrame {
+  /// Width of the video frame, in pixels.
+  std::uint32_t width_;
+
+  /// Height of the video frame, in pixels.
+  std::uint32_t height_;
+
+  /// Pointer to the raw contiguous memory block holding the video frame data.
+  /// The size of the buffer is at least (|stride_| * |height_|) bytes.
+  const void* yuy2_data_;
+
+  /// Stride in bytes between two consecutive rows in the YUY2 buffer.
+  /// This is always greater than or equal to (4 * ((|width_| + 1) / 2)).
+  std::int32_t stride_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// the frame data. See |Argb32VideoFrame::buffer_handle_| for details.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame. See |Argb32VideoFrame::timing_|.
+  VideoFrameTiming timing_;
+};
+
+/// View over an existing buffer representing a video frame encoded in I420
+/// format, with the Y, U, and V planes stored in that order in a single
+/// contiguous memory block without any row padding. The Y plane stride is
+/// |width_|, and the U and V plane strides are ((|width_| + 1) / 2).
+struct I420PackedVideoFrame {
+  /// Width of the video frame, in pixels.
+  std::uint32_t width_;
+
+  /// Height of the video frame, in pixels.
+  std::uint32_t height_;
+
+  /// Pointer to the raw contiguous memory block holding the video frame data.
+  const void* data_;
+
+  /// Size of the memory block pointed to by |data_|, in bytes.
+  std::uint64_t size_;
+
+  /// Optional opaque handle to the reference-counted native buffer holding
+  /// the frame data. See |Argb32VideoFrame::buffer_handle_| for details.
+  void* buffer_handle_;
+
+  /// Timing metadata of the frame. See |Argb32VideoFrame::timing_|.
+  VideoFrameTiming timing_;
+};
+
+/// Number of buckets of a |VideoLatencyHistogram|.
+constexpr int kVideoLatencyBucketCount = 16;
+
+/// Histogram of latency samples. Bucket #0 counts samples below 64 us, bucket
+/// #i counts samples in [2^(i+5), 2^(i+6)) us, and the last bucket counts all
+/// samples of 2^20 us (about 1 second) and above.
+struct VideoLatencyHistogram {
+  /// Total number of samples.
+  std::uint64_t count_;
+
+  /// Sum of all samples, in microseconds.
+  std::int64_t sum_us_;
+
+  /// Smallest sample, in microseconds, or zero if there is no sample.
+  std::int64_t min_us_;
+
+  /// Largest sample, in microseconds, or zero if there is no sample.
+  std::int64_t max_us_;
+
+  /// Number of samples in each bucket.
+  std::uint64_t buckets_[kVideoLatencyBucketCount];
+};
+
+/// Latency statistics of the frames delivered by a frame observer, with one
+/// sample per frame callback invocation.
+struct VideoFrameLatencyStats {
+  /// Time from the observer receiving the decoded frame to a callback being
+  /// invoked, which includes scaling and conversion, and in polled delivery
+  /// mode the time spent waiting to be polled.
+  VideoLatencyHistogram delivery_;
+
+  /// Time spent inside the callback.
+  VideoLatencyHistogram callback_;
 };
 
 }  // namespace Microsoft::MixedReality::WebRTC
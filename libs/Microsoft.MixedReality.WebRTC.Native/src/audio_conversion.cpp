@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// This is a precompiled header, it must be on its own, followed by a blank
+// line, to prevent clang-format from reordering it with other headers.
+#include "pch.h"
+
+#include "audio_conversion.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define MRS_AUDIO_CONVERSION_SSE2 1
+#include <emmintrin.h>
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define MRS_AUDIO_CONVERSION_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// Scale of a 16-bit sample converted to float.
+constexpr float kSampleScale = 1.0f / 32768.0f;
+
+/// Scale of the sum of two 16-bit samples averaged into a single float.
+constexpr float kSampleSumScale = 1.0f / 65536.0f;
+
+// Vectorized kernels. Each kernel converts as many leading samples or frames
+// as it can in whole vectors, and returns that count; the caller converts the
+// remaining ones with scalar code.
+
+#if defined(MRS_AUDIO_CONVERSION_SSE2)
+
+/// Sign-extend and scale 4 samples held in the low 16 bits of 32-bit lanes.
+inline __m128 ScaleSamples(__m128i samples32, __m128 scale) {
+  return _mm_mul_ps(_mm_cvtepi32_ps(samples32), scale);
+}
+
+size_t CopySamplesSimd(const int16_t* src,
+                       float* dst,
+                       size_t sample_count) noexcept {
+  const __m128 scale = _mm_set1_ps(kSampleScale);
+  size_t i = 0;
+  for (; i + 8 <= sample_count; i += 8) {
+    const __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+    _mm_storeu_ps(dst + i, ScaleSamples(lo, scale));
+    _mm_storeu_ps(dst + i + 4, ScaleSamples(hi, scale));
+  }
+  return i;
+}
+
+size_t MonoToStereoSimd(const int16_t* src,
+                        float* dst,
+                        size_t frame_count) noexcept {
+  const __m128 scale = _mm_set1_ps(kSampleScale);
+  size_t i = 0;
+  for (; i + 8 <= frame_count; i += 8) {
+    const __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+    const __m128 lo =
+        ScaleSamples(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16), scale);
+    const __m128 hi =
+        ScaleSamples(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16), scale);
+    float* const out = dst + (i * 2);
+    _mm_storeu_ps(out, _mm_unpacklo_ps(lo, lo));
+    _mm_storeu_ps(out + 4, _mm_unpackhi_ps(lo, lo));
+    _mm_storeu_ps(out + 8, _mm_unpacklo_ps(hi, hi));
+    _mm_storeu_ps(out + 12, _mm_unpackhi_ps(hi, hi));
+  }
+  return i;
+}
+
+size_t StereoToMonoSimd(const int16_t* src,
+                        float* dst,
+                        size_t frame_count) noexcept {
+  const __m128 scale = _mm_set1_ps(kSampleSumScale);
+  const __m128i ones = _mm_set1_epi16(1);
+  size_t i = 0;
+  for (; i + 4 <= frame_count; i += 4) {
+    // Multiply-add by 1 sums the left and right samples of each frame into
+    // 32-bit lanes, without overflow.
+    const __m128i x = _mm_loadu_si128((const __m128i*)(src + (i * 2)));
+    _mm_storeu_ps(dst + i, ScaleSamples(_mm_madd_epi16(x, ones), scale));
+  }
+  return i;
+}
+
+#elif defined(MRS_AUDIO_CONVERSION_NEON)
+
+/// Sign-extend and scale 4 samples.
+inline float32x4_t ScaleSamples(int16x4_t samples, float scale) {
+  return vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(samples)), scale);
+}
+
+size_t CopySamplesSimd(const int16_t* src,
+                       float* dst,
+                       size_t sample_count) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= sample_count; i += 8) {
+    const int16x8_t x = vld1q_s16(src + i);
+    vst1q_f32(dst + i, ScaleSamples(vget_low_s16(x), kSampleScale));
+    vst1q_f32(dst + i + 4, ScaleSamples(vget_high_s16(x), kSampleScale));
+  }
+  return i;
+}
+
+size_t MonoToStereoSimd(const int16_t* src,
+                        float* dst,
+                        size_t frame_count) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= frame_count; i += 4) {
+    // Interleaving store of the same vector twice duplicates each sample.
+    float32x4x2_t stereo;
+    stereo.val[0] = ScaleSamples(vld1_s16(src + i), kSampleScale);
+    stereo.val[1] = stereo.val[0];
+    vst2q_f32(dst + (i * 2), stereo);
+  }
+  return i;
+}
+
+size_t StereoToMonoSimd(const int16_t* src,
+                        float* dst,
+                        size_t frame_count) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= frame_count; i += 4) {
+    // Deinterleaving load of the left and right samples, summed into 32-bit
+    // lanes without overflow.
+    const int16x4x2_t lr = vld2_s16(src + (i * 2));
+    const int32x4_t sum = vaddl_s16(lr.val[0], lr.val[1]);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(sum), kSampleSumScale));
+  }
+  return i;
+}
+
+#else
+
+size_t CopySamplesSimd(const int16_t*, float*, size_t) noexcept {
+  return 0;
+}
+
+size_t MonoToStereoSimd(const int16_t*, float*, size_t) noexcept {
+  return 0;
+}
+
+size_t StereoToMonoSimd(const int16_t*, float*, size_t) noexcept {
+  return 0;
+}
+
+#endif
+
+}  // namespace
+
+namespace Microsoft::MixedReality::WebRTC {
+
+bool ConvertS16ToFloat(const std::int16_t* src,
+                       int src_channels,
+                       float* dst,
+                       int dst_channels,
+                       size_t frame_count) noexcept {
+  if ((src_channels < 1) || (src_channels > 2) || (dst_channels < 1) ||
+      (dst_channels > 2)) {
+    return false;
+  }
+  if (src_channels == dst_channels) {
+    const size_t sample_count = frame_count * src_channels;
+    for (size_t i = CopySamplesSimd(src, dst, sample_count); i < sample_count;
+         ++i) {
+      dst[i] = src[i] * kSampleScale;
+    }
+  } else if (src_channels == 1) {
+    for (size_t i = MonoToStereoSimd(src, dst, frame_count); i < frame_count;
+         ++i) {
+      const float sample = src[i] * kSampleScale;
+      dst[2 * i + 0] = sample;
+      dst[2 * i + 1] = sample;
+    }
+  } else {
+    for (size_t i = StereoToMonoSimd(src, dst, frame_count); i < frame_count;
+         ++i) {
+      dst[i] = ((int)src[2 * i] + (int)src[2 * i + 1]) * kSampleSumScale;
+    }
+  }
+  return true;
+}
+
+}  // namespace Microsoft::MixedReality::WebRTC
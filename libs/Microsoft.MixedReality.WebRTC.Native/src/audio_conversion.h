@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Convert |frame_count| frames of interleaved 16-bit signed samples with
+/// |src_channels| channels into interleaved float samples in [-1, 1) with
+/// |dst_channels| channels, in a single vectorized pass. Mono is duplicated
+/// to stereo, and stereo is averaged to mono. Only 1 or 2 channels are
+/// supported; returns |false| without converting anything otherwise.
+bool ConvertS16ToFloat(const std::int16_t* src,
+                       int src_channels,
+                       float* dst,
+                       int dst_channels,
+                       size_t frame_count) noexcept;
+
+}  // namespace Microsoft::MixedReality::WebRTC
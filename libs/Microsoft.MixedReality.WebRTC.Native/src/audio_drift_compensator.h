@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Compensator of the clock drift between a producer and a consumer of audio,
+/// like WebRTC delivering remote audio and an audio engine reading it.
+///
+/// A controller tracks the fill level of the buffer between them, and derives
+/// the ratio of input frames to consume per output frame which brings the
+/// fill level back to a target. Audio is then resampled by that ratio with a
+/// cubic interpolator. The ratio stays within |kMaxRatioDeviation| of 1, which
+/// is enough to absorb typical clock drifts without audible pitch changes.
+/// When the ratio is exactly 1, audio passes through unmodified.
+///
+/// The compensator also holds playback until the buffer first reaches its
+/// target, and again after an underrun, so that playback restarts with enough
+/// audio buffered to absorb the jitter of the producer and the consumer.
+///
+/// This class is not thread-safe; it is used by the consumer only.
+class AudioDriftCompensator {
+ public:
+  /// Maximum deviation of the resampling ratio from 1.
+  static constexpr double kMaxRatioDeviation = 0.005;
+
+  /// Time in which the controller corrects a fill level error, in
+  /// milliseconds. Longer times make smaller ratio changes.
+  static constexpr double kCorrectionTimeMs = 2000.0;
+
+  /// Weight of each new fill level in the smoothed fill level, which averages
+  /// out the jitter of the producer and consumer.
+  static constexpr double kFillSmoothing = 0.05;
+
+  /// Whether playback is held until the buffer reaches its target.
+  bool prebuffering() const noexcept { return prebuffering_; }
+
+  /// Current ratio of input frames consumed per output frame.
+  double ratio() const noexcept { return ratio_; }
+
+  /// Number of input frames received but not consumed yet.
+  size_t pending_frame_count() const noexcept {
+    return (channel_count_ > 0) ? (input_.size() / channel_count_) - 1 : 0;
+  }
+
+  /// Reset the resampler for audio with the given number of interleaved
+  /// channels, for example after a format change. The controller keeps its
+  /// state, as the drift does not depend on the format.
+  void Reset(int channel_count) {
+    channel_count_ = channel_count;
+    // Start with a frame of silence as interpolation history.
+    input_.assign(channel_count, 0.0f);
+    position_ = 1.0;
+  }
+
+  /// While prebuffering, end prebuffering and return |true| if the fill level
+  /// reached the target. Otherwise return |false|, and the consumer should
+  /// output silence. Both levels are in milliseconds.
+  bool TryEndPrebuffering(double fill_ms, double target_ms) noexcept {
+    if (prebuffering_ && (fill_ms >= target_ms)) {
+      prebuffering_ = false;
+      smoothed_fill_ms_ = fill_ms;
+    }
+    return !prebuffering_;
+  }
+
+  /// Notify the compensator that the consumer ran out of audio, to prebuffer
+  /// again before resuming playback.
+  void OnUnderrun() noexcept { prebuffering_ = true; }
+
+  /// Update the resampling ratio from the fill level of the buffer, measured
+  /// after each read of the consumer. Both levels are in milliseconds.
+  void Update(double fill_ms, double target_ms) noexcept {
+    if (prebuffering_) {
+      return;
+    }
+    smoothed_fill_ms_ += (fill_ms - smoothed_fill_ms_) * kFillSmoothing;
+    const double deviation =
+        (smoothed_fill_ms_ - target_ms) / kCorrectionTimeMs;
+    ratio_ = 1.0 + std::clamp(deviation, -kMaxRatioDeviation,
+                              kMaxRatioDeviation);
+  }
+
+  /// Resample |frame_count| interleaved frames by the current ratio, and
+  /// append the result to |dst|. The last input frames are kept as history
+  /// for the next call, so the output is delayed by 2 frames.
+  void Process(const float* src, size_t frame_count, std::vector<float>& dst) {
+    if (channel_count_ <= 0) {
+      return;
+    }
+    const size_t channel_count = (size_t)channel_count_;
+    input_.insert(input_.end(), src, src + (frame_count * channel_count));
+    const size_t input_frame_count = input_.size() / channel_count;
+    size_t index = (size_t)position_;
+    // Cubic interpolation needs one frame before and two frames after.
+    while (index + 2 < input_frame_count) {
+      const double t = position_ - index;
+      const float* x = &input_[(index - 1) * channel_count];
+      for (size_t c = 0; c < channel_count; ++c) {
+        dst.push_back(Interpolate(x + c, channel_count, (float)t));
+      }
+      position_ += ratio_;
+      index = (size_t)position_;
+    }
+    // Discard the frames not needed anymore, keeping one frame of history.
+    const size_t discarded = std::min(index, input_frame_count) - 1;
+    input_.erase(input_.begin(), input_.begin() + (discarded * channel_count));
+    position_ -= (double)discarded;
+  }
+
+ private:
+  /// Catmull-Rom interpolation at |t| between x[1] and x[2], for samples
+  /// |stride| apart. This returns x[1] exactly for |t| = 0.
+  static float Interpolate(const float* x, size_t stride, float t) noexcept {
+    const float xm1 = x[0];
+    const float x0 = x[stride];
+    const float x1 = x[2 * stride];
+    const float x2 = x[3 * stride];
+    const float c1 = 0.5f * (x1 - xm1);
+    const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+    const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+    return ((c3 * t + c2) * t + c1) * t + x0;
+  }
+
+  bool prebuffering_ = true;
+  double smoothed_fill_ms_ = 0.0;
+  double ratio_ = 1.0;
+
+  int channel_count_ = 0;
+
+  /// Input frames not consumed yet, starting with one frame of history.
+  std::vector<float> input_;
+
+  /// Position of the next output frame in |input_|, in frames.
+  double position_ = 1.0;
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
@@ -14,6 +14,17 @@ void AudioFrameObserver::SetCallback(
   callback_ = std::move(callback);
 }
 
+bool AudioFrameObserver::ClearCallback(
+    const AudioFrameReadyCallback& callback) noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  if ((callback_.callback_ != callback.callback_) ||
+      (callback_.user_data_ != callback.user_data_)) {
+    return false;
+  }
+  callback_ = AudioFrameReadyCallback{};
+  return true;
+}
+
 void AudioFrameObserver::OnData(const void* audio_data,
                                 int bits_per_sample,
                                 int sample_rate,
@@ -20,6 +20,12 @@ class AudioFrameObserver : public webrtc::AudioTrackSinkInterface {
  public:
   void SetCallback(AudioFrameReadyCallback callback) noexcept;
 
+  /// Unregister |callback| if it is still the registered callback, leaving
+  /// any other callback registered since then in place. On return, |callback|
+  /// is guaranteed not to be invoked anymore. Return |true| if |callback| was
+  /// unregistered.
+  bool ClearCallback(const AudioFrameReadyCallback& callback) noexcept;
+
  protected:
   // AudioTrackSinkInterface interface
   void OnData(const void* audio_data,
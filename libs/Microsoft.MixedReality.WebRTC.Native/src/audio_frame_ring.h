@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Lock-free single-producer/single-consumer ring of 16-bit PCM audio frames.
+///
+/// All the memory is allocated on construction: each frame has its own slot of
+/// |max_samples_per_frame| samples, and its own format, so that the format can
+/// change between frames. Neither side takes any lock nor allocates, so the
+/// producer can run on a real-time audio thread, whatever the consumer does.
+///
+/// Only the consumer can discard frames, since the producer cannot know
+/// whether the consumer is reading a slot. So when the ring is full, the
+/// producer drops the frames it writes; the consumer is expected to discard
+/// the oldest frames itself if it falls behind, with |Discard()|.
+///
+/// |Write()| must only be called by the producer thread, and |Front()|,
+/// |Pop()|, and |Discard()| by the consumer thread.
+class AudioFrameRing {
+ public:
+  /// Format of a frame in the ring.
+  struct FrameInfo {
+    std::uint32_t sample_rate;
+    std::uint32_t channel_count;
+    /// Number of samples per channel.
+    std::uint32_t frame_count;
+  };
+
+  /// Create a ring which can hold at least |min_capacity| frames of up to
+  /// |max_samples_per_frame| samples each, across all channels.
+  AudioFrameRing(std::uint32_t min_capacity,
+                 std::uint32_t max_samples_per_frame)
+      : capacity_(RoundUpToPowerOf2(min_capacity)),
+        max_samples_per_frame_(max_samples_per_frame),
+        infos_(capacity_),
+        samples_((size_t)capacity_ * max_samples_per_frame) {}
+
+  /// Number of frames the ring can hold.
+  std::uint32_t capacity() const noexcept { return capacity_; }
+
+  /// Number of frames in the ring. This is exact on the consumer side, and
+  /// a lower bound on the producer side.
+  std::uint32_t size() const noexcept {
+    return write_index_.load(std::memory_order_acquire) -
+           read_index_.load(std::memory_order_acquire);
+  }
+
+  /// Write a frame of 8-bit unsigned or 16-bit signed samples, converting it
+  /// to 16-bit samples. Return |false| and drop the frame if the ring is full,
+  /// or if the frame is unsupported or too large.
+  bool Write(const void* data,
+             std::uint32_t bits_per_sample,
+             std::uint32_t sample_rate,
+             std::uint32_t channel_count,
+             std::uint32_t frame_count) noexcept {
+    const size_t sample_count = (size_t)channel_count * frame_count;
+    if (((bits_per_sample != 8) && (bits_per_sample != 16)) ||
+        (sample_count > max_samples_per_frame_)) {
+      return false;
+    }
+    const std::uint32_t write_index =
+        write_index_.load(std::memory_order_relaxed);
+    if (write_index - read_index_.load(std::memory_order_acquire) >=
+        capacity_) {
+      return false;
+    }
+    const std::uint32_t slot = write_index & (capacity_ - 1);
+    std::int16_t* const dst = &samples_[(size_t)slot * max_samples_per_frame_];
+    if (bits_per_sample == 16) {
+      memcpy(dst, data, sample_count * sizeof(std::int16_t));
+    } else {
+      const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+      for (size_t i = 0; i < sample_count; ++i) {
+        dst[i] = (std::int16_t)(((int)src[i] * 256) - 32768);
+      }
+    }
+    infos_[slot] = FrameInfo{sample_rate, channel_count, frame_count};
+    // Publish the frame only once written.
+    write_index_.store(write_index + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Return the samples of the oldest frame, and set |info| to its format, or
+  /// return |nullptr| if the ring is empty. The samples stay valid until the
+  /// frame is popped.
+  const std::int16_t* Front(FrameInfo& info) const noexcept {
+    const std::uint32_t read_index =
+        read_index_.load(std::memory_order_relaxed);
+    if (read_index == write_index_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    const std::uint32_t slot = read_index & (capacity_ - 1);
+    info = infos_[slot];
+    return &samples_[(size_t)slot * max_samples_per_frame_];
+  }
+
+  /// Remove the oldest frame, which must exist.
+  void Pop() noexcept { Discard(1); }
+
+  /// Remove the |count| oldest frames, which must exist.
+  void Discard(std::uint32_t count) noexcept {
+    // Release the slots to the producer only once read.
+    read_index_.store(read_index_.load(std::memory_order_relaxed) + count,
+                      std::memory_order_release);
+  }
+
+ private:
+  static std::uint32_t RoundUpToPowerOf2(std::uint32_t value) noexcept {
+    std::uint32_t power = 1;
+    while (power < value) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+  /// Number of slots, a power of 2 so that indices wrap around correctly.
+  const std::uint32_t capacity_;
+  const std::uint32_t max_samples_per_frame_;
+  std::vector<FrameInfo> infos_;
+  std::vector<std::int16_t> samples_;
+
+  /// Indices of the next frame to write and to read, which only increase. The
+  /// slot of a frame is its index modulo the capacity. Each index is written
+  /// by one side only, and is on its own cache line to avoid false sharing.
+  alignas(64) std::atomic<std::uint32_t> write_index_{0};
+  alignas(64) std::atomic<std::uint32_t> read_index_{0};
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
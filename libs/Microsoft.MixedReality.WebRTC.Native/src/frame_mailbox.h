@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "absl/types/optional.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Single-slot mailbox holding only the latest value posted by a producer
+/// thread until a consumer thread takes it, like a video frame waiting to be
+/// rendered. Posting a new value while the previous one was not taken yet
+/// replaces it.
+///
+/// This is a lock-free triple buffer: the producer and the consumer each own
+/// one slot, and exchange it atomically with the third shared slot, so neither
+/// side ever blocks or allocates. There must be at most one producer and one
+/// consumer at a time; callers with multiple threads on one side must
+/// serialize them.
+template <typename T>
+class FrameMailbox {
+ public:
+  /// Publish |value| as the latest value, replacing any value not taken yet.
+  /// Return |true| if such a value was replaced, i.e. dropped.
+  bool Post(T value) noexcept {
+    slots_[back_].emplace(std::move(value));
+    const uint8_t previous =
+        shared_.exchange(back_ | kFreshBit, std::memory_order_acq_rel);
+    back_ = (previous & kIndexMask);
+    // Release the dropped value, if any, now rather than on the next post.
+    // If not fresh, the slot was already cleared by the consumer.
+    const bool dropped = ((previous & kFreshBit) != 0);
+    slots_[back_].reset();
+    return dropped;
+  }
+
+  /// Take the latest value posted, if any value was posted since the last
+  /// call.
+  absl::optional<T> Take() noexcept {
+    if ((shared_.load(std::memory_order_relaxed) & kFreshBit) == 0) {
+      return absl::nullopt;
+    }
+    front_ = (shared_.exchange(front_, std::memory_order_acq_rel) & kIndexMask);
+    absl::optional<T> value = std::move(slots_[front_]);
+    slots_[front_].reset();
+    return value;
+  }
+
+  /// Check if a value was posted and not taken yet.
+  bool HasValue() const noexcept {
+    return ((shared_.load(std::memory_order_relaxed) & kFreshBit) != 0);
+  }
+
+ private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  static constexpr uint8_t kFreshBit = 0x4;
+
+  absl::optional<T> slots_[3];
+
+  /// Index of the shared slot, with |kFreshBit| set if it holds a value not
+  /// taken yet.
+  std::atomic<uint8_t> shared_{0};
+
+  /// Index of the slot owned by the producer.
+  uint8_t back_{1};
+
+  /// Index of the slot owned by the consumer.
+  uint8_t front_{2};
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Fixed-capacity ring of the pending frame requests of a video source.
+///
+/// Requests are issued with consecutive IDs, and completing a request also
+/// discards all older requests, which are outdated. So the pending requests
+/// always have a contiguous range of IDs, and each one has its own slot at
+/// index |request_id % kCapacity|. This validates a request in constant time,
+/// without allocating, whatever the number of pending requests. IDs wrap
+/// around after 2^32 requests, which is a multiple of the capacity.
+///
+/// This class is not thread-safe.
+class FrameRequestRing {
+ public:
+  /// Maximum number of pending requests. Once full, issuing a new request
+  /// discards the oldest one.
+  static constexpr std::uint32_t kCapacity = 64;
+  static_assert((kCapacity & (kCapacity - 1)) == 0,
+                "Capacity must be a power of 2 to support ID wrap-around.");
+
+  /// Create an empty ring, whose first request has ID |first_id|.
+  explicit FrameRequestRing(std::uint32_t first_id = 0) noexcept
+      : oldest_id_(first_id), next_id_(first_id) {}
+
+  /// Number of pending requests.
+  std::uint32_t size() const noexcept { return next_id_ - oldest_id_; }
+
+  /// Issue a new request for a frame with the given timestamp, and return its
+  /// ID. If the ring is full, the oldest pending request is discarded.
+  std::uint32_t Push(std::int64_t timestamp_ms) noexcept {
+    if (size() >= kCapacity) {
+      ++oldest_id_;
+    }
+    const std::uint32_t request_id = next_id_++;
+    timestamps_ms_[request_id % kCapacity] = timestamp_ms;
+    return request_id;
+  }
+
+  /// If |request_id| is pending, remove it along with all older requests, set
+  /// |timestamp_ms| to its timestamp, and return |true|. Otherwise, return
+  /// |false|.
+  bool Take(std::uint32_t request_id, std::int64_t& timestamp_ms) noexcept {
+    // Unsigned differences order IDs correctly across wrap-around.
+    if (request_id - oldest_id_ >= size()) {
+      return false;
+    }
+    timestamp_ms = timestamps_ms_[request_id % kCapacity];
+    oldest_id_ = request_id + 1;
+    return true;
+  }
+
+  /// Discard all pending requests. IDs are not reused, so that the requests
+  /// discarded cannot be completed anymore.
+  void Clear() noexcept { oldest_id_ = next_id_; }
+
+ private:
+  std::array<std::int64_t, kCapacity> timestamps_ms_{};
+
+  /// ID of the oldest pending request, if any.
+  std::uint32_t oldest_id_;
+
+  /// ID of the next request to issue.
+  std::uint32_t next_id_;
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
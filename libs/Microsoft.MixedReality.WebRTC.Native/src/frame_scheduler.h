@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "external_video_track_source_interop.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Schedule of the frames of a video source producing frames at a fixed rate.
+///
+/// Each frame deadline is computed from its index relative to a fixed origin,
+/// instead of from the time the previous frame was produced, so that timer
+/// inaccuracies and scheduling delays do not accumulate into a drift of the
+/// frame rate. All times are in microseconds, in the caller's clock.
+///
+/// This class is not thread-safe.
+class FrameScheduler {
+ public:
+  /// Default frame rate, in frames per second.
+  static constexpr double kDefaultFrameRate = 30.0;
+
+  /// Maximum number of late frames produced back-to-back with
+  /// |mrsFrameSchedulePolicy::kCatchUp|; older late frames are skipped.
+  static constexpr int kMaxCatchUpFrameCount = 4;
+
+  /// Restart the schedule with a first frame deadline at |first_deadline_us|.
+  void Start(std::int64_t first_deadline_us) noexcept {
+    origin_us_ = first_deadline_us;
+    index_ = 0;
+  }
+
+  /// Change the frame rate. The next deadline is unchanged, and the following
+  /// ones are spaced according to the new |frame_rate|, which must be
+  /// positive.
+  void SetFrameRate(double frame_rate) noexcept {
+    origin_us_ = DeadlineOf(index_);
+    index_ = 0;
+    frame_rate_ = frame_rate;
+  }
+
+  double frame_rate() const noexcept { return frame_rate_; }
+
+  void SetPolicy(mrsFrameSchedulePolicy policy) noexcept { policy_ = policy; }
+
+  mrsFrameSchedulePolicy policy() const noexcept { return policy_; }
+
+  /// Deadline of the next frame to produce.
+  std::int64_t next_deadline_us() const noexcept { return DeadlineOf(index_); }
+
+  /// Number of frames skipped because the caller was late.
+  std::uint64_t skipped_frame_count() const noexcept { return skipped_count_; }
+
+  /// Consume the next frame deadline, which the caller reached at |now_us|,
+  /// and return it as the timestamp of the frame to produce. If the caller is
+  /// late past some of the following deadlines, those are skipped or kept to
+  /// be produced immediately, depending on the policy.
+  std::int64_t Advance(std::int64_t now_us) noexcept {
+    const std::int64_t frame_time_us = DeadlineOf(index_);
+    ++index_;
+    if (DeadlineOf(index_) <= now_us) {
+      const std::int64_t first_future = FirstIndexAfter(now_us);
+      std::int64_t late_count = first_future - index_;
+      if (policy_ == mrsFrameSchedulePolicy::kCatchUp) {
+        late_count -= kMaxCatchUpFrameCount;
+      }
+      if (late_count > 0) {
+        index_ += late_count;
+        skipped_count_ += static_cast<std::uint64_t>(late_count);
+      }
+    }
+    return frame_time_us;
+  }
+
+ private:
+  std::int64_t DeadlineOf(std::int64_t index) const noexcept {
+    return origin_us_ + std::llround(index * 1e6 / frame_rate_);
+  }
+
+  /// Index of the first deadline strictly after |time_us|.
+  std::int64_t FirstIndexAfter(std::int64_t time_us) const noexcept {
+    std::int64_t index =
+        static_cast<std::int64_t>((time_us - origin_us_) * frame_rate_ / 1e6) +
+        1;
+    // Fix up rounding errors of the estimate above.
+    while ((index > 0) && (DeadlineOf(index - 1) > time_us)) {
+      --index;
+    }
+    while (DeadlineOf(index) <= time_us) {
+      ++index;
+    }
+    return index;
+  }
+
+  double frame_rate_{kDefaultFrameRate};
+  mrsFrameSchedulePolicy policy_{mrsFrameSchedulePolicy::kSkip};
+
+  /// Deadline of the frame of index 0.
+  std::int64_t origin_us_{0};
+
+  /// Index of the next frame to produce.
+  std::int64_t index_{0};
+
+  std::uint64_t skipped_count_{0};
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
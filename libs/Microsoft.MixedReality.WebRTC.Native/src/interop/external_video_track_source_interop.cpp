@@ -11,6 +11,66 @@
 
 using namespace Microsoft::MixedReality::WebRTC;
 
+namespace {
+
+/// Create an external video track source from an interop callback requesting
+/// frames of type |FrameT|.
+template <typename FrameT>
+mrsResult CreateFromCallback(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
+  if (!source_handle_out) {
+    return Result::kInvalidParameter;
+  }
+  *source_handle_out = nullptr;
+  RefPtr<ExternalVideoTrackSource> track_source =
+      detail::ExternalVideoTrackSourceCreateFromCallback<FrameT>(callback,
+                                                                 user_data);
+  if (!track_source) {
+    return Result::kUnknownError;
+  }
+  *source_handle_out = track_source.release();
+  return Result::kSuccess;
+}
+
+/// Complete a video frame request with a frame of type |FrameT|.
+template <typename FrameT>
+mrsResult CompleteFrameRequest(ExternalVideoTrackSourceHandle handle,
+                               uint32_t request_id,
+                               int64_t timestamp_ms,
+                               const FrameT* frame_view) noexcept {
+  if (!frame_view) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    return track->CompleteRequest(request_id, timestamp_ms, *frame_view);
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+/// Push a frame of type |FrameT| to a push-mode source.
+template <typename FrameT>
+mrsResult PushFrame(ExternalVideoTrackSourceHandle handle,
+                    int64_t timestamp_ms,
+                    const FrameT* frame_view,
+                    mrsBool* dropped_out) noexcept {
+  if (!frame_view) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    bool dropped = false;
+    const Result result = track->PushFrame(timestamp_ms, *frame_view, dropped);
+    if (dropped_out) {
+      *dropped_out = (dropped ? mrsBool::kTrue : mrsBool::kFalse);
+    }
+    return result;
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+}  // namespace
+
 void MRS_CALL mrsExternalVideoTrackSourceAddRef(
     ExternalVideoTrackSourceHandle handle) noexcept {
   if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
@@ -35,29 +95,58 @@ mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromI420ACallback(
     mrsRequestExternalI420AVideoFrameCallback callback,
     void* user_data,
     ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
-  if (!source_handle_out) {
-    return Result::kInvalidParameter;
-  }
-  *source_handle_out = nullptr;
-  RefPtr<ExternalVideoTrackSource> track_source =
-      detail::ExternalVideoTrackSourceCreateFromI420A(callback, user_data);
-  if (!track_source) {
-    return Result::kUnknownError;
-  }
-  *source_handle_out = track_source.release();
-  return Result::kSuccess;
+  return CreateFromCallback<I420AVideoFrame>(callback, user_data,
+                                             source_handle_out);
 }
 
 mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromArgb32Callback(
     mrsRequestExternalArgb32VideoFrameCallback callback,
     void* user_data,
     ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
+  return CreateFromCallback<Argb32VideoFrame>(callback, user_data,
+                                              source_handle_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromNv12Callback(
+    mrsRequestExternalNv12VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
+  return CreateFromCallback<Nv12VideoFrame>(callback, user_data,
+                                            source_handle_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromYuy2Callback(
+    mrsRequestExternalYuy2VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
+  return CreateFromCallback<Yuy2VideoFrame>(callback, user_data,
+                                            source_handle_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromBgr24Callback(
+    mrsRequestExternalBgr24VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
+  return CreateFromCallback<Bgr24VideoFrame>(callback, user_data,
+                                             source_handle_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateFromRgba32Callback(
+    mrsRequestExternalRgba32VideoFrameCallback callback,
+    void* user_data,
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
+  return CreateFromCallback<Rgba32VideoFrame>(callback, user_data,
+                                              source_handle_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCreateForPush(
+    ExternalVideoTrackSourceHandle* source_handle_out) noexcept {
   if (!source_handle_out) {
     return Result::kInvalidParameter;
   }
   *source_handle_out = nullptr;
   RefPtr<ExternalVideoTrackSource> track_source =
-      detail::ExternalVideoTrackSourceCreateFromArgb32(callback, user_data);
+      ExternalVideoTrackSource::createForPush();
   if (!track_source) {
     return Result::kUnknownError;
   }
@@ -77,25 +166,246 @@ mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteI420AFrameRequest(
     uint32_t request_id,
     int64_t timestamp_ms,
     const mrsI420AVideoFrame* frame_view) noexcept {
+  return CompleteFrameRequest(handle, request_id, timestamp_ms, frame_view);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteArgb32FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view) noexcept {
+  return CompleteFrameRequest(handle, request_id, timestamp_ms, frame_view);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteNv12FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsNv12VideoFrame* frame_view) noexcept {
+  return CompleteFrameRequest(handle, request_id, timestamp_ms, frame_view);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteYuy2FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsYuy2VideoFrame* frame_view) noexcept {
+  return CompleteFrameRequest(handle, request_id, timestamp_ms, frame_view);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteBgr24FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsBgr24VideoFrame* frame_view) noexcept {
+  return CompleteFrameRequest(handle, request_id, timestamp_ms, frame_view);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteRgba32FrameRequest(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsRgba32VideoFrame* frame_view) noexcept {
+  return CompleteFrameRequest(handle, request_id, timestamp_ms, frame_view);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushI420AFrame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsI420AVideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept {
+  return PushFrame(handle, timestamp_ms, frame_view, dropped_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushArgb32Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept {
+  return PushFrame(handle, timestamp_ms, frame_view, dropped_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushNv12Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsNv12VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept {
+  return PushFrame(handle, timestamp_ms, frame_view, dropped_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushYuy2Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsYuy2VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept {
+  return PushFrame(handle, timestamp_ms, frame_view, dropped_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushBgr24Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsBgr24VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept {
+  return PushFrame(handle, timestamp_ms, frame_view, dropped_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushRgba32Frame(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsRgba32VideoFrame* frame_view,
+    mrsBool* dropped_out) noexcept {
+  return PushFrame(handle, timestamp_ms, frame_view, dropped_out);
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteI420AFrameRequestNoCopy(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsI420AVideoFrame* frame_view,
+    mrsVideoFrameReleaseCallback release_callback,
+    void* release_user_data) noexcept {
+  const FrameReleaseCallback release{release_callback, release_user_data};
   if (!frame_view) {
+    release();
     return Result::kInvalidParameter;
   }
   if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
-    return track->CompleteRequest(request_id, timestamp_ms, *frame_view);
+    return track->CompleteRequestNoCopy(request_id, timestamp_ms, *frame_view,
+                                        release);
   }
+  release();
   return mrsResult::kInvalidNativeHandle;
 }
 
-mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteArgb32FrameRequest(
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushI420AFrameNoCopy(
     ExternalVideoTrackSourceHandle handle,
-    uint32_t request_id,
     int64_t timestamp_ms,
-    const mrsArgb32VideoFrame* frame_view) noexcept {
+    const mrsI420AVideoFrame* frame_view,
+    mrsVideoFrameReleaseCallback release_callback,
+    void* release_user_data,
+    mrsBool* dropped_out) noexcept {
+  const FrameReleaseCallback release{release_callback, release_user_data};
   if (!frame_view) {
+    release();
     return Result::kInvalidParameter;
   }
   if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
-    return track->CompleteRequest(request_id, timestamp_ms, *frame_view);
+    bool dropped = false;
+    const Result result =
+        track->PushFrameNoCopy(timestamp_ms, *frame_view, release, dropped);
+    if (dropped_out) {
+      *dropped_out = (dropped ? mrsBool::kTrue : mrsBool::kFalse);
+    }
+    return result;
+  }
+  release();
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceSetPushDropPolicy(
+    ExternalVideoTrackSourceHandle handle,
+    mrsPushFrameDropPolicy policy) noexcept {
+  if ((policy != mrsPushFrameDropPolicy::kDrop) &&
+      (policy != mrsPushFrameDropPolicy::kWait)) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    track->SetPushDropPolicy(policy);
+    return Result::kSuccess;
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceCompleteArgb32FrameRequestDirty(
+    ExternalVideoTrackSourceHandle handle,
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view,
+    const mrsVideoRect* dirty_rects,
+    int32_t dirty_rect_count) noexcept {
+  if (!frame_view || (dirty_rect_count < 0) ||
+      (!dirty_rects && (dirty_rect_count > 0))) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    return track->CompleteRequestDirty(request_id, timestamp_ms, *frame_view,
+                                       dirty_rects, dirty_rect_count);
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourcePushArgb32FrameDirty(
+    ExternalVideoTrackSourceHandle handle,
+    int64_t timestamp_ms,
+    const mrsArgb32VideoFrame* frame_view,
+    const mrsVideoRect* dirty_rects,
+    int32_t dirty_rect_count,
+    mrsBool* dropped_out) noexcept {
+  if (!frame_view || (dirty_rect_count < 0) ||
+      (!dirty_rects && (dirty_rect_count > 0))) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    bool dropped = false;
+    const Result result = track->PushFrameDirty(
+        timestamp_ms, *frame_view, dirty_rects, dirty_rect_count, dropped);
+    if (dropped_out) {
+      *dropped_out = (dropped ? mrsBool::kTrue : mrsBool::kFalse);
+    }
+    return result;
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceSetFrameRate(
+    ExternalVideoTrackSourceHandle handle,
+    double frame_rate) noexcept {
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    return track->SetFrameRate(frame_rate);
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceSetSchedulePolicy(
+    ExternalVideoTrackSourceHandle handle,
+    mrsFrameSchedulePolicy policy) noexcept {
+  if ((policy != mrsFrameSchedulePolicy::kSkip) &&
+      (policy != mrsFrameSchedulePolicy::kCatchUp)) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    track->SetSchedulePolicy(policy);
+    return Result::kSuccess;
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceGetWantedFormat(
+    ExternalVideoTrackSourceHandle handle,
+    int32_t native_width,
+    int32_t native_height,
+    mrsWantedVideoFormat* format_out) noexcept {
+  if (!format_out || (native_width <= 0) || (native_height <= 0)) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    *format_out = track->GetWantedFormat(native_width, native_height);
+    return Result::kSuccess;
+  }
+  return mrsResult::kInvalidNativeHandle;
+}
+
+mrsResult MRS_CALL mrsExternalVideoTrackSourceSetStaticFramePolicy(
+    ExternalVideoTrackSourceHandle handle,
+    mrsStaticFramePolicy policy) noexcept {
+  if ((policy != mrsStaticFramePolicy::kNone) &&
+      (policy != mrsStaticFramePolicy::kRepeat) &&
+      (policy != mrsStaticFramePolicy::kDrop)) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<ExternalVideoTrackSource*>(handle)) {
+    track->SetStaticFramePolicy(policy);
+    return Result::kSuccess;
   }
   return mrsResult::kInvalidNativeHandle;
 }
@@ -109,8 +419,10 @@ void MRS_CALL mrsExternalVideoTrackSourceShutdown(
 
 namespace {
 
-/// Adapter for a an interop-based I420A custom video source.
-struct I420AInteropVideoSource : I420AExternalVideoSource {
+/// Adapter for an interop-based custom video source producing frames of type
+/// |FrameT|.
+template <typename FrameT>
+struct InteropVideoSource : ExternalVideoSource<FrameT> {
   using callback_type =
       RetCallback<mrsResult, ExternalVideoTrackSourceHandle, uint32_t, int64_t>;
 
@@ -120,53 +432,64 @@ struct I420AInteropVideoSource : I420AExternalVideoSource {
   /// External video track source to deliver the frames to.
   RefPtr<ExternalVideoTrackSource> track_source_;
 
-  I420AInteropVideoSource(mrsRequestExternalI420AVideoFrameCallback callback,
-                          void* user_data)
+  InteropVideoSource(mrsRequestExternalVideoFrameCallback callback,
+                     void* user_data)
       : callback_({callback, user_data}) {}
 
-  Result FrameRequested(I420AVideoFrameRequest& frame_request) override {
+  Result FrameRequested(VideoFrameRequest<FrameT>& frame_request) override {
     assert(track_source_);
     return callback_(track_source_.get(), frame_request.request_id_,
                      frame_request.timestamp_ms_);
   }
 };
 
-/// Adapter for a an interop-based ARGB32 custom video source.
-struct Argb32InteropVideoSource : Argb32ExternalVideoSource {
-  using callback_type =
-      RetCallback<mrsResult, ExternalVideoTrackSourceHandle, uint32_t, int64_t>;
+/// Create an external video track source from a custom video source, using
+/// the factory matching its frame encoding.
+RefPtr<ExternalVideoTrackSource> CreateTrackSource(
+    RefPtr<I420AExternalVideoSource> video_source) {
+  return ExternalVideoTrackSource::createFromI420A(std::move(video_source));
+}
 
-  /// Interop callback to generate frames.
-  callback_type callback_;
+RefPtr<ExternalVideoTrackSource> CreateTrackSource(
+    RefPtr<Argb32ExternalVideoSource> video_source) {
+  return ExternalVideoTrackSource::createFromArgb32(std::move(video_source));
+}
 
-  /// External video track source to deliver the frames to.
-  RefPtr<ExternalVideoTrackSource> track_source_;
+RefPtr<ExternalVideoTrackSource> CreateTrackSource(
+    RefPtr<Nv12ExternalVideoSource> video_source) {
+  return ExternalVideoTrackSource::createFromNv12(std::move(video_source));
+}
 
-  Argb32InteropVideoSource(mrsRequestExternalArgb32VideoFrameCallback callback,
-                           void* user_data)
-      : callback_({callback, user_data}) {}
+RefPtr<ExternalVideoTrackSource> CreateTrackSource(
+    RefPtr<Yuy2ExternalVideoSource> video_source) {
+  return ExternalVideoTrackSource::createFromYuy2(std::move(video_source));
+}
 
-  Result FrameRequested(Argb32VideoFrameRequest& frame_request) override {
-    assert(track_source_);
-    return callback_(track_source_.get(), frame_request.request_id_,
-                     frame_request.timestamp_ms_);
-  }
-};
+RefPtr<ExternalVideoTrackSource> CreateTrackSource(
+    RefPtr<Bgr24ExternalVideoSource> video_source) {
+  return ExternalVideoTrackSource::createFromBgr24(std::move(video_source));
+}
+
+RefPtr<ExternalVideoTrackSource> CreateTrackSource(
+    RefPtr<Rgba32ExternalVideoSource> video_source) {
+  return ExternalVideoTrackSource::createFromRgba32(std::move(video_source));
+}
 
 }  // namespace
 
 namespace Microsoft::MixedReality::WebRTC::detail {
 
-RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromI420A(
-    mrsRequestExternalI420AVideoFrameCallback callback,
+template <typename FrameT>
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromCallback(
+    mrsRequestExternalVideoFrameCallback callback,
     void* user_data) {
-  RefPtr<I420AInteropVideoSource> custom_source =
-      new I420AInteropVideoSource(callback, user_data);
+  RefPtr<InteropVideoSource<FrameT>> custom_source =
+      new InteropVideoSource<FrameT>(callback, user_data);
   if (!custom_source) {
     return {};
   }
   RefPtr<ExternalVideoTrackSource> track_source =
-      ExternalVideoTrackSource::createFromI420A(custom_source);
+      CreateTrackSource(RefPtr<ExternalVideoSource<FrameT>>(custom_source));
   if (!track_source) {
     return {};
   }
@@ -174,21 +497,29 @@ RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromI420A(
   return track_source;
 }
 
-RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromArgb32(
-    mrsRequestExternalArgb32VideoFrameCallback callback,
-    void* user_data) {
-  RefPtr<Argb32InteropVideoSource> custom_source =
-      new Argb32InteropVideoSource(callback, user_data);
-  if (!custom_source) {
-    return {};
-  }
-  RefPtr<ExternalVideoTrackSource> track_source =
-      ExternalVideoTrackSource::createFromArgb32(custom_source);
-  if (!track_source) {
-    return {};
-  }
-  custom_source->track_source_ = track_source;
-  return track_source;
-}
+template RefPtr<ExternalVideoTrackSource>
+ExternalVideoTrackSourceCreateFromCallback<I420AVideoFrame>(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data);
+template RefPtr<ExternalVideoTrackSource>
+ExternalVideoTrackSourceCreateFromCallback<Argb32VideoFrame>(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data);
+template RefPtr<ExternalVideoTrackSource>
+ExternalVideoTrackSourceCreateFromCallback<Nv12VideoFrame>(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data);
+template RefPtr<ExternalVideoTrackSource>
+ExternalVideoTrackSourceCreateFromCallback<Yuy2VideoFrame>(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data);
+template RefPtr<ExternalVideoTrackSource>
+ExternalVideoTrackSourceCreateFromCallback<Bgr24VideoFrame>(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data);
+template RefPtr<ExternalVideoTrackSource>
+ExternalVideoTrackSourceCreateFromCallback<Rgba32VideoFrame>(
+    mrsRequestExternalVideoFrameCallback callback,
+    void* user_data);
 
 }  // namespace Microsoft::MixedReality::WebRTC::detail
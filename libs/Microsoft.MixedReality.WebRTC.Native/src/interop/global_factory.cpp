@@ -129,6 +129,22 @@ rtc::Thread* GlobalFactory::GetWorkerThread() noexcept {
 #endif  // defined(WINUWP)
 }
 
+WorkerPool* GlobalFactory::GetOrCreateWorkerPool() noexcept {
+  std::scoped_lock lock(mutex_);
+  if (!worker_pool_) {
+    worker_pool_ = std::make_unique<WorkerPool>();
+  }
+  return worker_pool_.get();
+}
+
+CaptureThreadPool* GlobalFactory::GetOrCreateCaptureThreadPool() noexcept {
+  std::scoped_lock lock(mutex_);
+  if (!capture_thread_pool_) {
+    capture_thread_pool_ = std::make_unique<CaptureThreadPool>();
+  }
+  return capture_thread_pool_.get();
+}
+
 void GlobalFactory::AddObject(ObjectType type, TrackedObject* obj) noexcept {
   try {
     std::scoped_lock lock(mutex_);
@@ -649,6 +665,8 @@ mrsResult GlobalFactory::Initialize() {
 
 void GlobalFactory::ShutdownNoLock() {
   factory_ = nullptr;
+  worker_pool_.reset();
+  capture_thread_pool_.reset();
 #if defined(WINUWP)
   impl_ = nullptr;
 #else   // defined(WINUWP)
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "export.h"
+#include "media/capture_thread_pool.h"
 #include "peer_connection.h"
+#include "worker_pool.h"
 
 namespace Microsoft::MixedReality::WebRTC {
 
@@ -38,6 +40,16 @@ class GlobalFactory {
   /// Get the worker thread. This is only valid if initialized.
   rtc::Thread* GetWorkerThread() noexcept;
 
+  /// Get or create the pool of worker threads shared by all objects to
+  /// parallelize CPU-heavy work. The pool is destroyed with the WebRTC threads
+  /// once all tracked objects are destroyed.
+  WorkerPool* GetOrCreateWorkerPool() noexcept;
+
+  /// Get or create the pool of capture threads shared by all external video
+  /// track sources to schedule their frame requests. The pool is destroyed
+  /// with the WebRTC threads once all tracked objects are destroyed.
+  CaptureThreadPool* GetOrCreateCaptureThreadPool() noexcept;
+
   /// Add to the global factory collection an object whose lifetime must be
   /// tracked to know when it is safe to terminate the WebRTC threads. This is
   /// generally called form the object's constructor for safety.
@@ -68,6 +80,9 @@ class GlobalFactory {
   std::unique_ptr<rtc::Thread> worker_thread_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<rtc::Thread> signaling_thread_ RTC_GUARDED_BY(mutex_);
 #endif  // defined(WINUWP)
+  std::unique_ptr<WorkerPool> worker_pool_ RTC_GUARDED_BY(mutex_);
+  std::unique_ptr<CaptureThreadPool> capture_thread_pool_
+      RTC_GUARDED_BY(mutex_);
   std::recursive_mutex mutex_;
 
   /// Collection of all objects alive.
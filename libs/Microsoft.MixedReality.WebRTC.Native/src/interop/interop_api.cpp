@@ -658,6 +658,46 @@ void MRS_CALL mrsPeerConnectionRegisterTrackRemovedCallback(
   }
 }
 
+void MRS_CALL mrsPeerConnectionRegisterRemoteVideoTrackAddedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteVideoTrackAddedCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteVideoTrackAddedCallback(
+        PeerConnection::RemoteVideoTrackAddedCallback{callback, user_data});
+  }
+}
+
+void MRS_CALL mrsPeerConnectionRegisterRemoteVideoTrackRemovedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteVideoTrackRemovedCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteVideoTrackRemovedCallback(
+        PeerConnection::RemoteVideoTrackRemovedCallback{callback, user_data});
+  }
+}
+
+void MRS_CALL mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteAudioTrackAddedCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteAudioTrackAddedCallback(
+        PeerConnection::RemoteAudioTrackAddedCallback{callback, user_data});
+  }
+}
+
+void MRS_CALL mrsPeerConnectionRegisterRemoteAudioTrackRemovedCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRemoteAudioTrackRemovedCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteAudioTrackRemovedCallback(
+        PeerConnection::RemoteAudioTrackRemovedCallback{callback, user_data});
+  }
+}
+
 void MRS_CALL mrsPeerConnectionRegisterDataChannelAddedCallback(
     PeerConnectionHandle peerHandle,
     PeerConnectionDataChannelAddedCallback callback,
@@ -700,6 +740,138 @@ void MRS_CALL mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(
   }
 }
 
+void MRS_CALL mrsPeerConnectionRegisterNv12RemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionNv12VideoFrameCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteVideoFrameCallback(
+        Nv12FrameReadyCallback{callback, user_data});
+  }
+}
+
+void MRS_CALL mrsPeerConnectionRegisterRgba32RemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionRgba32VideoFrameCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteVideoFrameCallback(
+        Rgba32FrameReadyCallback{callback, user_data});
+  }
+}
+
+void MRS_CALL mrsPeerConnectionRegisterBgr24RemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionBgr24VideoFrameCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteVideoFrameCallback(
+        Bgr24FrameReadyCallback{callback, user_data});
+  }
+}
+
+void MRS_CALL mrsPeerConnectionRegisterI420PackedRemoteVideoFrameCallback(
+    PeerConnectionHandle peerHandle,
+    PeerConnectionI420PackedVideoFrameCallback callback,
+    void* user_data) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    peer->RegisterRemoteVideoFrameCallback(
+        I420PackedFrameReadyCallback{callback, user_data});
+  }
+}
+
+mrsResult MRS_CALL mrsPeerConnectionSetRemoteVideoConversionParallelism(
+    PeerConnectionHandle peerHandle,
+    int32_t max_parallelism) noexcept {
+  auto peer = static_cast<PeerConnection*>(peerHandle);
+  if (!peer) {
+    return Result::kInvalidNativeHandle;
+  }
+  if (max_parallelism < 1) {
+    return Result::kInvalidParameter;
+  }
+  peer->SetRemoteVideoConversionParallelism(max_parallelism);
+  return Result::kSuccess;
+}
+
+mrsResult MRS_CALL mrsPeerConnectionSetRemoteVideoFrameTargetSize(
+    PeerConnectionHandle peerHandle,
+    mrsVideoFrameFormat format,
+    int32_t width,
+    int32_t height) noexcept {
+  auto peer = static_cast<PeerConnection*>(peerHandle);
+  if (!peer) {
+    return Result::kInvalidNativeHandle;
+  }
+  return peer->SetRemoteVideoFrameTargetSize(format, width, height);
+}
+
+mrsResult MRS_CALL mrsPeerConnectionSetRemoteVideoDeliveryMode(
+    PeerConnectionHandle peerHandle,
+    mrsVideoFrameDeliveryMode mode) noexcept {
+  auto peer = static_cast<PeerConnection*>(peerHandle);
+  if (!peer) {
+    return Result::kInvalidNativeHandle;
+  }
+  if ((mode != mrsVideoFrameDeliveryMode::kInline) &&
+      (mode != mrsVideoFrameDeliveryMode::kPolled)) {
+    return Result::kInvalidParameter;
+  }
+  peer->SetRemoteVideoDeliveryMode(mode);
+  return Result::kSuccess;
+}
+
+mrsBool MRS_CALL mrsPeerConnectionPollRemoteVideoFrame(
+    PeerConnectionHandle peerHandle) noexcept {
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    return (peer->PollRemoteVideoFrame() ? mrsBool::kTrue : mrsBool::kFalse);
+  }
+  return mrsBool::kFalse;
+}
+
+mrsResult MRS_CALL mrsPeerConnectionSetArgb32RemoteVideoFrameDestinations(
+    PeerConnectionHandle peerHandle,
+    void* const* buffers,
+    int32_t count,
+    uint64_t size,
+    int32_t stride) noexcept {
+  auto peer = static_cast<PeerConnection*>(peerHandle);
+  if (!peer) {
+    return Result::kInvalidNativeHandle;
+  }
+  return peer->SetRemoteVideoArgb32Destinations(buffers, count, size, stride);
+}
+
+mrsResult MRS_CALL mrsPeerConnectionReleaseArgb32RemoteVideoFrameDestination(
+    PeerConnectionHandle peerHandle,
+    const void* buffer) noexcept {
+  auto peer = static_cast<PeerConnection*>(peerHandle);
+  if (!peer) {
+    return Result::kInvalidNativeHandle;
+  }
+  return peer->ReleaseRemoteVideoArgb32Destination(buffer);
+}
+
+void MRS_CALL
+mrsVideoFrameBufferAddRef(VideoFrameBufferHandle handle) noexcept {
+  if (auto buffer = static_cast<webrtc::VideoFrameBuffer*>(handle)) {
+    buffer->AddRef();
+  } else {
+    RTC_LOG(LS_WARNING)
+        << "Trying to add reference to NULL VideoFrameBuffer object.";
+  }
+}
+
+void MRS_CALL
+mrsVideoFrameBufferRemoveRef(VideoFrameBufferHandle handle) noexcept {
+  if (auto buffer = static_cast<webrtc::VideoFrameBuffer*>(handle)) {
+    buffer->Release();
+  } else {
+    RTC_LOG(LS_WARNING)
+        << "Trying to remove reference from NULL VideoFrameBuffer object.";
+  }
+}
+
 void MRS_CALL mrsPeerConnectionRegisterLocalAudioFrameCallback(
     PeerConnectionHandle peerHandle,
     PeerConnectionAudioFrameCallback callback,
@@ -958,6 +1130,23 @@ mrsAudioReadStreamCreate(PeerConnectionHandle peerHandle,
   return Result::kInvalidNativeHandle;
 }
 
+mrsResult MRS_CALL mrsAudioReadStreamCreateWithResampleMode(
+    PeerConnectionHandle peerHandle,
+    int bufferMs,
+    mrsAudioResampleMode resampleMode,
+    AudioReadStreamHandle* audioBufferOut) {
+  *audioBufferOut = nullptr;
+  if ((resampleMode != mrsAudioResampleMode::kInt16) &&
+      (resampleMode != mrsAudioResampleMode::kFloat)) {
+    return Result::kInvalidParameter;
+  }
+  if (auto peer = static_cast<PeerConnection*>(peerHandle)) {
+    *audioBufferOut = new AudioReadStream(peer, bufferMs, resampleMode);
+    return Result::kSuccess;
+  }
+  return Result::kInvalidNativeHandle;
+}
+
 mrsResult MRS_CALL mrsAudioReadStreamRead(AudioReadStreamHandle readStream,
                                           int sampleRate,
                                           float data[],
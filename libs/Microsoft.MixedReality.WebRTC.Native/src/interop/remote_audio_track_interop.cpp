@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// This is a precompiled header, it must be on its own, followed by a blank
+// line, to prevent clang-format from reordering it with other headers.
+#include "pch.h"
+
+#include "media/remote_audio_track.h"
+#include "peer_connection.h"
+#include "remote_audio_track_interop.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+void MRS_CALL
+mrsRemoteAudioTrackAddRef(RemoteAudioTrackHandle handle) noexcept {
+  if (auto track = static_cast<RemoteAudioTrack*>(handle)) {
+    track->AddRef();
+  } else {
+    RTC_LOG(LS_WARNING)
+        << "Trying to add reference to NULL RemoteAudioTrack object.";
+  }
+}
+
+void MRS_CALL
+mrsRemoteAudioTrackRemoveRef(RemoteAudioTrackHandle handle) noexcept {
+  if (auto track = static_cast<RemoteAudioTrack*>(handle)) {
+    track->RemoveRef();
+  } else {
+    RTC_LOG(LS_WARNING) << "Trying to remove reference from NULL "
+                           "RemoteAudioTrack object.";
+  }
+}
+
+void MRS_CALL mrsRemoteAudioTrackRegisterFrameCallback(
+    RemoteAudioTrackHandle trackHandle,
+    PeerConnectionAudioFrameCallback callback,
+    void* user_data) noexcept {
+  if (auto track = static_cast<RemoteAudioTrack*>(trackHandle)) {
+    track->SetCallback(AudioFrameReadyCallback{callback, user_data});
+  }
+}
+
+mrsResult MRS_CALL
+mrsRemoteAudioTrackCreateReadStream(RemoteAudioTrackHandle trackHandle,
+                                    int bufferMs,
+                                    mrsAudioResampleMode resampleMode,
+                                    AudioReadStreamHandle* readStreamOut) {
+  *readStreamOut = nullptr;
+  if ((resampleMode != mrsAudioResampleMode::kInt16) &&
+      (resampleMode != mrsAudioResampleMode::kFloat)) {
+    return Result::kInvalidParameter;
+  }
+  if (auto track = static_cast<RemoteAudioTrack*>(trackHandle)) {
+    *readStreamOut = new AudioReadStream(*track, bufferMs, resampleMode);
+    return Result::kSuccess;
+  }
+  return Result::kInvalidNativeHandle;
+}
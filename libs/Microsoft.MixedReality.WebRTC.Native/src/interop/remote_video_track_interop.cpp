@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// This is a precompiled header, it must be on its own, followed by a blank
+// line, to prevent clang-format from reordering it with other headers.
+#include "pch.h"
+
+#include "media/remote_video_track.h"
+#include "remote_video_track_interop.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+namespace {
+
+template <typename CallbackT>
+void SetTrackCallback(RemoteVideoTrackHandle trackHandle,
+                      CallbackT&& callback) noexcept {
+  if (auto track = static_cast<RemoteVideoTrack*>(trackHandle)) {
+    track->SetCallback(std::forward<CallbackT>(callback));
+    track->UpdateSinkWants();
+  }
+}
+
+}  // namespace
+
+void MRS_CALL
+mrsRemoteVideoTrackAddRef(RemoteVideoTrackHandle handle) noexcept {
+  if (auto track = static_cast<RemoteVideoTrack*>(handle)) {
+    track->AddRef();
+  } else {
+    RTC_LOG(LS_WARNING)
+        << "Trying to add reference to NULL RemoteVideoTrack object.";
+  }
+}
+
+void MRS_CALL
+mrsRemoteVideoTrackRemoveRef(RemoteVideoTrackHandle handle) noexcept {
+  if (auto track = static_cast<RemoteVideoTrack*>(handle)) {
+    track->RemoveRef();
+  } else {
+    RTC_LOG(LS_WARNING) << "Trying to remove reference from NULL "
+                           "RemoteVideoTrack object.";
+  }
+}
+
+void MRS_CALL mrsRemoteVideoTrackRegisterI420AFrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionI420AVideoFrameCallback callback,
+    void* user_data) noexcept {
+  SetTrackCallback(trackHandle, I420AFrameReadyCallback{callback, user_data});
+}
+
+void MRS_CALL mrsRemoteVideoTrackRegisterArgb32FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionArgb32VideoFrameCallback callback,
+    void* user_data) noexcept {
+  SetTrackCallback(trackHandle, Argb32FrameReadyCallback{callback, user_data});
+}
+
+void MRS_CALL mrsRemoteVideoTrackRegisterNv12FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionNv12VideoFrameCallback callback,
+    void* user_data) noexcept {
+  SetTrackCallback(trackHandle, Nv12FrameReadyCallback{callback, user_data});
+}
+
+void MRS_CALL mrsRemoteVideoTrackRegisterRgba32FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionRgba32VideoFrameCallback callback,
+    void* user_data) noexcept {
+  SetTrackCallback(trackHandle, Rgba32FrameReadyCallback{callback, user_data});
+}
+
+void MRS_CALL mrsRemoteVideoTrackRegisterBgr24FrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionBgr24VideoFrameCallback callback,
+    void* user_data) noexcept {
+  SetTrackCallback(trackHandle, Bgr24FrameReadyCallback{callback, user_data});
+}
+
+void MRS_CALL mrsRemoteVideoTrackRegisterI420PackedFrameCallback(
+    RemoteVideoTrackHandle trackHandle,
+    PeerConnectionI420PackedVideoFrameCallback callback,
+    void* user_data) noexcept {
+  SetTrackCallback(trackHandle,
+                   I420PackedFrameReadyCallback{callback, user_data});
+}
+
+mrsResult MRS_CALL
+mrsRemoteVideoTrackSetFrameTargetSize(RemoteVideoTrackHandle trackHandle,
+                                      mrsVideoFrameFormat format,
+                                      int32_t width,
+                                      int32_t height) noexcept {
+  auto track = static_cast<RemoteVideoTrack*>(trackHandle);
+  if (!track) {
+    return Result::kInvalidNativeHandle;
+  }
+  return track->SetFrameTargetSize(format, width, height);
+}
+
+mrsResult MRS_CALL
+mrsRemoteVideoTrackSetDeliveryMode(RemoteVideoTrackHandle trackHandle,
+                                   mrsVideoFrameDeliveryMode mode) noexcept {
+  auto track = static_cast<RemoteVideoTrack*>(trackHandle);
+  if (!track) {
+    return Result::kInvalidNativeHandle;
+  }
+  if ((mode != mrsVideoFrameDeliveryMode::kInline) &&
+      (mode != mrsVideoFrameDeliveryMode::kPolled)) {
+    return Result::kInvalidParameter;
+  }
+  track->SetDeliveryMode(mode);
+  return Result::kSuccess;
+}
+
+mrsBool MRS_CALL
+mrsRemoteVideoTrackPollFrame(RemoteVideoTrackHandle trackHandle) noexcept {
+  if (auto track = static_cast<RemoteVideoTrack*>(trackHandle)) {
+    return (track->PollFrame() ? mrsBool::kTrue : mrsBool::kFalse);
+  }
+  return mrsBool::kFalse;
+}
+
+mrsResult MRS_CALL mrsRemoteVideoTrackSetConversionParallelism(
+    RemoteVideoTrackHandle trackHandle,
+    int32_t max_parallelism) noexcept {
+  auto track = static_cast<RemoteVideoTrack*>(trackHandle);
+  if (!track) {
+    return Result::kInvalidNativeHandle;
+  }
+  if (max_parallelism < 1) {
+    return Result::kInvalidParameter;
+  }
+  track->SetConversionParallelism(max_parallelism);
+  return Result::kSuccess;
+}
+
+mrsResult MRS_CALL
+mrsRemoteVideoTrackGetLatencyStats(RemoteVideoTrackHandle trackHandle,
+                                   mrsVideoFrameLatencyStats* stats) noexcept {
+  auto track = static_cast<RemoteVideoTrack*>(trackHandle);
+  if (!track) {
+    return Result::kInvalidNativeHandle;
+  }
+  if (!stats) {
+    return Result::kInvalidParameter;
+  }
+  track->GetLatencyStats(*stats);
+  return Result::kSuccess;
+}
+
+mrsResult MRS_CALL mrsRemoteVideoTrackResetLatencyStats(
+    RemoteVideoTrackHandle trackHandle) noexcept {
+  auto track = static_cast<RemoteVideoTrack*>(trackHandle);
+  if (!track) {
+    return Result::kInvalidNativeHandle;
+  }
+  track->ResetLatencyStats();
+  return Result::kSuccess;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include "video_frame.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Histogram of latency samples with logarithmic buckets, recorded from the
+/// frame delivery threads without locking.
+///
+/// Each field is updated atomically, but not all fields together, so a
+/// snapshot taken while samples are being recorded can be off by the samples
+/// in flight. This is fine for statistics.
+class LatencyHistogram {
+ public:
+  /// Index of the bucket counting samples of |latency_us| microseconds.
+  static int BucketIndex(std::int64_t latency_us) noexcept {
+    int index = 0;
+    for (std::int64_t bound = 64;
+         (index < kVideoLatencyBucketCount - 1) && (latency_us >= bound);
+         bound <<= 1) {
+      ++index;
+    }
+    return index;
+  }
+
+  /// Record a sample of |latency_us| microseconds. Negative samples, which
+  /// can only come from a clock adjustment, are recorded as zero.
+  void Record(std::int64_t latency_us) noexcept {
+    if (latency_us < 0) {
+      latency_us = 0;
+    }
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_us_.fetch_add(latency_us, std::memory_order_relaxed);
+    buckets_[BucketIndex(latency_us)].fetch_add(1, std::memory_order_relaxed);
+    std::int64_t min_us = min_us_.load(std::memory_order_relaxed);
+    while ((latency_us < min_us) &&
+           !min_us_.compare_exchange_weak(min_us, latency_us,
+                                          std::memory_order_relaxed)) {
+    }
+    std::int64_t max_us = max_us_.load(std::memory_order_relaxed);
+    while ((latency_us > max_us) &&
+           !max_us_.compare_exchange_weak(max_us, latency_us,
+                                          std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Copy the current content of the histogram into |out|.
+  void GetSnapshot(VideoLatencyHistogram& out) const noexcept {
+    out.count_ = count_.load(std::memory_order_relaxed);
+    out.sum_us_ = sum_us_.load(std::memory_order_relaxed);
+    const std::int64_t min_us = min_us_.load(std::memory_order_relaxed);
+    out.min_us_ = (min_us == kNoMin ? 0 : min_us);
+    out.max_us_ = max_us_.load(std::memory_order_relaxed);
+    for (int i = 0; i < kVideoLatencyBucketCount; ++i) {
+      out.buckets_[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  /// Remove all samples.
+  void Reset() noexcept {
+    count_.store(0, std::memory_order_relaxed);
+    sum_us_.store(0, std::memory_order_relaxed);
+    min_us_.store(kNoMin, std::memory_order_relaxed);
+    max_us_.store(0, std::memory_order_relaxed);
+    for (auto&& bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  static constexpr std::int64_t kNoMin =
+      std::numeric_limits<std::int64_t>::max();
+
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::int64_t> sum_us_{0};
+  std::atomic<std::int64_t> min_us_{kNoMin};
+  std::atomic<std::int64_t> max_us_{0};
+  std::atomic<std::uint64_t> buckets_[kVideoLatencyBucketCount]{};
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
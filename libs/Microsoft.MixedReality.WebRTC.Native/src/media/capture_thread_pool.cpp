@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// This is a precompiled header, it must be on its own, followed by a blank
+// line, to prevent clang-format from reordering it with other headers.
+#include "pch.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "media/capture_thread_pool.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+CaptureThreadPool::CaptureThreadPool(int thread_count) {
+  if (thread_count <= 0) {
+    thread_count =
+        std::clamp(static_cast<int>(std::thread::hardware_concurrency()) / 2, 1,
+                   kMaxDefaultThreadCount);
+  }
+  threads_.resize(thread_count);
+  for (int i = 0; i < thread_count; ++i) {
+    Entry& entry = threads_[i];
+    entry.thread_ = rtc::Thread::Create();
+    RTC_CHECK(entry.thread_.get());
+    entry.thread_->SetName("External video capture thread", &entry);
+    entry.thread_->Start();
+  }
+}
+
+CaptureThreadPool::~CaptureThreadPool() noexcept {
+  for (auto&& entry : threads_) {
+    RTC_DCHECK_EQ(0, entry.source_count_);
+    entry.thread_->Stop();
+  }
+}
+
+rtc::Thread* CaptureThreadPool::AcquireThread() noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  Entry* best = &threads_[0];
+  for (auto&& entry : threads_) {
+    if (entry.source_count_ < best->source_count_) {
+      best = &entry;
+    }
+  }
+  ++best->source_count_;
+  return best->thread_.get();
+}
+
+void CaptureThreadPool::ReleaseThread(rtc::Thread* thread) noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  for (auto&& entry : threads_) {
+    if (entry.thread_.get() == thread) {
+      RTC_DCHECK_LT(0, entry.source_count_);
+      --entry.source_count_;
+      return;
+    }
+  }
+  RTC_NOTREACHED();
+}
+
+}  // namespace Microsoft::MixedReality::WebRTC
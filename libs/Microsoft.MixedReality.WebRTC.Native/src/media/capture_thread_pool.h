@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rtc_base/thread.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Small pool of capture threads shared by all external video track sources,
+/// which schedule their frame requests as delayed messages on the thread they
+/// are assigned to. This avoids one mostly idle thread per source when many
+/// sources are alive. The pool is owned by the |GlobalFactory|.
+class CaptureThreadPool {
+ public:
+  /// Create a pool with the given number of threads. Zero means one thread per
+  /// two hardware cores, between 1 and |kMaxDefaultThreadCount| threads.
+  explicit CaptureThreadPool(int thread_count = 0);
+  ~CaptureThreadPool() noexcept;
+
+  /// Maximum number of threads of a pool created with the default count.
+  static constexpr int kMaxDefaultThreadCount = 4;
+
+  /// Number of threads of the pool.
+  int thread_count() const noexcept {
+    return static_cast<int>(threads_.size());
+  }
+
+  /// Assign the thread with the fewest sources to a new source. The thread
+  /// must be released with |ReleaseThread()| once the source stops capturing.
+  rtc::Thread* AcquireThread() noexcept;
+
+  /// Release a thread previously returned by |AcquireThread()|.
+  void ReleaseThread(rtc::Thread* thread) noexcept;
+
+ private:
+  struct Entry {
+    std::unique_ptr<rtc::Thread> thread_;
+
+    /// Number of sources currently assigned to the thread.
+    int source_count_ = 0;
+  };
+
+  std::vector<Entry> threads_;
+  std::mutex mutex_;
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
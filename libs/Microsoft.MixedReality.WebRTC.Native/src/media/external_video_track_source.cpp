@@ -3,6 +3,12 @@
 
 #include "pch.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "common_video/include/video_frame_buffer.h"
+#include "rtc_base/callback.h"
+
 #include "interop/global_factory.h"
 #include "media/external_video_track_source_impl.h"
 
@@ -15,109 +21,421 @@ enum {
   MSG_REQUEST_FRAME
 };
 
-/// Buffer adapter for an I420 video frame.
-class I420ABufferAdapter : public detail::BufferAdapter {
+/// Maximum frame rate of a source, in frames per second.
+constexpr const double kMaxFrameRate = 1000.0;
+
+/// Convert a deadline in microseconds to the millisecond time |PostAt()|
+/// expects, rounding up to never post a request before its deadline.
+int64_t DeadlineToPostTimeMs(int64_t deadline_us) {
+  return (deadline_us + 999) / 1000;
+}
+
+/// Wrap the memory of an I420A video frame into an I420 buffer without copying
+/// it. |release| is invoked once the buffer is destroyed. The alpha plane, if
+/// any, is ignored.
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> WrapI420ABuffer(
+    const I420AVideoFrame& frame_view,
+    FrameReleaseCallback release) {
+  return webrtc::WrapI420Buffer(
+      (int)frame_view.width_, (int)frame_view.height_,
+      (const uint8_t*)frame_view.ydata_, frame_view.ystride_,
+      (const uint8_t*)frame_view.udata_, frame_view.ustride_,
+      (const uint8_t*)frame_view.vdata_, frame_view.vstride_,
+      rtc::Callback0<void>([release]() { release(); }));
+}
+
+/// Get scratch memory of at least the given size to scale RGB frames into
+/// before converting them. The memory is per thread, so that sources completing
+/// frames on several threads do not contend, and is only reallocated to grow.
+uint8_t* GetRgbScratch(size_t size) {
+  thread_local std::vector<uint8_t> scratch;
+  if (scratch.size() < size) {
+    scratch.resize(size);
+  }
+  return scratch.data();
+}
+
+/// Convert a region of an ARGB32 frame into the same region of an I420 buffer
+/// of the same size. The region must start at even coordinates, to align with
+/// the subsampled chroma planes.
+void ConvertArgb32Region(const Argb32VideoFrame& frame_view,
+                         int x,
+                         int y,
+                         int width,
+                         int height,
+                         webrtc::I420Buffer& buffer) {
+  libyuv::ARGBToI420(
+      (const uint8_t*)frame_view.argb32_data_ + y * frame_view.stride_ + x * 4,
+      frame_view.stride_, buffer.MutableDataY() + y * buffer.StrideY() + x,
+      buffer.StrideY(),
+      buffer.MutableDataU() + (y / 2) * buffer.StrideU() + x / 2,
+      buffer.StrideU(),
+      buffer.MutableDataV() + (y / 2) * buffer.StrideV() + x / 2,
+      buffer.StrideV(), width, height);
+}
+
+/// Compute the key of the content of a frame to detect static frames.
+template <typename FrameT>
+uint32_t HashFrameContent(const FrameT& frame_view, uint32_t seed) {
+  return StaticFrameDetector::HashFrame(frame_view, seed);
+}
+
+/// The content of the persistent frame updated with dirty regions only
+/// changes with its version, so is not hashed.
+uint32_t HashFrameContent(
+    const detail::BufferAdapter::PersistentFrameView& frame_view,
+    uint32_t seed) {
+  return StaticFrameDetector::HashBytes(&frame_view.version_,
+                                        sizeof(frame_view.version_), seed);
+}
+
+/// Buffer adapter for a pull-mode source, requesting video frames of type
+/// |FrameT| from a custom video source.
+template <typename FrameT>
+class RequestBufferAdapter : public detail::BufferAdapter {
  public:
-  I420ABufferAdapter(RefPtr<I420AExternalVideoSource> video_source)
+  RequestBufferAdapter(RefPtr<ExternalVideoSource<FrameT>> video_source)
       : video_source_(std::move(video_source)) {}
   Result RequestFrame(ExternalVideoTrackSource& track_source,
                       std::uint32_t request_id,
                       std::int64_t timestamp_ms) noexcept override {
-    // Request a single I420 frame
-    I420AVideoFrameRequest request{track_source, timestamp_ms, request_id};
+    // Request a single frame
+    VideoFrameRequest<FrameT> request{track_source, timestamp_ms, request_id};
     return video_source_->FrameRequested(request);
   }
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
-      const I420AVideoFrame& frame_view) override {
-    return webrtc::I420Buffer::Copy(
-        (int)frame_view.width_, (int)frame_view.height_,
-        (const uint8_t*)frame_view.ydata_, frame_view.ystride_,
-        (const uint8_t*)frame_view.udata_, frame_view.ustride_,
-        (const uint8_t*)frame_view.vdata_, frame_view.vstride_);
-  }
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
-      const Argb32VideoFrame& /*frame_view*/) override {
-    RTC_CHECK(false);
-  }
 
  private:
-  RefPtr<I420AExternalVideoSource> video_source_;
+  RefPtr<ExternalVideoSource<FrameT>> video_source_;
 };
 
-/// Buffer adapter for a 32-bit ARGB video frame.
-class Argb32BufferAdapter : public detail::BufferAdapter {
+/// Buffer adapter for a push-mode source.
+class PushBufferAdapter : public detail::BufferAdapter {
  public:
-  Argb32BufferAdapter(RefPtr<Argb32ExternalVideoSource> video_source)
-      : video_source_(std::move(video_source)) {}
-  Result RequestFrame(ExternalVideoTrackSource& track_source,
-                      std::uint32_t request_id,
-                      std::int64_t timestamp_ms) noexcept override {
-    // Request a single ARGB32 frame
-    Argb32VideoFrameRequest request{track_source, timestamp_ms, request_id};
-    return video_source_->FrameRequested(request);
+  Result RequestFrame(ExternalVideoTrackSource& /*track_source*/,
+                      std::uint32_t /*request_id*/,
+                      std::int64_t /*timestamp_ms*/) noexcept override {
+    // Push sources never request frames.
+    return Result::kInvalidOperation;
   }
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
-      const I420AVideoFrame& /*frame_view*/) override {
-    RTC_CHECK(false);
-  }
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
-      const Argb32VideoFrame& frame_view) override {
-    // Check that the input frame fits within the constraints of chroma
-    // downsampling (width and height multiple of 2).
-    uint32_t width = frame_view.width_;
-    if (width & 0x1) {
-      if (!has_warned_) {
-        RTC_LOG(LS_WARNING) << "ARGB32 video frame has width " << width
-                            << " which is not a multiple of 2, so cannot be "
-                               "chroma-downsampled. "
-                               "Truncating to "
-                            << (width - 1) << " before I420 conversion.";
-        has_warned_ = true;
+};
+
+}  // namespace
+
+namespace Microsoft::MixedReality::WebRTC {
+namespace detail {
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::FillBuffer(
+    const I420AVideoFrame& frame_view,
+    const FrameAdaptation& adaptation) {
+  // Crop by offsetting into the planes, keeping the chroma planes aligned, and
+  // scale while copying into a pooled buffer. The alpha plane, if any, is
+  // ignored.
+  const int x = adaptation.crop_x_ & ~1;
+  const int y = adaptation.crop_y_ & ~1;
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer =
+      CreateBuffer(buffer_pool_, adaptation.width_, adaptation.height_);
+  libyuv::I420Scale(
+      (const uint8_t*)frame_view.ydata_ + y * frame_view.ystride_ + x,
+      frame_view.ystride_,
+      (const uint8_t*)frame_view.udata_ + (y / 2) * frame_view.ustride_ + x / 2,
+      frame_view.ustride_,
+      (const uint8_t*)frame_view.vdata_ + (y / 2) * frame_view.vstride_ + x / 2,
+      frame_view.vstride_, adaptation.crop_width_, adaptation.crop_height_,
+      buffer->MutableDataY(), buffer->StrideY(), buffer->MutableDataU(),
+      buffer->StrideU(), buffer->MutableDataV(), buffer->StrideV(),
+      adaptation.width_, adaptation.height_, libyuv::kFilterBox);
+  return buffer;
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::FillBuffer(
+    const Argb32VideoFrame& frame_view,
+    const FrameAdaptation& adaptation) {
+  const FrameAdaptation even = MakeEven("ARGB32", adaptation);
+  int32_t stride = 0;
+  const uint8_t* const data =
+      ScaleRgb32(frame_view.argb32_data_, frame_view.stride_, even, stride);
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer =
+      CreateBuffer(buffer_pool_, even.width_, even.height_);
+  libyuv::ARGBToI420(data, stride, buffer->MutableDataY(), buffer->StrideY(),
+                     buffer->MutableDataU(), buffer->StrideU(),
+                     buffer->MutableDataV(), buffer->StrideV(),
+                     buffer->width(), buffer->height());
+  return buffer;
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::FillBuffer(
+    const Nv12VideoFrame& frame_view,
+    const FrameAdaptation& adaptation) {
+  // NV12 has the same 4:2:0 chroma subsampling as I420, so only needs the UV
+  // plane to be deinterleaved, and supports odd sizes.
+  const int x = adaptation.crop_x_ & ~1;
+  const int y = adaptation.crop_y_ & ~1;
+  const uint8_t* const ydata =
+      (const uint8_t*)frame_view.ydata_ + y * frame_view.ystride_ + x;
+  const uint8_t* const uvdata =
+      (const uint8_t*)frame_view.uvdata_ + (y / 2) * frame_view.uvstride_ + x;
+  return ConvertAndScale(adaptation, [&](webrtc::I420Buffer& buffer) {
+    libyuv::NV12ToI420(ydata, frame_view.ystride_, uvdata, frame_view.uvstride_,
+                       buffer.MutableDataY(), buffer.StrideY(),
+                       buffer.MutableDataU(), buffer.StrideU(),
+                       buffer.MutableDataV(), buffer.StrideV(), buffer.width(),
+                       buffer.height());
+  });
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::FillBuffer(
+    const Yuy2VideoFrame& frame_view,
+    const FrameAdaptation& adaptation) {
+  const FrameAdaptation even = MakeEven("YUY2", adaptation);
+  const uint8_t* const data = (const uint8_t*)frame_view.yuy2_data_ +
+                              even.crop_y_ * frame_view.stride_ +
+                              even.crop_x_ * 2;
+  return ConvertAndScale(even, [&](webrtc::I420Buffer& buffer) {
+    libyuv::YUY2ToI420(data, frame_view.stride_, buffer.MutableDataY(),
+                       buffer.StrideY(), buffer.MutableDataU(),
+                       buffer.StrideU(), buffer.MutableDataV(),
+                       buffer.StrideV(), buffer.width(), buffer.height());
+  });
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::FillBuffer(
+    const Bgr24VideoFrame& frame_view,
+    const FrameAdaptation& adaptation) {
+  const FrameAdaptation even = MakeEven("BGR24", adaptation);
+  const uint8_t* const data = (const uint8_t*)frame_view.bgr24_data_ +
+                              even.crop_y_ * frame_view.stride_ +
+                              even.crop_x_ * 3;
+  return ConvertAndScale(even, [&](webrtc::I420Buffer& buffer) {
+    // libyuv names formats after the order of a little-endian word, so its
+    // RGB24 is B first in memory.
+    libyuv::RGB24ToI420(data, frame_view.stride_, buffer.MutableDataY(),
+                        buffer.StrideY(), buffer.MutableDataU(),
+                        buffer.StrideU(), buffer.MutableDataV(),
+                        buffer.StrideV(), buffer.width(), buffer.height());
+  });
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::FillBuffer(
+    const Rgba32VideoFrame& frame_view,
+    const FrameAdaptation& adaptation) {
+  const FrameAdaptation even = MakeEven("RGBA32", adaptation);
+  int32_t stride = 0;
+  const uint8_t* const data =
+      ScaleRgb32(frame_view.rgba32_data_, frame_view.stride_, even, stride);
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer =
+      CreateBuffer(buffer_pool_, even.width_, even.height_);
+  // libyuv ABGR is R first in memory.
+  libyuv::ABGRToI420(data, stride, buffer->MutableDataY(), buffer->StrideY(),
+                     buffer->MutableDataU(), buffer->StrideU(),
+                     buffer->MutableDataV(), buffer->StrideV(),
+                     buffer->width(), buffer->height());
+  return buffer;
+}
+
+rtc::scoped_refptr<webrtc::VideoFrameBuffer> BufferAdapter::AdaptBuffer(
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer,
+    const FrameAdaptation& adaptation) {
+  if (!adaptation.IsScaled() && (adaptation.crop_width_ == buffer->width()) &&
+      (adaptation.crop_height_ == buffer->height())) {
+    return buffer;
+  }
+  // The wrapped memory is released as soon as |buffer| is, after the copy.
+  rtc::scoped_refptr<webrtc::I420Buffer> adapted =
+      CreateBuffer(buffer_pool_, adaptation.width_, adaptation.height_);
+  adapted->CropAndScaleFrom(*buffer->ToI420(), adaptation.crop_x_,
+                            adaptation.crop_y_, adaptation.crop_width_,
+                            adaptation.crop_height_);
+  return adapted;
+}
+
+BufferAdapter::PersistentFrameView BufferAdapter::UpdateBuffer(
+    const Argb32VideoFrame& frame_view,
+    const mrsVideoRect* dirty_rects,
+    int dirty_rect_count) {
+  const int width = (int)frame_view.width_;
+  const int height = (int)frame_view.height_;
+  rtc::CritScope lock(&persistent_lock_);
+  if (!persistent_buffer_ || (persistent_buffer_->width() != width) ||
+      (persistent_buffer_->height() != height)) {
+    persistent_buffer_ = new PersistentBuffer(width, height);
+    spare_buffer_ = nullptr;
+    ConvertArgb32Region(frame_view, 0, 0, width, height, *persistent_buffer_);
+    ++persistent_version_;
+  } else if (dirty_rect_count > 0) {
+    if (!persistent_buffer_->HasOneRef()) {
+      // A frame still being encoded references the persistent frame, which
+      // must not change under the encoder, so update a copy instead.
+      if (!spare_buffer_ || !spare_buffer_->HasOneRef()) {
+        spare_buffer_ = new PersistentBuffer(width, height);
       }
-      --width;
+      libyuv::I420Copy(
+          persistent_buffer_->DataY(), persistent_buffer_->StrideY(),
+          persistent_buffer_->DataU(), persistent_buffer_->StrideU(),
+          persistent_buffer_->DataV(), persistent_buffer_->StrideV(),
+          spare_buffer_->MutableDataY(), spare_buffer_->StrideY(),
+          spare_buffer_->MutableDataU(), spare_buffer_->StrideU(),
+          spare_buffer_->MutableDataV(), spare_buffer_->StrideV(), width,
+          height);
+      std::swap(persistent_buffer_, spare_buffer_);
     }
-    uint32_t height = frame_view.height_;
-    if (height & 0x1) {
-      if (!has_warned_) {
-        RTC_LOG(LS_WARNING) << "ARGB32 video frame has height " << height
-                            << " which is not a multiple of 2, so cannot be "
-                               "chroma-downsampled. "
-                               "Truncating to "
-                            << (height - 1) << " before I420 conversion.";
-        has_warned_ = true;
+    for (int i = 0; i < dirty_rect_count; ++i) {
+      // Expand the region to even coordinates, at which the chroma planes are
+      // subsampled, and clip it to the frame.
+      const mrsVideoRect& rect = dirty_rects[i];
+      const int64_t left = std::max<int64_t>(rect.x_, 0) & ~1;
+      const int64_t top = std::max<int64_t>(rect.y_, 0) & ~1;
+      const int64_t right = std::min<int64_t>(
+          ((int64_t)rect.x_ + rect.width_ + 1) & ~1, width);
+      const int64_t bottom = std::min<int64_t>(
+          ((int64_t)rect.y_ + rect.height_ + 1) & ~1, height);
+      if ((left < right) && (top < bottom)) {
+        ConvertArgb32Region(frame_view, (int)left, (int)top,
+                            (int)(right - left), (int)(bottom - top),
+                            *persistent_buffer_);
       }
-      --height;
     }
+    ++persistent_version_;
+  }
+  PersistentFrameView view;
+  view.buffer_ = persistent_buffer_;
+  view.width_ = frame_view.width_;
+  view.height_ = frame_view.height_;
+  view.version_ = persistent_version_;
+  return view;
+}
 
-    // Create I420 buffer
-    rtc::scoped_refptr<webrtc::I420Buffer> buffer =
-        webrtc::I420Buffer::Create(width, height);
-
-    // Convert to I420 and copy to buffer
-    libyuv::ARGBToI420((const uint8_t*)frame_view.argb32_data_,
-                       frame_view.stride_, buffer->MutableDataY(),
-                       buffer->StrideY(), buffer->MutableDataU(),
-                       buffer->StrideU(), buffer->MutableDataV(),
-                       buffer->StrideV(), width, height);
+FrameAdaptation BufferAdapter::MakeEven(const char* format,
+                                        FrameAdaptation adaptation) {
+  // Check that the cropped frame fits within the constraints of chroma
+  // downsampling (width and height multiple of 2).
+  if ((adaptation.crop_width_ & 0x1) || (adaptation.crop_height_ & 0x1)) {
+    if (!has_warned_) {
+      RTC_LOG(LS_WARNING) << format << " video frame has size "
+                          << adaptation.crop_width_ << "x"
+                          << adaptation.crop_height_
+                          << " which is not a multiple of 2, so cannot be "
+                             "chroma-downsampled. Truncating to "
+                          << (adaptation.crop_width_ & ~1) << "x"
+                          << (adaptation.crop_height_ & ~1)
+                          << " before I420 conversion.";
+      has_warned_ = true;
+    }
+  }
+  adaptation.crop_x_ &= ~1;
+  adaptation.crop_y_ &= ~1;
+  adaptation.crop_width_ &= ~1;
+  adaptation.crop_height_ &= ~1;
+  adaptation.width_ &= ~1;
+  adaptation.height_ &= ~1;
+  return adaptation;
+}
 
+template <typename Convert>
+rtc::scoped_refptr<webrtc::I420Buffer> BufferAdapter::ConvertAndScale(
+    const FrameAdaptation& adaptation,
+    Convert&& convert) {
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer =
+      CreateBuffer(buffer_pool_, adaptation.width_, adaptation.height_);
+  if (!adaptation.IsScaled()) {
+    convert(*buffer);
     return buffer;
   }
+  // There is no scaler for these encodings, so convert the cropped region at
+  // its size into a scratch buffer, which is released right after scaling.
+  rtc::scoped_refptr<webrtc::I420Buffer> scratch = CreateBuffer(
+      scratch_pool_, adaptation.crop_width_, adaptation.crop_height_);
+  convert(*scratch);
+  buffer->ScaleFrom(*scratch);
+  return buffer;
+}
 
- private:
-  RefPtr<Argb32ExternalVideoSource> video_source_;
-  bool has_warned_ = false;
-};
+rtc::scoped_refptr<webrtc::I420Buffer> BufferAdapter::CreateBuffer(
+    I420Pool& pool,
+    int width,
+    int height) {
+  rtc::CritScope lock(&pool_lock_);
+  return pool.CreateBuffer(width, height);
+}
 
-}  // namespace
+const uint8_t* BufferAdapter::ScaleRgb32(const void* data,
+                                         int32_t stride,
+                                         const FrameAdaptation& adaptation,
+                                         int32_t& stride_out) {
+  const uint8_t* const cropped = (const uint8_t*)data +
+                                 adaptation.crop_y_ * stride +
+                                 adaptation.crop_x_ * 4;
+  if (!adaptation.IsScaled()) {
+    stride_out = stride;
+    return cropped;
+  }
+  // Scale before converting, so that the conversion only processes the pixels
+  // of the adapted frame. The scaler does not depend on the channel order.
+  stride_out = adaptation.width_ * 4;
+  uint8_t* const scaled =
+      GetRgbScratch((size_t)stride_out * (size_t)adaptation.height_);
+  libyuv::ARGBScale(cropped, stride, adaptation.crop_width_,
+                    adaptation.crop_height_, scaled, stride_out,
+                    adaptation.width_, adaptation.height_, libyuv::kFilterBox);
+  return scaled;
+}
 
-namespace Microsoft::MixedReality::WebRTC {
-namespace detail {
+rtc::VideoSinkWants SinkWantsTracker::wants() const {
+  // Combine the wants the same way |rtc::VideoBroadcaster| does for the
+  // adapted source.
+  rtc::VideoSinkWants wants;
+  rtc::CritScope lock(&lock_);
+  for (auto&& pair : sink_wants_) {
+    const rtc::VideoSinkWants& sink_wants = pair.second;
+    wants.max_pixel_count =
+        std::min(wants.max_pixel_count, sink_wants.max_pixel_count);
+    if (sink_wants.target_pixel_count &&
+        (!wants.target_pixel_count ||
+         (*sink_wants.target_pixel_count < *wants.target_pixel_count))) {
+      wants.target_pixel_count = sink_wants.target_pixel_count;
+    }
+    wants.max_framerate_fps =
+        std::min(wants.max_framerate_fps, sink_wants.max_framerate_fps);
+  }
+  if (wants.target_pixel_count &&
+      (*wants.target_pixel_count >= wants.max_pixel_count)) {
+    wants.target_pixel_count.emplace(wants.max_pixel_count);
+  }
+  return wants;
+}
+
+void SinkWantsTracker::AddOrUpdateSink(
+    rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
+    const rtc::VideoSinkWants& wants) {
+  {
+    rtc::CritScope lock(&lock_);
+    auto it = std::find_if(sink_wants_.begin(), sink_wants_.end(),
+                           [sink](auto&& pair) { return pair.first == sink; });
+    if (it != sink_wants_.end()) {
+      it->second = wants;
+    } else {
+      sink_wants_.emplace_back(sink, wants);
+    }
+  }
+  source_->AddOrUpdateSink(sink, wants);
+}
 
-constexpr const size_t kMaxPendingRequestCount = 64;
+void SinkWantsTracker::RemoveSink(
+    rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) {
+  {
+    rtc::CritScope lock(&lock_);
+    sink_wants_.erase(
+        std::remove_if(sink_wants_.begin(), sink_wants_.end(),
+                       [sink](auto&& pair) { return pair.first == sink; }),
+        sink_wants_.end());
+  }
+  source_->RemoveSink(sink);
+}
 
 RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceImpl::create(
-    std::unique_ptr<BufferAdapter> adapter) {
-  auto source = new ExternalVideoTrackSourceImpl(std::move(adapter));
+    std::unique_ptr<BufferAdapter> adapter,
+    bool push_mode) {
+  auto source =
+      new ExternalVideoTrackSourceImpl(std::move(adapter), push_mode);
   // Note: Video track sources always start already capturing; there is no
   // start/stop mechanism at the track level in WebRTC. A source is either being
   // initialized, or is already live. However because of wrappers and interop
@@ -126,11 +444,12 @@ RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceImpl::create(
 }
 
 ExternalVideoTrackSourceImpl::ExternalVideoTrackSourceImpl(
-    std::unique_ptr<BufferAdapter> adapter)
+    std::unique_ptr<BufferAdapter> adapter,
+    bool push_mode)
     : track_source_(new rtc::RefCountedObject<CustomTrackSourceAdapter>()),
+      sink_wants_(new rtc::RefCountedObject<SinkWantsTracker>(track_source_)),
       adapter_(std::forward<std::unique_ptr<BufferAdapter>>(adapter)),
-      capture_thread_(rtc::Thread::Create()) {
-  capture_thread_->SetName("ExternalVideoTrackSource capture thread", this);
+      push_mode_(push_mode) {
   GlobalFactory::Instance()->AddObject(ObjectType::kExternalVideoTrackSource,
                                        this);
 }
@@ -139,8 +458,8 @@ ExternalVideoTrackSourceImpl::~ExternalVideoTrackSourceImpl() {
   StopCapture();
   GlobalFactory::Instance()->RemoveObject(ObjectType::kExternalVideoTrackSource,
                                           this);
-}
-
+}
+
 void ExternalVideoTrackSourceImpl::FinishCreation() {
   StartCapture();
 }
@@ -151,73 +470,206 @@ void ExternalVideoTrackSourceImpl::StartCapture() {
     return;
   }
 
-  // Start capture thread
+  // Push sources have no capture thread; frames are delivered on the thread
+  // of the caller pushing them.
+  if (push_mode_) {
+    rtc::CritScope lock(&delivery_lock_);
+    track_source_->state_ = SourceState::kLive;
+    return;
+  }
+
+  // Assign a shared capture thread, and schedule the first frame request on it
+  // for 10ms from now.
+  CaptureThreadPool* const pool =
+      GlobalFactory::Instance()->GetOrCreateCaptureThreadPool();
+  rtc::CritScope lock(&request_lock_);
+  if (capture_thread_) {
+    return;  // already capturing
+  }
   track_source_->state_ = SourceState::kLive;
-  pending_requests_.clear();
-  capture_thread_->Start();
+  pending_requests_.Clear();
+  const int64_t first_deadline_us = rtc::TimeMicros() + 10000;
+  scheduler_.Start(first_deadline_us);
+  capture_thread_ = pool->AcquireThread();
+  capture_thread_->PostAt(RTC_FROM_HERE,
+                          DeadlineToPostTimeMs(first_deadline_us), this,
+                          MSG_REQUEST_FRAME);
+}
 
-  // Schedule first frame request for 10ms from now
-  int64_t now = rtc::TimeMillis();
-  capture_thread_->PostAt(RTC_FROM_HERE, now + 10, this, MSG_REQUEST_FRAME);
+Result ExternalVideoTrackSourceImpl::SetFrameRate(double frame_rate) noexcept {
+  if (!(frame_rate > 0.0) || (frame_rate > kMaxFrameRate)) {
+    return Result::kInvalidParameter;
+  }
+  rtc::CritScope lock(&request_lock_);
+  // The request already posted for the next deadline is unchanged.
+  scheduler_.SetFrameRate(frame_rate);
+  return Result::kSuccess;
+}
+
+void ExternalVideoTrackSourceImpl::SetSchedulePolicy(
+    mrsFrameSchedulePolicy policy) noexcept {
+  rtc::CritScope lock(&request_lock_);
+  scheduler_.SetPolicy(policy);
+}
+
+mrsWantedVideoFormat ExternalVideoTrackSourceImpl::GetWantedFormat(
+    int native_width,
+    int native_height) const noexcept {
+  const rtc::VideoSinkWants wants = sink_wants_->wants();
+  mrsWantedVideoFormat format{native_width, native_height,
+                              wants.max_framerate_fps};
+  // Like |cricket::VideoAdapter|, aim for the target pixel count if any, and
+  // never exceed the maximum pixel count. Frames of that size are then sent
+  // as is, without being scaled again.
+  const int64_t wanted_pixel_count =
+      wants.target_pixel_count.value_or(wants.max_pixel_count);
+  const int64_t native_pixel_count = (int64_t)native_width * native_height;
+  if (wanted_pixel_count < native_pixel_count) {
+    const double scale =
+        std::sqrt((double)wanted_pixel_count / (double)native_pixel_count);
+    format.width_ = std::max(2, (int)(native_width * scale) & ~1);
+    format.height_ = std::max(2, (int)(native_height * scale) & ~1);
+  }
+  return format;
 }
 
 Result ExternalVideoTrackSourceImpl::CompleteRequest(
     uint32_t request_id,
     int64_t timestamp_ms,
     const I420AVideoFrame& frame_view) {
-  // Validate pending request ID and retrieve frame timestamp
-  int64_t timestamp_ms_original = -1;
-  {
-    rtc::CritScope lock(&request_lock_);
-    for (auto it = pending_requests_.begin(); it != pending_requests_.end();
-         ++it) {
-      if (it->first == request_id) {
-        timestamp_ms_original = it->second;
-        // Remove outdated requests, including current one
-        ++it;
-        pending_requests_.erase(pending_requests_.begin(), it);
-        break;
-      }
-    }
-    if (timestamp_ms_original < 0) {
-      return Result::kInvalidParameter;
-    }
-  }
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      });
+}
 
-  // Apply user override if any
-  if (timestamp_ms != timestamp_ms_original) {
-    timestamp_ms = timestamp_ms_original;
-  }
+Result ExternalVideoTrackSourceImpl::CompleteRequest(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const Argb32VideoFrame& frame_view) {
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      });
+}
 
-  // Create and dispatch the video frame
-  webrtc::VideoFrame frame{
-      webrtc::VideoFrame::Builder()
-          .set_video_frame_buffer(adapter_->FillBuffer(frame_view))
-          .set_timestamp_ms(timestamp_ms)
-          .build()};
-  track_source_->DispatchFrame(frame);
-  return Result::kSuccess;
+Result ExternalVideoTrackSourceImpl::CompleteRequest(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const Nv12VideoFrame& frame_view) {
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      });
 }
 
 Result ExternalVideoTrackSourceImpl::CompleteRequest(
     uint32_t request_id,
     int64_t timestamp_ms,
-    const Argb32VideoFrame& frame_view) {
-  // Validate pending request ID and retrieve frame timestamp
+    const Yuy2VideoFrame& frame_view) {
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      });
+}
+
+Result ExternalVideoTrackSourceImpl::CompleteRequest(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const Bgr24VideoFrame& frame_view) {
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      });
+}
+
+Result ExternalVideoTrackSourceImpl::CompleteRequest(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const Rgba32VideoFrame& frame_view) {
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      });
+}
+
+Result ExternalVideoTrackSourceImpl::CompleteRequestNoCopy(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const I420AVideoFrame& frame_view,
+    FrameReleaseCallback release) noexcept {
+  // Wrap first, so that |release| is invoked on all paths once the buffer is
+  // released, including when the request is invalid.
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+      WrapI420ABuffer(frame_view, release);
+  return CompleteRequestImpl(
+      request_id, timestamp_ms, frame_view, /*can_repeat=*/false,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->AdaptBuffer(std::move(buffer), adaptation);
+      });
+}
+
+Result ExternalVideoTrackSourceImpl::CompleteRequestDirty(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const Argb32VideoFrame& frame_view,
+    const mrsVideoRect* dirty_rects,
+    int dirty_rect_count) noexcept {
+  // Update first, so that the next dirty regions apply on top of this frame
+  // even if the request is invalid or the frame is dropped. The lock prevents
+  // the adapter from being destroyed by |Shutdown()| during the update.
+  rtc::CritScope lock(&delivery_lock_);
+  if (!adapter_) {
+    return Result::kInvalidOperation;
+  }
+  const BufferAdapter::PersistentFrameView persistent =
+      adapter_->UpdateBuffer(frame_view, dirty_rects, dirty_rect_count);
+  // The persistent frame is never kept to be repeated, since that would force
+  // a copy for each update, while static frames are not converted anyway.
+  return CompleteRequestLocked(
+      request_id, timestamp_ms, persistent, /*can_repeat=*/false,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->AdaptBuffer(persistent.buffer_, adaptation);
+      });
+}
+
+template <typename FrameT, typename BufferFactory>
+Result ExternalVideoTrackSourceImpl::CompleteRequestImpl(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const FrameT& frame_view,
+    bool can_repeat,
+    BufferFactory&& make_buffer) {
+  rtc::CritScope lock(&delivery_lock_);
+  if (!adapter_) {
+    return Result::kInvalidOperation;
+  }
+  return CompleteRequestLocked(request_id, timestamp_ms, frame_view,
+                               can_repeat,
+                               std::forward<BufferFactory>(make_buffer));
+}
+
+template <typename FrameT, typename BufferFactory>
+Result ExternalVideoTrackSourceImpl::CompleteRequestLocked(
+    uint32_t request_id,
+    int64_t timestamp_ms,
+    const FrameT& frame_view,
+    bool can_repeat,
+    BufferFactory&& make_buffer) {
+  // Validate pending request ID and retrieve frame timestamp. Taking the
+  // request under |delivery_lock_| delivers frames in request order, since
+  // taking a request also discards all the older ones.
   int64_t timestamp_ms_original = -1;
   {
     rtc::CritScope lock(&request_lock_);
-    for (auto it = pending_requests_.begin(); it != pending_requests_.end();
-         ++it) {
-      if (it->first == request_id) {
-        timestamp_ms_original = it->second;
-        // Remove outdated requests, including current one
-        ++it;
-        pending_requests_.erase(pending_requests_.begin(), it);
-        break;
-      }
-    }
-    if (timestamp_ms_original < 0) {
+    // Remove outdated requests, including current one
+    if (!pending_requests_.Take(request_id, timestamp_ms_original)) {
       return Result::kInvalidParameter;
     }
   }
@@ -227,55 +679,313 @@ Result ExternalVideoTrackSourceImpl::CompleteRequest(
     timestamp_ms = timestamp_ms_original;
   }
 
+  // A dropped frame still completes its request.
+  DeliverFrame(timestamp_ms, frame_view, can_repeat,
+               std::forward<BufferFactory>(make_buffer));
+  return Result::kSuccess;
+}
+
+template <typename FrameT, typename BufferFactory>
+bool ExternalVideoTrackSourceImpl::DeliverFrame(int64_t timestamp_ms,
+                                                const FrameT& frame_view,
+                                                bool can_repeat,
+                                                BufferFactory&& make_buffer) {
+  // Drop the frame, or crop and scale it, as wanted by the sinks.
+  FrameAdaptation adaptation;
+  if (!track_source_->AdaptFrame((int)frame_view.width_,
+                                 (int)frame_view.height_,
+                                 timestamp_ms * rtc::kNumMicrosecsPerMillisec,
+                                 adaptation)) {
+    return false;
+  }
+
+  // Skip the conversion of static frames, identical to the previous one. The
+  // adaptation is part of the key, so that a buffer is only repeated if it has
+  // the size currently wanted.
+  const mrsStaticFramePolicy policy =
+      static_frame_policy_.load(std::memory_order_relaxed);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+  uint32_t key = 0;
+  if (policy != mrsStaticFramePolicy::kNone) {
+    key = HashFrameContent(
+        frame_view,
+        StaticFrameDetector::HashBytes(&adaptation, sizeof(adaptation),
+                                       StaticFrameDetector::kHashSeed));
+    if (static_frame_detector_.FindRepeat(key, timestamp_ms, buffer) &&
+        (policy == mrsStaticFramePolicy::kDrop)) {
+      return false;
+    }
+  }
+  if (!buffer) {
+    buffer = make_buffer(adaptation);
+    if (policy != mrsStaticFramePolicy::kNone) {
+      const bool keep_buffer =
+          can_repeat && (policy == mrsStaticFramePolicy::kRepeat);
+      static_frame_detector_.Update(key, timestamp_ms,
+                                    keep_buffer ? buffer : nullptr);
+    }
+  }
+
   // Create and dispatch the video frame
-  webrtc::VideoFrame frame{
-      webrtc::VideoFrame::Builder()
-          .set_video_frame_buffer(adapter_->FillBuffer(frame_view))
-          .set_timestamp_ms(timestamp_ms)
-          .build()};
+  webrtc::VideoFrame frame{webrtc::VideoFrame::Builder()
+                               .set_video_frame_buffer(std::move(buffer))
+                               .set_timestamp_ms(timestamp_ms)
+                               .build()};
   track_source_->DispatchFrame(frame);
-  return Result::kSuccess;
+  return true;
 }
 
 void ExternalVideoTrackSourceImpl::StopCapture() {
-  if (track_source_->state_ != SourceState::kEnded) {
-    capture_thread_->Stop();
+  if (push_mode_) {
+    // Wait for any frame being pushed to be delivered.
+    rtc::CritScope lock(&delivery_lock_);
     track_source_->state_ = SourceState::kEnded;
+    return;
+  }
+  rtc::Thread* capture_thread = nullptr;
+  {
+    rtc::CritScope lock(&request_lock_);
+    capture_thread = capture_thread_;
+    capture_thread_ = nullptr;
+    pending_requests_.Clear();
   }
-  pending_requests_.clear();
+  if (capture_thread) {
+    // Remove the scheduled request from the shared thread. Doing so on that
+    // thread also waits for any request being processed, which cannot
+    // schedule a new one anymore. If called from a request callback, this runs
+    // inline and the request in progress is not rescheduled either.
+    capture_thread->Invoke<void>(RTC_FROM_HERE, [this, capture_thread]() {
+      capture_thread->Clear(this, MSG_REQUEST_FRAME);
+    });
+    GlobalFactory::Instance()->GetOrCreateCaptureThreadPool()->ReleaseThread(
+        capture_thread);
+  }
+  track_source_->state_ = SourceState::kEnded;
 }
 
 void ExternalVideoTrackSourceImpl::Shutdown() noexcept {
   StopCapture();
+  rtc::CritScope lock(&delivery_lock_);
   adapter_ = nullptr;
+  static_frame_detector_.Reset();
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrame(
+    int64_t timestamp_ms,
+    const I420AVideoFrame& frame_view,
+    bool& dropped) noexcept {
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrame(
+    int64_t timestamp_ms,
+    const Argb32VideoFrame& frame_view,
+    bool& dropped) noexcept {
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrame(
+    int64_t timestamp_ms,
+    const Nv12VideoFrame& frame_view,
+    bool& dropped) noexcept {
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrame(
+    int64_t timestamp_ms,
+    const Yuy2VideoFrame& frame_view,
+    bool& dropped) noexcept {
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrame(
+    int64_t timestamp_ms,
+    const Bgr24VideoFrame& frame_view,
+    bool& dropped) noexcept {
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrame(
+    int64_t timestamp_ms,
+    const Rgba32VideoFrame& frame_view,
+    bool& dropped) noexcept {
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/true,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->FillBuffer(frame_view, adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrameNoCopy(
+    int64_t timestamp_ms,
+    const I420AVideoFrame& frame_view,
+    FrameReleaseCallback release,
+    bool& dropped) noexcept {
+  // Wrap first, so that |release| is invoked on all paths once the buffer is
+  // released, including when the frame is dropped.
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+      WrapI420ABuffer(frame_view, release);
+  return PushFrameImpl(
+      timestamp_ms, frame_view, /*can_repeat=*/false,
+      [&](const FrameAdaptation& adaptation) {
+        return adapter_->AdaptBuffer(std::move(buffer), adaptation);
+      },
+      dropped);
+}
+
+Result ExternalVideoTrackSourceImpl::PushFrameDirty(
+    int64_t timestamp_ms,
+    const Argb32VideoFrame& frame_view,
+    const mrsVideoRect* dirty_rects,
+    int dirty_rect_count,
+    bool& dropped) noexcept {
+  dropped = false;
+  if (!push_mode_) {
+    return Result::kInvalidOperation;
+  }
+
+  // Dropping the frame before updating the persistent frame would lose its
+  // update, so wait for any frame being delivered whatever the drop policy.
+  rtc::CritScope lock(&delivery_lock_);
+  if (!adapter_ || (track_source_->state_ != SourceState::kLive)) {
+    return Result::kInvalidOperation;
+  }
+  const BufferAdapter::PersistentFrameView persistent =
+      adapter_->UpdateBuffer(frame_view, dirty_rects, dirty_rect_count);
+  if (timestamp_ms <= last_push_timestamp_ms_) {
+    // Frames must be delivered in order; the update still applies to the next
+    // frame.
+    dropped = true;
+    return Result::kSuccess;
+  }
+  last_push_timestamp_ms_ = timestamp_ms;
+  dropped = !DeliverFrame(timestamp_ms, persistent, /*can_repeat=*/false,
+                          [&](const FrameAdaptation& adaptation) {
+                            return adapter_->AdaptBuffer(persistent.buffer_,
+                                                         adaptation);
+                          });
+  return Result::kSuccess;
+}
+
+void ExternalVideoTrackSourceImpl::SetPushDropPolicy(
+    mrsPushFrameDropPolicy policy) noexcept {
+  push_drop_policy_.store(policy, std::memory_order_relaxed);
+}
+
+void ExternalVideoTrackSourceImpl::SetStaticFramePolicy(
+    mrsStaticFramePolicy policy) noexcept {
+  static_frame_policy_.store(policy, std::memory_order_relaxed);
+  // Release any buffer kept to repeat it, and start again from the next frame.
+  static_frame_detector_.Reset();
 }
 
-// Note - This is called on the capture thread only.
+template <typename FrameT, typename BufferFactory>
+Result ExternalVideoTrackSourceImpl::PushFrameImpl(
+    int64_t timestamp_ms,
+    const FrameT& frame_view,
+    bool can_repeat,
+    BufferFactory&& make_buffer,
+    bool& dropped) noexcept {
+  dropped = false;
+  if (!push_mode_) {
+    return Result::kInvalidOperation;
+  }
+
+  // Apply back-pressure to the producer, or drop the frame if a previous one
+  // is still being delivered by another thread.
+  if (push_drop_policy_.load(std::memory_order_relaxed) ==
+      mrsPushFrameDropPolicy::kWait) {
+    delivery_lock_.Enter();
+  } else if (!delivery_lock_.TryEnter()) {
+    dropped = true;
+    return Result::kSuccess;
+  }
+
+  Result result = Result::kSuccess;
+  if (!adapter_ || (track_source_->state_ != SourceState::kLive)) {
+    result = Result::kInvalidOperation;
+  } else if (timestamp_ms <= last_push_timestamp_ms_) {
+    // Frames must be delivered in order; drop any out-of-order frame.
+    dropped = true;
+  } else {
+    last_push_timestamp_ms_ = timestamp_ms;
+    dropped = !DeliverFrame(timestamp_ms, frame_view, can_repeat,
+                            std::forward<BufferFactory>(make_buffer));
+  }
+  delivery_lock_.Leave();
+  return result;
+}
+
+// Note - This is called on the shared capture thread of the source only.
 void ExternalVideoTrackSourceImpl::OnMessage(rtc::Message* message) {
   switch (message->message_id) {
     case MSG_REQUEST_FRAME:
-      const int64_t now = rtc::TimeMillis();
+      // Timestamp the frame with its deadline rather than the current time,
+      // so that frames are evenly spaced even if the request is late.
+      const int64_t now_us = rtc::TimeMicros();
+      int64_t frame_time_us = 0;
+      int64_t next_deadline_us = 0;
+      uint64_t skipped_count = 0;
 
       // Request a frame from the external video source
       uint32_t request_id = 0;
       {
         rtc::CritScope lock(&request_lock_);
-        // Discard an old request if no space available. This allows restarting
-        // after a long delay, otherwise skipping the request generally also
-        // prevent the user from calling CompleteFrame() to make some space for
-        // more. The queue is still useful for just-in-time or short delays.
-        if (pending_requests_.size() >= kMaxPendingRequestCount) {
-          pending_requests_.erase(pending_requests_.begin());
-        }
-        request_id = next_request_id_++;
-        pending_requests_.emplace_back(request_id, now);
+        const uint64_t skipped_before = scheduler_.skipped_frame_count();
+        frame_time_us = scheduler_.Advance(now_us);
+        next_deadline_us = scheduler_.next_deadline_us();
+        skipped_count = scheduler_.skipped_frame_count() - skipped_before;
+        // The ring discards the oldest request if no space available. This
+        // allows restarting after a long delay, otherwise skipping the request
+        // generally also prevent the user from calling CompleteFrame() to make
+        // some space for more. The ring is still useful for just-in-time or
+        // short delays.
+        request_id = pending_requests_.Push(frame_time_us / 1000);
       }
-      adapter_->RequestFrame(*this, request_id, now);
+      if (skipped_count > 0) {
+        RTC_LOG(LS_VERBOSE) << "External video source late by "
+                            << (now_us - frame_time_us) << " us; skipped "
+                            << skipped_count << " frame request(s).";
+      }
+      adapter_->RequestFrame(*this, request_id, frame_time_us / 1000);
 
-      // Schedule a new request for 30ms from now
-      //< TODO - this is unreliable and prone to drifting; figure out something
-      // better
-      capture_thread_->PostAt(RTC_FROM_HERE, now + 30, this, MSG_REQUEST_FRAME);
+      // Schedule the next request at its absolute deadline, unless capture
+      // stopped in the meantime. If the source is catching up, the deadline is
+      // already past and the request runs immediately.
+      {
+        rtc::CritScope lock(&request_lock_);
+        if (capture_thread_) {
+          capture_thread_->PostAt(RTC_FROM_HERE,
+                                  DeadlineToPostTimeMs(next_deadline_us), this,
+                                  MSG_REQUEST_FRAME);
+        }
+      }
       break;
   }
 }
@@ -285,27 +995,54 @@ void ExternalVideoTrackSourceImpl::OnMessage(rtc::Message* message) {
 RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createFromI420A(
     RefPtr<I420AExternalVideoSource> video_source) {
   return detail::ExternalVideoTrackSourceImpl::create(
-      std::make_unique<I420ABufferAdapter>(std::move(video_source)));
+      std::make_unique<RequestBufferAdapter<I420AVideoFrame>>(
+          std::move(video_source)),
+      /*push_mode=*/false);
 }
 
 RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createFromArgb32(
     RefPtr<Argb32ExternalVideoSource> video_source) {
   return detail::ExternalVideoTrackSourceImpl::create(
-      std::make_unique<Argb32BufferAdapter>(std::move(video_source)));
+      std::make_unique<RequestBufferAdapter<Argb32VideoFrame>>(
+          std::move(video_source)),
+      /*push_mode=*/false);
 }
 
-Result I420AVideoFrameRequest::CompleteRequest(
-    const I420AVideoFrame& frame_view) {
-  auto impl =
-      static_cast<detail::ExternalVideoTrackSourceImpl*>(&track_source_);
-  return impl->CompleteRequest(request_id_, timestamp_ms_, frame_view);
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createFromNv12(
+    RefPtr<Nv12ExternalVideoSource> video_source) {
+  return detail::ExternalVideoTrackSourceImpl::create(
+      std::make_unique<RequestBufferAdapter<Nv12VideoFrame>>(
+          std::move(video_source)),
+      /*push_mode=*/false);
 }
 
-Result Argb32VideoFrameRequest::CompleteRequest(
-    const Argb32VideoFrame& frame_view) {
-  auto impl =
-      static_cast<detail::ExternalVideoTrackSourceImpl*>(&track_source_);
-  return impl->CompleteRequest(request_id_, timestamp_ms_, frame_view);
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createFromYuy2(
+    RefPtr<Yuy2ExternalVideoSource> video_source) {
+  return detail::ExternalVideoTrackSourceImpl::create(
+      std::make_unique<RequestBufferAdapter<Yuy2VideoFrame>>(
+          std::move(video_source)),
+      /*push_mode=*/false);
+}
+
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createFromBgr24(
+    RefPtr<Bgr24ExternalVideoSource> video_source) {
+  return detail::ExternalVideoTrackSourceImpl::create(
+      std::make_unique<RequestBufferAdapter<Bgr24VideoFrame>>(
+          std::move(video_source)),
+      /*push_mode=*/false);
+}
+
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createFromRgba32(
+    RefPtr<Rgba32ExternalVideoSource> video_source) {
+  return detail::ExternalVideoTrackSourceImpl::create(
+      std::make_unique<RequestBufferAdapter<Rgba32VideoFrame>>(
+          std::move(video_source)),
+      /*push_mode=*/false);
+}
+
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSource::createForPush() {
+  return detail::ExternalVideoTrackSourceImpl::create(
+      std::make_unique<PushBufferAdapter>(), /*push_mode=*/true);
 }
 
 }  // namespace Microsoft::MixedReality::WebRTC
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "callback.h"
 #include "mrs_errors.h"
 #include "refptr.h"
 #include "tracked_object.h"
@@ -13,9 +14,14 @@ namespace Microsoft::MixedReality::WebRTC {
 
 class ExternalVideoTrackSource;
 
-/// Frame request for an external video source producing video frames encoded in
-/// I420 format, with optional Alpha (opacity) plane.
-struct I420AVideoFrameRequest {
+/// Callback invoked once the memory of a video frame passed to a track source
+/// without copy is not used anymore, and can be reused by its owner.
+using FrameReleaseCallback = Callback<>;
+
+/// Frame request for an external video source producing video frames of type
+/// |FrameT|, like |I420AVideoFrame| or |Nv12VideoFrame|.
+template <typename FrameT>
+struct VideoFrameRequest {
   /// Video track source the request is related to.
   ExternalVideoTrackSource& track_source_;
 
@@ -27,12 +33,12 @@ struct I420AVideoFrameRequest {
 
   /// Complete the request by making the track source consume the given video
   /// frame and have it deliver the frame to all its video tracks.
-  Result CompleteRequest(const I420AVideoFrame& frame_view);
+  Result CompleteRequest(const FrameT& frame_view);
 };
 
-/// Custom video source producing video frames encoded in I420 format, with
-/// optional Alpha (opacity) plane.
-class I420AExternalVideoSource : public RefCountedBase {
+/// Custom video source producing video frames of type |FrameT|.
+template <typename FrameT>
+class ExternalVideoSource : public RefCountedBase {
  public:
   /// Produce a video frame for a request initiated by an external track source.
   ///
@@ -40,39 +46,41 @@ class I420AExternalVideoSource : public RefCountedBase {
   /// video frame is needed (pull model). The custom video source implementation
   /// must either return an error, or produce a new video frame and call the
   /// |CompleteRequest()| request on the |frame_request| object.
-  virtual Result FrameRequested(I420AVideoFrameRequest& frame_request) = 0;
+  ///
+  /// This is invoked on a capture thread shared with other sources, so should
+  /// return quickly, and may complete the request later from another thread.
+  virtual Result FrameRequested(VideoFrameRequest<FrameT>& frame_request) = 0;
 };
 
+/// Frame request for an external video source producing video frames encoded in
+/// I420 format, with optional Alpha (opacity) plane.
+using I420AVideoFrameRequest = VideoFrameRequest<I420AVideoFrame>;
+
+/// Custom video source producing video frames encoded in I420 format, with
+/// optional Alpha (opacity) plane.
+using I420AExternalVideoSource = ExternalVideoSource<I420AVideoFrame>;
+
 /// Frame request for an external video source producing video frames encoded in
 /// ARGB 32-bit-per-pixel format.
-struct Argb32VideoFrameRequest {
-  /// Video track source the request is related to.
-  ExternalVideoTrackSource& track_source_;
+using Argb32VideoFrameRequest = VideoFrameRequest<Argb32VideoFrame>;
 
-  /// Video frame timestamp, in milliseconds.
-  std::int64_t timestamp_ms_;
+/// Custom video source producing video frames encoded in ARGB 32-bit-per-pixel
+/// format.
+using Argb32ExternalVideoSource = ExternalVideoSource<Argb32VideoFrame>;
 
-  /// Unique identifier of the request.
-  const std::uint32_t request_id_;
+/// Custom video source producing video frames encoded in NV12 format.
+using Nv12ExternalVideoSource = ExternalVideoSource<Nv12VideoFrame>;
 
-  /// Complete the request by making the track source consume the given video
-  /// frame and have it deliver the frame to all its video tracks.
-  Result CompleteRequest(const Argb32VideoFrame& frame_view);
-};
+/// Custom video source producing video frames encoded in YUY2 format.
+using Yuy2ExternalVideoSource = ExternalVideoSource<Yuy2VideoFrame>;
 
-/// Custom video source producing vidoe frames encoded in ARGB 32-bit-per-pixel
+/// Custom video source producing video frames encoded in BGR 24-bit-per-pixel
 /// format.
-class Argb32ExternalVideoSource : public RefCountedBase {
- public:
-  /// Produce a video frame for a request initiated by an external track source.
-  ///
-  /// This callback is invoked automatically by the track source whenever a new
-  /// video frame is needed (pull model). The custom video source implementation
-  /// must either return an error, or produce a new video frame and call the
-  /// |CompleteRequest()| request on the |track_source| object, passing the
-  /// |request_id| of the current request being completed.
-  virtual Result FrameRequested(Argb32VideoFrameRequest& frame_request) = 0;
-};
+using Bgr24ExternalVideoSource = ExternalVideoSource<Bgr24VideoFrame>;
+
+/// Custom video source producing video frames encoded in RGBA 32-bit-per-pixel
+/// format.
+using Rgba32ExternalVideoSource = ExternalVideoSource<Rgba32VideoFrame>;
 
 /// Video track source acting as an adapter for an external source of raw
 /// frames.
@@ -88,6 +96,30 @@ class ExternalVideoTrackSource : public TrackedObject {
   static RefPtr<ExternalVideoTrackSource> createFromArgb32(
       RefPtr<Argb32ExternalVideoSource> video_source);
 
+  /// Helper to create an external video track source from a custom NV12 video
+  /// frame request callback.
+  static RefPtr<ExternalVideoTrackSource> createFromNv12(
+      RefPtr<Nv12ExternalVideoSource> video_source);
+
+  /// Helper to create an external video track source from a custom YUY2 video
+  /// frame request callback.
+  static RefPtr<ExternalVideoTrackSource> createFromYuy2(
+      RefPtr<Yuy2ExternalVideoSource> video_source);
+
+  /// Helper to create an external video track source from a custom BGR24 video
+  /// frame request callback.
+  static RefPtr<ExternalVideoTrackSource> createFromBgr24(
+      RefPtr<Bgr24ExternalVideoSource> video_source);
+
+  /// Helper to create an external video track source from a custom RGBA32 video
+  /// frame request callback.
+  static RefPtr<ExternalVideoTrackSource> createFromRgba32(
+      RefPtr<Rgba32ExternalVideoSource> video_source);
+
+  /// Create an external video track source delivering the frames pushed with
+  /// |PushFrame()|, without frame requests.
+  static RefPtr<ExternalVideoTrackSource> createForPush();
+
   /// Finish the creation of the video track source, and start capturing.
   /// See |mrsExternalVideoTrackSourceFinishCreation()| for details.
   virtual void FinishCreation() = 0;
@@ -97,18 +129,114 @@ class ExternalVideoTrackSource : public TrackedObject {
   virtual void StartCapture() = 0;
 
   /// Complete a given video frame request with the provided I420A frame.
-  /// The caller must know the source expects an I420A frame; there is no check
-  /// to confirm the source is I420A-based or ARGB32-based.
+  /// Any source accepts frames of any encoding, whatever the encoding of the
+  /// frames its video source produces; frames not in I420 are converted once
+  /// to I420 before being delivered.
   virtual Result CompleteRequest(uint32_t request_id,
-                                         int64_t timestamp_ms,
-                                         const I420AVideoFrame& frame) = 0;
+                                 int64_t timestamp_ms,
+                                 const I420AVideoFrame& frame) = 0;
 
-  /// Complete a given video frame request with the provided ARGB32 frame.
-  /// The caller must know the source expects an ARGB32 frame; there is no check
-  /// to confirm the source is I420A-based or ARGB32-based.
+  /// Same as above for frames of other encodings.
+  virtual Result CompleteRequest(uint32_t request_id,
+                                 int64_t timestamp_ms,
+                                 const Argb32VideoFrame& frame) = 0;
+  virtual Result CompleteRequest(uint32_t request_id,
+                                 int64_t timestamp_ms,
+                                 const Nv12VideoFrame& frame) = 0;
+  virtual Result CompleteRequest(uint32_t request_id,
+                                 int64_t timestamp_ms,
+                                 const Yuy2VideoFrame& frame) = 0;
   virtual Result CompleteRequest(uint32_t request_id,
-                                         int64_t timestamp_ms,
-                                         const Argb32VideoFrame& frame) = 0;
+                                 int64_t timestamp_ms,
+                                 const Bgr24VideoFrame& frame) = 0;
+  virtual Result CompleteRequest(uint32_t request_id,
+                                 int64_t timestamp_ms,
+                                 const Rgba32VideoFrame& frame) = 0;
+
+  /// Deliver a frame pushed by the caller to a source created with
+  /// |createForPush()|, with the caller's timestamp. On success, |dropped| is
+  /// set to indicate whether the frame was dropped instead of delivered. See
+  /// |mrsExternalVideoTrackSourcePushI420AFrame()| for details.
+  virtual Result PushFrame(int64_t timestamp_ms,
+                           const I420AVideoFrame& frame,
+                           bool& dropped) noexcept = 0;
+
+  /// Same as above for frames of other encodings.
+  virtual Result PushFrame(int64_t timestamp_ms,
+                           const Argb32VideoFrame& frame,
+                           bool& dropped) noexcept = 0;
+  virtual Result PushFrame(int64_t timestamp_ms,
+                           const Nv12VideoFrame& frame,
+                           bool& dropped) noexcept = 0;
+  virtual Result PushFrame(int64_t timestamp_ms,
+                           const Yuy2VideoFrame& frame,
+                           bool& dropped) noexcept = 0;
+  virtual Result PushFrame(int64_t timestamp_ms,
+                           const Bgr24VideoFrame& frame,
+                           bool& dropped) noexcept = 0;
+  virtual Result PushFrame(int64_t timestamp_ms,
+                           const Rgba32VideoFrame& frame,
+                           bool& dropped) noexcept = 0;
+
+  /// Set the policy for frames pushed while a previous frame is still being
+  /// delivered.
+  virtual void SetPushDropPolicy(mrsPushFrameDropPolicy policy) noexcept = 0;
+
+  /// Complete a given video frame request with the provided I420A frame,
+  /// without copying its memory, which the encoder reads directly. The frame
+  /// memory must remain valid and unchanged until |release| is invoked, which
+  /// happens exactly once, on any thread, possibly before this call returns
+  /// if the frame is not used, for example because the request is invalid.
+  /// This can be used with any source, whatever its frame encoding.
+  virtual Result CompleteRequestNoCopy(
+      uint32_t request_id,
+      int64_t timestamp_ms,
+      const I420AVideoFrame& frame,
+      FrameReleaseCallback release) noexcept = 0;
+
+  /// Same as |PushFrame()|, without copying the frame memory. The memory must
+  /// remain valid and unchanged until |release| is invoked, as with
+  /// |CompleteRequestNoCopy()|.
+  virtual Result PushFrameNoCopy(int64_t timestamp_ms,
+                                 const I420AVideoFrame& frame,
+                                 FrameReleaseCallback release,
+                                 bool& dropped) noexcept = 0;
+
+  /// Complete a given video frame request with an ARGB32 frame of which only
+  /// the given dirty regions changed since the previous frame provided with
+  /// dirty regions, converting only those regions into a persistent I420
+  /// frame. See |mrsExternalVideoTrackSourceCompleteArgb32FrameRequestDirty()|
+  /// for details.
+  virtual Result CompleteRequestDirty(uint32_t request_id,
+                                      int64_t timestamp_ms,
+                                      const Argb32VideoFrame& frame,
+                                      const mrsVideoRect* dirty_rects,
+                                      int dirty_rect_count) noexcept = 0;
+
+  /// Same as |PushFrame()|, with the dirty regions of |CompleteRequestDirty()|.
+  /// The frame waits for any frame being delivered, whatever the drop policy.
+  virtual Result PushFrameDirty(int64_t timestamp_ms,
+                                const Argb32VideoFrame& frame,
+                                const mrsVideoRect* dirty_rects,
+                                int dirty_rect_count,
+                                bool& dropped) noexcept = 0;
+
+  /// Set the rate at which frames are requested from the external source, in
+  /// frames per second.
+  virtual Result SetFrameRate(double frame_rate) noexcept = 0;
+
+  /// Set the policy for frame requests whose deadline passed while the source
+  /// was late.
+  virtual void SetSchedulePolicy(mrsFrameSchedulePolicy policy) noexcept = 0;
+
+  /// Get the video format currently wanted by the video tracks of the source,
+  /// for frames whose resolution would otherwise be the given native one.
+  virtual mrsWantedVideoFormat GetWantedFormat(int native_width,
+                                               int native_height) const
+      noexcept = 0;
+
+  /// Set the policy for static frames, identical to the previous frame.
+  virtual void SetStaticFramePolicy(mrsStaticFramePolicy policy) noexcept = 0;
 
   /// Stop the video capture. This will stop producing video frames.
   virtual void StopCapture() = 0;
@@ -117,23 +245,26 @@ class ExternalVideoTrackSource : public TrackedObject {
   virtual void Shutdown() noexcept = 0;
 };
 
+template <typename FrameT>
+Result VideoFrameRequest<FrameT>::CompleteRequest(const FrameT& frame_view) {
+  return track_source_.CompleteRequest(request_id_, timestamp_ms_, frame_view);
+}
+
 namespace detail {
 
 //
 // Helpers
 //
 
-/// Create an I420A external video track source wrapping the given interop
-/// callback.
-RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromI420A(
-    mrsRequestExternalI420AVideoFrameCallback callback,
+/// Create an external video track source wrapping the given interop callback
+/// requesting frames of type |FrameT|. This is defined for |I420AVideoFrame|,
+/// |Argb32VideoFrame|, |Nv12VideoFrame|, |Yuy2VideoFrame|, |Bgr24VideoFrame|,
+/// and |Rgba32VideoFrame|.
+template <typename FrameT>
+RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromCallback(
+    mrsRequestExternalVideoFrameCallback callback,
     void* user_data);
 
-/// Create an ARGB32 external video track source wrapping the given interop
-/// callback.
-RefPtr<ExternalVideoTrackSource> ExternalVideoTrackSourceCreateFromArgb32(
-    mrsRequestExternalArgb32VideoFrameCallback callback,
-    void* user_data);
 } // namespace detail
 
 }  // namespace Microsoft::MixedReality::WebRTC
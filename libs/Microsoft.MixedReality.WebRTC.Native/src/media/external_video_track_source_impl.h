@@ -3,16 +3,53 @@
 
 #pragma once
 
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "api/notifier.h"
 #include "media/base/adaptedvideotracksource.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
 
 #include "callback.h"
 #include "external_video_track_source.h"
+#include "frame_request_ring.h"
+#include "frame_scheduler.h"
 #include "interop_api.h"
+#include "media/static_frame_detector.h"
+#include "video_frame_buffer_pool.h"
 
 namespace Microsoft::MixedReality::WebRTC::detail {
 
+/// Crop and scale of a video frame to the resolution currently wanted by the
+/// sinks of its track source, as computed by
+/// |rtc::AdaptedVideoTrackSource::AdaptFrame()|.
+struct FrameAdaptation {
+  /// Region of the input frame to keep, in pixels.
+  int crop_x_ = 0;
+  int crop_y_ = 0;
+  int crop_width_ = 0;
+  int crop_height_ = 0;
+
+  /// Size of the adapted frame the cropped region is scaled to, in pixels.
+  int width_ = 0;
+  int height_ = 0;
+
+  /// Whether the cropped region needs to be scaled.
+  bool IsScaled() const noexcept {
+    return (width_ != crop_width_) || (height_ != crop_height_);
+  }
+};
+
 /// Adapater for the frame buffer of an external video track source,
 /// to support various frame encodings in a unified way.
+///
+/// Frames of any encoding are converted once into I420 buffers from a pool
+/// owned by the adapter, so that the frames of a source can use a different
+/// encoding than the one its video source produces. Frames are cropped and
+/// scaled according to their |FrameAdaptation| before or while converting
+/// them, so that the conversion only processes the pixels actually sent.
 class BufferAdapter {
  public:
   virtual ~BufferAdapter() = default;
@@ -23,11 +60,107 @@ class BufferAdapter {
                               int64_t time_ms) noexcept = 0;
 
   /// Allocate a new video frame buffer with a video frame received from a
-  /// fulfilled frame request.
-  virtual rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
-      const I420AVideoFrame& frame_view) = 0;
-  virtual rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
-      const Argb32VideoFrame& frame_view) = 0;
+  /// fulfilled frame request or pushed by the caller, adapted as specified.
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
+      const I420AVideoFrame& frame_view,
+      const FrameAdaptation& adaptation);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
+      const Argb32VideoFrame& frame_view,
+      const FrameAdaptation& adaptation);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
+      const Nv12VideoFrame& frame_view,
+      const FrameAdaptation& adaptation);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
+      const Yuy2VideoFrame& frame_view,
+      const FrameAdaptation& adaptation);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
+      const Bgr24VideoFrame& frame_view,
+      const FrameAdaptation& adaptation);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> FillBuffer(
+      const Rgba32VideoFrame& frame_view,
+      const FrameAdaptation& adaptation);
+
+  /// Adapt a buffer wrapping a frame without copy, which is only copied if it
+  /// needs to be cropped or scaled.
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> AdaptBuffer(
+      rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer,
+      const FrameAdaptation& adaptation);
+
+  /// Content of the persistent frame updated with |UpdateBuffer()|.
+  struct PersistentFrameView {
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+
+    /// Version of the content, incremented each time it changes.
+    uint64_t version_ = 0;
+  };
+
+  /// Update the persistent I420 frame of the adapter by converting only the
+  /// dirty regions of an ARGB32 frame, or the whole frame if the persistent
+  /// frame has another size, and return the updated content. The persistent
+  /// frame is updated in place, unless still referenced by a frame being
+  /// encoded, in which case it is copied first. This is thread-safe.
+  PersistentFrameView UpdateBuffer(const Argb32VideoFrame& frame_view,
+                                   const mrsVideoRect* dirty_rects,
+                                   int dirty_rect_count);
+
+ private:
+  /// Truncate the cropped region and the adapted size to even dimensions for
+  /// the chroma downsampling of packed and interleaved encodings.
+  FrameAdaptation MakeEven(const char* format, FrameAdaptation adaptation);
+
+  /// Get a buffer of the adapted size filled by |convert|, which converts the
+  /// cropped region of the input frame into the I420 buffer it is passed. If
+  /// the frame is scaled, it is converted into a scratch buffer first.
+  template <typename Convert>
+  rtc::scoped_refptr<webrtc::I420Buffer> ConvertAndScale(
+      const FrameAdaptation& adaptation,
+      Convert&& convert);
+
+  /// Scale the cropped region of a 32-bit RGB frame to the adapted size, and
+  /// return the scaled pixels and their stride, or the cropped region as is
+  /// if not scaled.
+  const uint8_t* ScaleRgb32(const void* data,
+                            int32_t stride,
+                            const FrameAdaptation& adaptation,
+                            int32_t& stride_out);
+
+  using I420Pool = VideoFrameBufferPool<webrtc::I420Buffer>;
+
+  /// Get a buffer of the given size from |pool|. Frames can be converted
+  /// concurrently on several threads, so the pools are accessed under
+  /// |pool_lock_|, which is only held while acquiring the buffer.
+  rtc::scoped_refptr<webrtc::I420Buffer> CreateBuffer(I420Pool& pool,
+                                                      int width,
+                                                      int height);
+
+  /// Lock serializing accesses to the buffer pools.
+  rtc::CriticalSection pool_lock_;
+
+  /// Pool of the buffers of converted frames.
+  I420Pool buffer_pool_ RTC_GUARDED_BY(pool_lock_);
+
+  /// Pool of the buffers of cropped frames converted before being scaled,
+  /// each released right after scaling, so generally a single buffer.
+  I420Pool scratch_pool_ RTC_GUARDED_BY(pool_lock_){1};
+
+  /// Whether a warning about odd frame sizes was already logged, to log it
+  /// only once per source.
+  bool has_warned_ = false;
+
+  /// Persistent frame updated with dirty regions. The buffer is held as
+  /// reference-counted object to know whether a frame still references it.
+  using PersistentBuffer = rtc::RefCountedObject<webrtc::I420Buffer>;
+  rtc::CriticalSection persistent_lock_;
+  rtc::scoped_refptr<PersistentBuffer> persistent_buffer_
+      RTC_GUARDED_BY(persistent_lock_);
+
+  /// Previous persistent buffer, reused to copy the persistent frame into
+  /// once the frame referencing it is encoded, instead of allocating.
+  rtc::scoped_refptr<PersistentBuffer> spare_buffer_
+      RTC_GUARDED_BY(persistent_lock_);
+  uint64_t persistent_version_ RTC_GUARDED_BY(persistent_lock_) = 0;
 };
 
 /// Adapter to bridge a video track source to the underlying core
@@ -35,6 +168,20 @@ class BufferAdapter {
 struct CustomTrackSourceAdapter : public rtc::AdaptedVideoTrackSource {
   void DispatchFrame(const webrtc::VideoFrame& frame) { OnFrame(frame); }
 
+  /// Compute the adaptation of a frame of the given size to the resolution and
+  /// frame rate currently wanted by the sinks, which the encoders reduce when
+  /// overusing the CPU or lacking bandwidth. Return |false| if the frame must
+  /// be dropped, either to reduce the frame rate or because no sink wants it.
+  bool AdaptFrame(int width,
+                  int height,
+                  int64_t time_us,
+                  FrameAdaptation& adaptation) {
+    return rtc::AdaptedVideoTrackSource::AdaptFrame(
+        width, height, time_us, &adaptation.width_, &adaptation.height_,
+        &adaptation.crop_width_, &adaptation.crop_height_, &adaptation.crop_x_,
+        &adaptation.crop_y_);
+  }
+
   // VideoTrackSourceInterface
   bool is_screencast() const override { return false; }
   absl::optional<bool> needs_denoising() const override {
@@ -48,6 +195,48 @@ struct CustomTrackSourceAdapter : public rtc::AdaptedVideoTrackSource {
   SourceState state_ = SourceState::kInitializing;
 };
 
+/// Video track source forwarding to a |CustomTrackSourceAdapter|, which the
+/// video tracks are created from to keep track of the wants of their sinks.
+/// |rtc::AdaptedVideoTrackSource| applies those wants to the frames, but does
+/// not expose them, while they are needed to let the external video source
+/// produce frames at the wanted resolution and frame rate in the first place.
+class SinkWantsTracker
+    : public webrtc::Notifier<webrtc::VideoTrackSourceInterface> {
+ public:
+  explicit SinkWantsTracker(
+      rtc::scoped_refptr<webrtc::VideoTrackSourceInterface> source) noexcept
+      : source_(std::move(source)) {}
+
+  /// Combined wants of all the sinks, as applied by the adapted source.
+  rtc::VideoSinkWants wants() const;
+
+  // VideoSourceInterface
+  void AddOrUpdateSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
+                       const rtc::VideoSinkWants& wants) override;
+  void RemoveSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override;
+
+  // VideoTrackSourceInterface
+  bool is_screencast() const override { return source_->is_screencast(); }
+  absl::optional<bool> needs_denoising() const override {
+    return source_->needs_denoising();
+  }
+  bool GetStats(Stats* stats) override { return source_->GetStats(stats); }
+
+  // MediaSourceInterface
+  SourceState state() const override { return source_->state(); }
+  bool remote() const override { return source_->remote(); }
+
+ private:
+  /// Adapted source, held by its interface since |rtc::AdaptedVideoTrackSource|
+  /// implements some of it privately.
+  const rtc::scoped_refptr<webrtc::VideoTrackSourceInterface> source_;
+  rtc::CriticalSection lock_;
+  std::vector<
+      std::pair<rtc::VideoSinkInterface<webrtc::VideoFrame>*,
+                rtc::VideoSinkWants>>
+      sink_wants_ RTC_GUARDED_BY(lock_);
+};
+
 /// Video track source acting as an adapter for an external source of raw
 /// frames.
 class ExternalVideoTrackSourceImpl : public ExternalVideoTrackSource,
@@ -57,14 +246,18 @@ class ExternalVideoTrackSourceImpl : public ExternalVideoTrackSource,
  public:
   using SourceState = webrtc::MediaSourceInterface::SourceState;
 
+  /// Create a new source with the given buffer adapter. Pull-mode sources
+  /// request their frames from the adapter, while push-mode sources deliver
+  /// the frames pushed with |PushFrame()|.
   static RefPtr<ExternalVideoTrackSource> create(
-      std::unique_ptr<BufferAdapter> adapter);
+      std::unique_ptr<BufferAdapter> adapter,
+      bool push_mode);
 
   ~ExternalVideoTrackSourceImpl() override;
 
   void SetName(std::string name) { name_ = std::move(name); }
-  std::string GetName() const override { return name_; }
-
+  std::string GetName() const override { return name_; }
+
   void FinishCreation() override;
 
   /// Start the video capture. This will begin to produce video frames and start
@@ -81,34 +274,171 @@ class ExternalVideoTrackSourceImpl : public ExternalVideoTrackSource,
                          int64_t timestamp_ms,
                          const Argb32VideoFrame& frame) override;
 
+  /// Complete a video frame request with a given NV12 video frame.
+  Result CompleteRequest(uint32_t request_id,
+                         int64_t timestamp_ms,
+                         const Nv12VideoFrame& frame) override;
+
+  /// Complete a video frame request with a given YUY2 video frame.
+  Result CompleteRequest(uint32_t request_id,
+                         int64_t timestamp_ms,
+                         const Yuy2VideoFrame& frame) override;
+
+  /// Complete a video frame request with a given BGR24 video frame.
+  Result CompleteRequest(uint32_t request_id,
+                         int64_t timestamp_ms,
+                         const Bgr24VideoFrame& frame) override;
+
+  /// Complete a video frame request with a given RGBA32 video frame.
+  Result CompleteRequest(uint32_t request_id,
+                         int64_t timestamp_ms,
+                         const Rgba32VideoFrame& frame) override;
+
+  /// Complete a video frame request with a given I420A video frame, without
+  /// copying it.
+  Result CompleteRequestNoCopy(uint32_t request_id,
+                               int64_t timestamp_ms,
+                               const I420AVideoFrame& frame,
+                               FrameReleaseCallback release) noexcept override;
+
+  Result PushFrame(int64_t timestamp_ms,
+                   const I420AVideoFrame& frame,
+                   bool& dropped) noexcept override;
+  Result PushFrame(int64_t timestamp_ms,
+                   const Argb32VideoFrame& frame,
+                   bool& dropped) noexcept override;
+  Result PushFrame(int64_t timestamp_ms,
+                   const Nv12VideoFrame& frame,
+                   bool& dropped) noexcept override;
+  Result PushFrame(int64_t timestamp_ms,
+                   const Yuy2VideoFrame& frame,
+                   bool& dropped) noexcept override;
+  Result PushFrame(int64_t timestamp_ms,
+                   const Bgr24VideoFrame& frame,
+                   bool& dropped) noexcept override;
+  Result PushFrame(int64_t timestamp_ms,
+                   const Rgba32VideoFrame& frame,
+                   bool& dropped) noexcept override;
+  Result PushFrameNoCopy(int64_t timestamp_ms,
+                         const I420AVideoFrame& frame,
+                         FrameReleaseCallback release,
+                         bool& dropped) noexcept override;
+  Result CompleteRequestDirty(uint32_t request_id,
+                              int64_t timestamp_ms,
+                              const Argb32VideoFrame& frame,
+                              const mrsVideoRect* dirty_rects,
+                              int dirty_rect_count) noexcept override;
+  Result PushFrameDirty(int64_t timestamp_ms,
+                        const Argb32VideoFrame& frame,
+                        const mrsVideoRect* dirty_rects,
+                        int dirty_rect_count,
+                        bool& dropped) noexcept override;
+  void SetPushDropPolicy(mrsPushFrameDropPolicy policy) noexcept override;
+
+  Result SetFrameRate(double frame_rate) noexcept override;
+  mrsWantedVideoFormat GetWantedFormat(int native_width,
+                                       int native_height) const
+      noexcept override;
+  void SetSchedulePolicy(mrsFrameSchedulePolicy policy) noexcept override;
+  void SetStaticFramePolicy(mrsStaticFramePolicy policy) noexcept override;
+
   /// Stop the video capture. This will stop producing video frames.
   void StopCapture();
 
   /// Shutdown the source and release the buffer adapter and its callback.
   void Shutdown() noexcept;
 
-  webrtc::VideoTrackSourceInterface* impl() const { return track_source_; }
+  /// Track source to create the video tracks of this source from.
+  webrtc::VideoTrackSourceInterface* impl() const { return sink_wants_; }
 
  protected:
-  ExternalVideoTrackSourceImpl(std::unique_ptr<BufferAdapter> adapter);
+  ExternalVideoTrackSourceImpl(std::unique_ptr<BufferAdapter> adapter,
+                               bool push_mode);
   // void Run(rtc::Thread* thread) override;
   void OnMessage(rtc::Message* message) override;
 
+  /// Complete a pending request with a frame, see |DeliverFrame()|.
+  template <typename FrameT, typename BufferFactory>
+  Result CompleteRequestImpl(uint32_t request_id,
+                             int64_t timestamp_ms,
+                             const FrameT& frame_view,
+                             bool can_repeat,
+                             BufferFactory&& make_buffer);
+
+  /// Same as |CompleteRequestImpl()|, with |delivery_lock_| already held and
+  /// |adapter_| checked.
+  template <typename FrameT, typename BufferFactory>
+  Result CompleteRequestLocked(uint32_t request_id,
+                               int64_t timestamp_ms,
+                               const FrameT& frame_view,
+                               bool can_repeat,
+                               BufferFactory&& make_buffer);
+
+  /// Deliver a pushed frame, see |DeliverFrame()|.
+  template <typename FrameT, typename BufferFactory>
+  Result PushFrameImpl(int64_t timestamp_ms,
+                       const FrameT& frame_view,
+                       bool can_repeat,
+                       BufferFactory&& make_buffer,
+                       bool& dropped) noexcept;
+
+  /// Adapt a frame to the wants of the sinks and deliver it with the buffer
+  /// returned by |make_buffer(adaptation)|, which is only invoked if the frame
+  /// is neither dropped nor repeated as a static frame. The buffer can only be
+  /// kept to repeat it if |can_repeat| is set. Return |false| if the frame is
+  /// dropped.
+  template <typename FrameT, typename BufferFactory>
+  bool DeliverFrame(int64_t timestamp_ms,
+                    const FrameT& frame_view,
+                    bool can_repeat,
+                    BufferFactory&& make_buffer);
+
   rtc::scoped_refptr<CustomTrackSourceAdapter> track_source_;
 
+  /// Forwarding track source exposing the wants of the sinks.
+  rtc::scoped_refptr<SinkWantsTracker> sink_wants_;
+
   std::unique_ptr<BufferAdapter> adapter_;
-  std::unique_ptr<rtc::Thread> capture_thread_;
 
-  /// Collection of pending frame requests
-  std::deque<std::pair<uint32_t, int64_t>> pending_requests_
-      RTC_GUARDED_BY(request_lock_);  //< TODO : circular buffer to avoid alloc
+  /// Thread of the shared capture thread pool the frame requests are
+  /// scheduled on while capturing, or null if not capturing.
+  rtc::Thread* capture_thread_ RTC_GUARDED_BY(request_lock_) = nullptr;
 
-  /// Next available ID for a frame request.
-  uint32_t next_request_id_ RTC_GUARDED_BY(request_lock_){};
+  /// Pending frame requests and their timestamps.
+  FrameRequestRing pending_requests_ RTC_GUARDED_BY(request_lock_);
 
-  /// Lock for frame requests.
+  /// Absolute deadlines of the frame requests.
+  FrameScheduler scheduler_ RTC_GUARDED_BY(request_lock_);
+
+  /// Lock for frame requests and their schedule.
   rtc::CriticalSection request_lock_;
 
+  /// Whether frames are pushed by the caller instead of requested.
+  const bool push_mode_;
+
+  /// Lock serializing the delivery of frames, pushed or completing requests,
+  /// with each other and with the source starting, stopping, and shutting
+  /// down. Requests can be completed concurrently from worker threads, and
+  /// this also keeps their frames in timestamp order.
+  rtc::CriticalSection delivery_lock_;
+
+  /// Timestamp of the last pushed frame delivered.
+  int64_t last_push_timestamp_ms_ RTC_GUARDED_BY(delivery_lock_) =
+      std::numeric_limits<int64_t>::min();
+
+  /// Policy for frames pushed while |delivery_lock_| is held by another
+  /// thread.
+  std::atomic<mrsPushFrameDropPolicy> push_drop_policy_{
+      mrsPushFrameDropPolicy::kDrop};
+
+  /// Policy for static frames, identical to the previous frame.
+  std::atomic<mrsStaticFramePolicy> static_frame_policy_{
+      mrsStaticFramePolicy::kNone};
+
+  /// Detector of static frames, only used if |static_frame_policy_| is not
+  /// |mrsStaticFramePolicy::kNone|.
+  StaticFrameDetector static_frame_detector_;
+
   /// Friendly track source name, for debugging.
   std::string name_;
 };
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "peer_connection.h"
+#include "remote_audio_track.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+RemoteAudioTrack::RemoteAudioTrack(
+    PeerConnection& owner,
+    rtc::scoped_refptr<webrtc::AudioTrackInterface> track,
+    rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) noexcept
+    : owner_(&owner), track_(std::move(track)), receiver_(std::move(receiver)) {
+  RTC_CHECK(owner_);
+  track_->AddSink(this);
+}
+
+RemoteAudioTrack::~RemoteAudioTrack() {
+  if (owner_) {
+    track_->RemoveSink(this);
+  }
+}
+
+std::string RemoteAudioTrack::GetName() const noexcept {
+  return track_->id();
+}
+
+webrtc::AudioTrackInterface* RemoteAudioTrack::impl() const {
+  return track_.get();
+}
+
+webrtc::RtpReceiverInterface* RemoteAudioTrack::receiver() const {
+  return receiver_.get();
+}
+
+void RemoteAudioTrack::OnTrackRemoved() noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  if (owner_) {
+    // This blocks until any in-progress frame delivery returned.
+    track_->RemoveSink(this);
+    owner_ = nullptr;
+  }
+}
+
+}  // namespace Microsoft::MixedReality::WebRTC
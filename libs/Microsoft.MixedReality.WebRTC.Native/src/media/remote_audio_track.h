@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+#include "audio_frame_observer.h"
+#include "callback.h"
+#include "interop_api.h"
+#include "str.h"
+#include "tracked_object.h"
+
+namespace rtc {
+template <typename T>
+class scoped_refptr;
+}
+
+namespace webrtc {
+class AudioTrackInterface;
+class RtpReceiverInterface;
+}  // namespace webrtc
+
+namespace Microsoft::MixedReality::WebRTC {
+
+class PeerConnection;
+
+/// A remote audio track is a media track for a peer connection reflecting an
+/// audio track sent by the remote peer.
+///
+/// Each remote audio track is its own frame observer, with its own callback,
+/// so that audio from multiple remote tracks, typically from multiple
+/// participants, can be consumed separately instead of being interleaved. The
+/// track is created by the peer connection when the remote peer adds it, and
+/// exposed to the user through the remote audio track added callback. It is
+/// detached from the peer connection when the remote peer removes it, but
+/// remains valid as long as a reference to it is held.
+class RemoteAudioTrack : public AudioFrameObserver, public TrackedObject {
+ public:
+  RemoteAudioTrack(
+      PeerConnection& owner,
+      rtc::scoped_refptr<webrtc::AudioTrackInterface> track,
+      rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) noexcept;
+  ~RemoteAudioTrack() override;
+
+  /// Get the name of the remote audio track, which is its track ID.
+  std::string GetName() const noexcept override;
+
+  //
+  // Advanced use
+  //
+
+  [[nodiscard]] webrtc::AudioTrackInterface* impl() const;
+  [[nodiscard]] webrtc::RtpReceiverInterface* receiver() const;
+
+  /// Detach the track from its peer connection after the remote peer removed
+  /// it. Frames are not delivered anymore after this call returns.
+  void OnTrackRemoved() noexcept;
+
+ private:
+  /// Weak reference to the PeerConnection object owning this track, or
+  /// |nullptr| once removed.
+  PeerConnection* owner_ RTC_GUARDED_BY(mutex_) = nullptr;
+
+  /// Mutex serializing the removal of the track with its destruction.
+  std::mutex mutex_;
+
+  /// Underlying core implementation.
+  rtc::scoped_refptr<webrtc::AudioTrackInterface> track_;
+
+  /// RTP receiver this track is associated with.
+  rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver_;
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
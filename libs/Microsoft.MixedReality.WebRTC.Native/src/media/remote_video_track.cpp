@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "peer_connection.h"
+#include "remote_video_track.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+RemoteVideoTrack::RemoteVideoTrack(
+    PeerConnection& owner,
+    rtc::scoped_refptr<webrtc::VideoTrackInterface> track,
+    rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) noexcept
+    : owner_(&owner), track_(std::move(track)), receiver_(std::move(receiver)) {
+  RTC_CHECK(owner_);
+  track_->AddOrUpdateSink(this, GetSinkWants());
+}
+
+RemoteVideoTrack::~RemoteVideoTrack() {
+  if (owner_) {
+    track_->RemoveSink(this);
+  }
+}
+
+std::string RemoteVideoTrack::GetName() const noexcept {
+  return track_->id();
+}
+
+Result RemoteVideoTrack::SetFrameTargetSize(VideoFrameFormat format,
+                                            int width,
+                                            int height) noexcept {
+  const Result result = SetCallbackTargetSize(format, width, height);
+  if (result == Result::kSuccess) {
+    UpdateSinkWants();
+  }
+  return result;
+}
+
+void RemoteVideoTrack::UpdateSinkWants() noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  if (owner_) {
+    track_->AddOrUpdateSink(this, GetSinkWants());
+  }
+}
+
+webrtc::VideoTrackInterface* RemoteVideoTrack::impl() const {
+  return track_.get();
+}
+
+webrtc::RtpReceiverInterface* RemoteVideoTrack::receiver() const {
+  return receiver_.get();
+}
+
+void RemoteVideoTrack::OnTrackRemoved() noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  if (owner_) {
+    // This blocks until any in-progress frame delivery returned.
+    track_->RemoveSink(this);
+    owner_ = nullptr;
+  }
+}
+
+}  // namespace Microsoft::MixedReality::WebRTC
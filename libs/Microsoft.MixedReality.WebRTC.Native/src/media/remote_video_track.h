@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+#include "callback.h"
+#include "interop_api.h"
+#include "str.h"
+#include "tracked_object.h"
+#include "video_frame_observer.h"
+
+namespace rtc {
+template <typename T>
+class scoped_refptr;
+}
+
+namespace webrtc {
+class RtpReceiverInterface;
+class VideoTrackInterface;
+}  // namespace webrtc
+
+namespace Microsoft::MixedReality::WebRTC {
+
+class PeerConnection;
+
+/// A remote video track is a media track for a peer connection reflecting a
+/// video track sent by the remote peer.
+///
+/// Each remote video track is its own frame observer, with its own callbacks,
+/// output formats, target sizes, and delivery mode, so that frames from
+/// multiple remote tracks can be consumed separately. The track is created by
+/// the peer connection when the remote peer adds it, and exposed to the user
+/// through the remote video track added callback. It is detached from the
+/// peer connection when the remote peer removes it, but remains valid as long
+/// as a reference to it is held.
+class RemoteVideoTrack : public VideoFrameObserver, public TrackedObject {
+ public:
+  RemoteVideoTrack(
+      PeerConnection& owner,
+      rtc::scoped_refptr<webrtc::VideoTrackInterface> track,
+      rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) noexcept;
+  ~RemoteVideoTrack() override;
+
+  /// Get the name of the remote video track, which is its track ID.
+  std::string GetName() const noexcept override;
+
+  /// Same as |VideoFrameObserver::SetCallbackTargetSize()|, additionally
+  /// updating the sink wants of the track.
+  Result SetFrameTargetSize(VideoFrameFormat format,
+                            int width,
+                            int height) noexcept;
+
+  /// Update the sink wants of this observer on the underlying track, after
+  /// its callbacks or their target sizes changed.
+  void UpdateSinkWants() noexcept;
+
+  //
+  // Advanced use
+  //
+
+  [[nodiscard]] webrtc::VideoTrackInterface* impl() const;
+  [[nodiscard]] webrtc::RtpReceiverInterface* receiver() const;
+
+  /// Detach the track from its peer connection after the remote peer removed
+  /// it. Frames are not delivered anymore after this call returns.
+  void OnTrackRemoved() noexcept;
+
+ private:
+  /// Weak reference to the PeerConnection object owning this track, or
+  /// |nullptr| once removed.
+  PeerConnection* owner_ RTC_GUARDED_BY(mutex_) = nullptr;
+
+  /// Mutex serializing sink updates with the removal of the track.
+  std::mutex mutex_;
+
+  /// Underlying core implementation.
+  rtc::scoped_refptr<webrtc::VideoTrackInterface> track_;
+
+  /// RTP receiver this track is associated with.
+  rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver_;
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// This is a precompiled header, it must be on its own, followed by a blank
+// line, to prevent clang-format from reordering it with other headers.
+#include "pch.h"
+
+#include "media/static_frame_detector.h"
+
+namespace {
+
+/// Hash the visible bytes of the rows of a plane, in a single pass if the rows
+/// are contiguous. Since the hash of each row continues from the previous one,
+/// both ways give the same hash.
+uint32_t HashPlane(const void* data,
+                   int32_t stride,
+                   size_t row_size,
+                   uint32_t row_count,
+                   uint32_t seed) {
+  const uint8_t* row = (const uint8_t*)data;
+  if ((size_t)stride == row_size) {
+    return libyuv::HashDjb2(row, (uint64_t)row_size * row_count, seed);
+  }
+  for (uint32_t j = 0; j < row_count; ++j) {
+    seed = libyuv::HashDjb2(row, row_size, seed);
+    row += stride;
+  }
+  return seed;
+}
+
+/// Tags of the frame encodings, so that frames of different encodings never
+/// share a key.
+enum FrameEncodingTag : uint32_t {
+  kI420ATag = 1,
+  kArgb32Tag,
+  kNv12Tag,
+  kYuy2Tag,
+  kBgr24Tag,
+  kRgba32Tag,
+};
+
+/// Hash the encoding and size of a frame, continuing from |seed|.
+uint32_t HashHeader(FrameEncodingTag tag,
+                    uint32_t width,
+                    uint32_t height,
+                    uint32_t seed) {
+  const uint32_t header[3]{tag, width, height};
+  return libyuv::HashDjb2((const uint8_t*)header, sizeof(header), seed);
+}
+
+}  // namespace
+
+namespace Microsoft::MixedReality::WebRTC {
+
+uint32_t StaticFrameDetector::HashBytes(const void* data,
+                                        size_t size,
+                                        uint32_t seed) {
+  return libyuv::HashDjb2((const uint8_t*)data, size, seed);
+}
+
+uint32_t StaticFrameDetector::HashFrame(const I420AVideoFrame& frame,
+                                        uint32_t seed) {
+  const uint32_t chroma_width = (frame.width_ + 1) / 2;
+  const uint32_t chroma_height = (frame.height_ + 1) / 2;
+  seed = HashHeader(kI420ATag, frame.width_, frame.height_, seed);
+  seed = HashPlane(frame.ydata_, frame.ystride_, frame.width_, frame.height_,
+                   seed);
+  seed = HashPlane(frame.udata_, frame.ustride_, chroma_width, chroma_height,
+                   seed);
+  return HashPlane(frame.vdata_, frame.vstride_, chroma_width, chroma_height,
+                   seed);
+}
+
+uint32_t StaticFrameDetector::HashFrame(const Argb32VideoFrame& frame,
+                                        uint32_t seed) {
+  seed = HashHeader(kArgb32Tag, frame.width_, frame.height_, seed);
+  return HashPlane(frame.argb32_data_, frame.stride_, frame.width_ * 4,
+                   frame.height_, seed);
+}
+
+uint32_t StaticFrameDetector::HashFrame(const Nv12VideoFrame& frame,
+                                        uint32_t seed) {
+  seed = HashHeader(kNv12Tag, frame.width_, frame.height_, seed);
+  seed = HashPlane(frame.ydata_, frame.ystride_, frame.width_, frame.height_,
+                   seed);
+  return HashPlane(frame.uvdata_, frame.uvstride_, ((frame.width_ + 1) / 2) * 2,
+                   (frame.height_ + 1) / 2, seed);
+}
+
+uint32_t StaticFrameDetector::HashFrame(const Yuy2VideoFrame& frame,
+                                        uint32_t seed) {
+  seed = HashHeader(kYuy2Tag, frame.width_, frame.height_, seed);
+  return HashPlane(frame.yuy2_data_, frame.stride_,
+                   ((frame.width_ + 1) / 2) * 4, frame.height_, seed);
+}
+
+uint32_t StaticFrameDetector::HashFrame(const Bgr24VideoFrame& frame,
+                                        uint32_t seed) {
+  seed = HashHeader(kBgr24Tag, frame.width_, frame.height_, seed);
+  return HashPlane(frame.bgr24_data_, frame.stride_, frame.width_ * 3,
+                   frame.height_, seed);
+}
+
+uint32_t StaticFrameDetector::HashFrame(const Rgba32VideoFrame& frame,
+                                        uint32_t seed) {
+  seed = HashHeader(kRgba32Tag, frame.width_, frame.height_, seed);
+  return HashPlane(frame.rgba32_data_, frame.stride_, frame.width_ * 4,
+                   frame.height_, seed);
+}
+
+bool StaticFrameDetector::FindRepeat(
+    uint32_t key,
+    int64_t timestamp_ms,
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer>& buffer) {
+  rtc::CritScope lock(&lock_);
+  if (!has_frame_ || (key != key_) ||
+      (timestamp_ms - refresh_timestamp_ms_ >= kRefreshIntervalMs)) {
+    return false;
+  }
+  buffer = buffer_;
+  return true;
+}
+
+void StaticFrameDetector::Update(
+    uint32_t key,
+    int64_t timestamp_ms,
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer) {
+  rtc::CritScope lock(&lock_);
+  has_frame_ = true;
+  key_ = key;
+  refresh_timestamp_ms_ = timestamp_ms;
+  buffer_ = std::move(buffer);
+}
+
+void StaticFrameDetector::Reset() {
+  rtc::CritScope lock(&lock_);
+  has_frame_ = false;
+  buffer_ = nullptr;
+}
+
+}  // namespace Microsoft::MixedReality::WebRTC
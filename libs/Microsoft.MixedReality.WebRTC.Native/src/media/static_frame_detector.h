@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+#include "video_frame.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Detector of static frames, which have the same key as the previous frame
+/// of a source, to avoid converting and encoding them again. The key of a
+/// frame is a vectorized hash of its encoding, size, and visible pixels,
+/// which is much cheaper than converting the frame, and does not need a copy
+/// of the previous frame to compare with.
+///
+/// Since different frames can have the same hash, a static frame is only
+/// detected for up to |kRefreshIntervalMs| after the last frame actually
+/// converted, which bounds how long a hash collision can freeze the video.
+/// This class is thread-safe.
+class StaticFrameDetector {
+ public:
+  /// Maximum interval between two frames actually converted, even if static.
+  static constexpr int64_t kRefreshIntervalMs = 1000;
+
+  /// Initial seed of the djb2 hash used for the keys.
+  static constexpr uint32_t kHashSeed = 5381;
+
+  /// Compute the hash of some raw memory, continuing from |seed|.
+  static uint32_t HashBytes(const void* data, size_t size, uint32_t seed);
+
+  /// Compute the hash of the visible pixels of a frame, continuing from
+  /// |seed|. The alpha plane of I420A frames, if any, is ignored.
+  static uint32_t HashFrame(const I420AVideoFrame& frame, uint32_t seed);
+  static uint32_t HashFrame(const Argb32VideoFrame& frame, uint32_t seed);
+  static uint32_t HashFrame(const Nv12VideoFrame& frame, uint32_t seed);
+  static uint32_t HashFrame(const Yuy2VideoFrame& frame, uint32_t seed);
+  static uint32_t HashFrame(const Bgr24VideoFrame& frame, uint32_t seed);
+  static uint32_t HashFrame(const Rgba32VideoFrame& frame, uint32_t seed);
+
+  /// Check whether a frame with the given key and timestamp repeats the last
+  /// frame recorded with |Update()|. If so, |buffer| is set to the buffer
+  /// recorded with that frame, if any.
+  bool FindRepeat(uint32_t key,
+                  int64_t timestamp_ms,
+                  rtc::scoped_refptr<webrtc::VideoFrameBuffer>& buffer);
+
+  /// Record the last frame converted, optionally with its buffer to send again
+  /// in place of the next static frames.
+  void Update(uint32_t key,
+              int64_t timestamp_ms,
+              rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer);
+
+  /// Forget the last frame, and release its buffer if any.
+  void Reset();
+
+ private:
+  rtc::CriticalSection lock_;
+  bool has_frame_ RTC_GUARDED_BY(lock_) = false;
+  uint32_t key_ RTC_GUARDED_BY(lock_) = 0;
+  int64_t refresh_timestamp_ms_ RTC_GUARDED_BY(lock_) = 0;
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
@@ -5,10 +5,15 @@
 // line, to prevent clang-format from reordering it with other headers.
 #include "pch.h"
 
+#include "audio_conversion.h"
 #include "audio_frame_observer.h"
+#include "common_audio/resampler/include/push_resampler.h"
 #include "common_audio/resampler/include/resampler.h"
 #include "data_channel.h"
+#include "media/external_video_track_source_impl.h"
 #include "media/local_video_track.h"
+#include "media/remote_audio_track.h"
+#include "media/remote_video_track.h"
 #include "peer_connection.h"
 #include "sdp_utils.h"
 #include "video_frame_observer.h"
@@ -485,10 +490,35 @@ class PeerConnectionImpl : public PeerConnection,
     track_removed_callback_ = std::move(callback);
   }
 
+  void RegisterRemoteVideoTrackAddedCallback(
+      RemoteVideoTrackAddedCallback&& callback) noexcept override {
+    auto lock = std::scoped_lock{track_added_callback_mutex_};
+    remote_video_track_added_callback_ = std::move(callback);
+  }
+
+  void RegisterRemoteVideoTrackRemovedCallback(
+      RemoteVideoTrackRemovedCallback&& callback) noexcept override {
+    auto lock = std::scoped_lock{track_removed_callback_mutex_};
+    remote_video_track_removed_callback_ = std::move(callback);
+  }
+
+  void RegisterRemoteAudioTrackAddedCallback(
+      RemoteAudioTrackAddedCallback&& callback) noexcept override {
+    auto lock = std::scoped_lock{track_added_callback_mutex_};
+    remote_audio_track_added_callback_ = std::move(callback);
+  }
+
+  void RegisterRemoteAudioTrackRemovedCallback(
+      RemoteAudioTrackRemovedCallback&& callback) noexcept override {
+    auto lock = std::scoped_lock{track_removed_callback_mutex_};
+    remote_audio_track_removed_callback_ = std::move(callback);
+  }
+
   void RegisterRemoteVideoFrameCallback(
       I420AFrameReadyCallback callback) noexcept override {
     if (remote_video_observer_) {
       remote_video_observer_->SetCallback(std::move(callback));
+      UpdateRemoteVideoSinkWants();
     }
   }
 
@@ -496,9 +526,93 @@ class PeerConnectionImpl : public PeerConnection,
       Argb32FrameReadyCallback callback) noexcept override {
     if (remote_video_observer_) {
       remote_video_observer_->SetCallback(std::move(callback));
+      UpdateRemoteVideoSinkWants();
     }
   }
 
+  void RegisterRemoteVideoFrameCallback(
+      Nv12FrameReadyCallback callback) noexcept override {
+    if (remote_video_observer_) {
+      remote_video_observer_->SetCallback(std::move(callback));
+      UpdateRemoteVideoSinkWants();
+    }
+  }
+
+  void RegisterRemoteVideoFrameCallback(
+      Rgba32FrameReadyCallback callback) noexcept override {
+    if (remote_video_observer_) {
+      remote_video_observer_->SetCallback(std::move(callback));
+      UpdateRemoteVideoSinkWants();
+    }
+  }
+
+  void RegisterRemoteVideoFrameCallback(
+      Bgr24FrameReadyCallback callback) noexcept override {
+    if (remote_video_observer_) {
+      remote_video_observer_->SetCallback(std::move(callback));
+      UpdateRemoteVideoSinkWants();
+    }
+  }
+
+  void RegisterRemoteVideoFrameCallback(
+      I420PackedFrameReadyCallback callback) noexcept override {
+    if (remote_video_observer_) {
+      remote_video_observer_->SetCallback(std::move(callback));
+      UpdateRemoteVideoSinkWants();
+    }
+  }
+
+  void SetRemoteVideoConversionParallelism(
+      int max_parallelism) noexcept override {
+    if (remote_video_observer_) {
+      remote_video_observer_->SetConversionParallelism(max_parallelism);
+    }
+  }
+
+  Result SetRemoteVideoFrameTargetSize(VideoFrameFormat format,
+                                       int width,
+                                       int height) noexcept override {
+    if (!remote_video_observer_) {
+      return Result::kInvalidOperation;
+    }
+    const Result result =
+        remote_video_observer_->SetCallbackTargetSize(format, width, height);
+    if (result == Result::kSuccess) {
+      UpdateRemoteVideoSinkWants();
+    }
+    return result;
+  }
+
+  void SetRemoteVideoDeliveryMode(
+      VideoFrameDeliveryMode mode) noexcept override {
+    if (remote_video_observer_) {
+      remote_video_observer_->SetDeliveryMode(mode);
+    }
+  }
+
+  bool PollRemoteVideoFrame() noexcept override {
+    return (remote_video_observer_ && remote_video_observer_->PollFrame());
+  }
+
+  Result SetRemoteVideoArgb32Destinations(void* const* buffers,
+                                          int count,
+                                          uint64_t size,
+                                          int stride) noexcept override {
+    if (!remote_video_observer_) {
+      return Result::kInvalidOperation;
+    }
+    return remote_video_observer_->SetArgb32Destinations(buffers, count, size,
+                                                         stride);
+  }
+
+  Result ReleaseRemoteVideoArgb32Destination(
+      const void* buffer) noexcept override {
+    if (!remote_video_observer_) {
+      return Result::kInvalidOperation;
+    }
+    return remote_video_observer_->ReleaseArgb32Destination(buffer);
+  }
+
   ErrorOr<RefPtr<LocalVideoTrack>> AddLocalVideoTrack(
       rtc::scoped_refptr<webrtc::VideoTrackInterface>
           video_track) noexcept override;
@@ -676,6 +790,22 @@ class PeerConnectionImpl : public PeerConnection,
   TrackRemovedCallback track_removed_callback_
       RTC_GUARDED_BY(track_removed_callback_mutex_);
 
+  /// User callback invoked when a remote video track is added.
+  RemoteVideoTrackAddedCallback remote_video_track_added_callback_
+      RTC_GUARDED_BY(track_added_callback_mutex_);
+
+  /// User callback invoked when a remote video track is removed.
+  RemoteVideoTrackRemovedCallback remote_video_track_removed_callback_
+      RTC_GUARDED_BY(track_removed_callback_mutex_);
+
+  /// User callback invoked when a remote audio track is added.
+  RemoteAudioTrackAddedCallback remote_audio_track_added_callback_
+      RTC_GUARDED_BY(track_added_callback_mutex_);
+
+  /// User callback invoked when a remote audio track is removed.
+  RemoteAudioTrackRemovedCallback remote_audio_track_removed_callback_
+      RTC_GUARDED_BY(track_removed_callback_mutex_);
+
   std::mutex data_channel_added_callback_mutex_;
   std::mutex data_channel_removed_callback_mutex_;
   std::mutex connected_callback_mutex_;
@@ -696,6 +826,18 @@ class PeerConnectionImpl : public PeerConnection,
   std::vector<RefPtr<LocalVideoTrack>> local_video_tracks_
       RTC_GUARDED_BY(tracks_mutex_);
 
+  /// Collection of all remote video tracks associated with this peer
+  /// connection. The legacy remote video observer is also a sink of all of
+  /// them.
+  std::vector<RefPtr<RemoteVideoTrack>> remote_video_tracks_
+      RTC_GUARDED_BY(tracks_mutex_);
+
+  /// Collection of all remote audio tracks associated with this peer
+  /// connection. The legacy remote audio observer is also a sink of all of
+  /// them, and receives their frames interleaved.
+  std::vector<RefPtr<RemoteAudioTrack>> remote_audio_tracks_
+      RTC_GUARDED_BY(tracks_mutex_);
+
   /// Mutex for all collections of all tracks.
   rtc::CriticalSection tracks_mutex_;
 
@@ -722,6 +864,18 @@ class PeerConnectionImpl : public PeerConnection,
   std::unique_ptr<AudioFrameObserver> remote_audio_observer_;
   std::unique_ptr<VideoFrameObserver> remote_video_observer_;
 
+  /// Update the sink wants of the remote video observer on all remote video
+  /// tracks, after its callbacks or their target sizes changed.
+  void UpdateRemoteVideoSinkWants() noexcept;
+
+  /// Detach a remote video track removed from the connection, and invoke the
+  /// RemoteVideoTrackRemoved callback.
+  void OnRemoteVideoTrackRemoved(RemoteVideoTrack& track) noexcept;
+
+  /// Detach a remote audio track removed from the connection, and invoke the
+  /// RemoteAudioTrackRemoved callback.
+  void OnRemoteAudioTrackRemoved(RemoteAudioTrack& track) noexcept;
+
   /// Flag to indicate if SCTP was negotiated during the initial SDP handshake
   /// (m=application), which allows subsequently to use data channels. If this
   /// is false then data channels will never connnect. This is set to true if a
@@ -891,28 +1045,22 @@ webrtc::RTCError PeerConnectionImpl::RemoveLocalVideoTrack(
 
 void PeerConnectionImpl::RemoveLocalVideoTracksFromSource(
     ExternalVideoTrackSource& source) noexcept {
-  if (!peer_) {
-    return;
-  }
-  // Remove all tracks which share this video track source.
-  // Currently there is no support for source sharing, so this should
-  // amount to a single track.
-  std::vector<rtc::scoped_refptr<webrtc::RtpSenderInterface>> senders =
-      peer_->GetSenders();
-  for (auto&& sender : senders) {
-    rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track =
-        sender->track();
-    // Apparently track can be null if destroyed already
-    //< FIXME - Is this an error?
-    if (!track ||
-        (track->kind() != webrtc::MediaStreamTrackInterface::kVideoKind)) {
+  // The same source can feed tracks on several peer connections; only remove
+  // the tracks of this peer connection, and leave the source running.
+  webrtc::VideoTrackSourceInterface* const track_source =
+      static_cast<detail::ExternalVideoTrackSourceImpl&>(source).impl();
+  rtc::CritScope lock(&tracks_mutex_);
+  auto it = local_video_tracks_.begin();
+  while (it != local_video_tracks_.end()) {
+    LocalVideoTrack& video_track = **it;
+    if (video_track.impl()->GetSource() != track_source) {
+      ++it;
       continue;
     }
-    auto video_track = (webrtc::VideoTrackInterface*)track.get();
-    if (video_track->GetSource() ==
-        (webrtc::VideoTrackSourceInterface*)&source) {
-      peer_->RemoveTrack(sender);
+    if (peer_) {
+      video_track.RemoveFromPeerConnection(*peer_);
     }
+    it = local_video_tracks_.erase(it);
   }
 }
 
@@ -1231,6 +1379,26 @@ void PeerConnectionImpl::Close() noexcept {
     }
   }
   remote_streams_.clear();
+  {
+    std::vector<RefPtr<RemoteVideoTrack>> remote_video_tracks;
+    {
+      rtc::CritScope lock(&tracks_mutex_);
+      remote_video_tracks.swap(remote_video_tracks_);
+    }
+    for (auto&& track : remote_video_tracks) {
+      OnRemoteVideoTrackRemoved(*track);
+    }
+  }
+  {
+    std::vector<RefPtr<RemoteAudioTrack>> remote_audio_tracks;
+    {
+      rtc::CritScope lock(&tracks_mutex_);
+      remote_audio_tracks.swap(remote_audio_tracks_);
+    }
+    for (auto&& track : remote_audio_tracks) {
+      OnRemoteAudioTrackRemoved(*track);
+    }
+  }
 
   RemoveAllDataChannels();
 
@@ -1482,18 +1650,51 @@ void PeerConnectionImpl::OnAddTrack(
   const std::string& trackKindStr = track->kind();
   if (trackKindStr == webrtc::MediaStreamTrackInterface::kAudioKind) {
     trackKind = TrackKind::kAudioTrack;
+    rtc::scoped_refptr<webrtc::AudioTrackInterface> audio_track(
+        static_cast<webrtc::AudioTrackInterface*>(track.get()));
     if (auto* sink = remote_audio_observer_.get()) {
-      auto audio_track = static_cast<webrtc::AudioTrackInterface*>(track.get());
       audio_track->AddSink(sink);
     }
+
+    // Create a dedicated observer for the track, to allow receiving its frames
+    // separately from other remote audio tracks.
+    RefPtr<RemoteAudioTrack> remote_track =
+        new RemoteAudioTrack(*this, audio_track, receiver);
+    {
+      rtc::CritScope lock(&tracks_mutex_);
+      remote_audio_tracks_.push_back(remote_track);
+    }
+    {
+      auto lock = std::scoped_lock{track_added_callback_mutex_};
+      auto cb = remote_audio_track_added_callback_;
+      if (cb) {
+        const std::string track_id = remote_track->GetName();
+        cb(remote_track.get(), track_id.c_str());
+      }
+    }
   } else if (trackKindStr == webrtc::MediaStreamTrackInterface::kVideoKind) {
     trackKind = TrackKind::kVideoTrack;
+    rtc::scoped_refptr<webrtc::VideoTrackInterface> video_track(
+        static_cast<webrtc::VideoTrackInterface*>(track.get()));
     if (auto* sink = remote_video_observer_.get()) {
-      rtc::VideoSinkWants sink_settings{};
-      sink_settings.rotation_applied =
-          true;  // no exposed API for caller to handle rotation
-      auto video_track = static_cast<webrtc::VideoTrackInterface*>(track.get());
-      video_track->AddOrUpdateSink(sink, sink_settings);
+      video_track->AddOrUpdateSink(sink, sink->GetSinkWants());
+    }
+
+    // Create a dedicated observer for the track, to allow receiving its frames
+    // separately from other remote video tracks.
+    RefPtr<RemoteVideoTrack> remote_track =
+        new RemoteVideoTrack(*this, video_track, receiver);
+    {
+      rtc::CritScope lock(&tracks_mutex_);
+      remote_video_tracks_.push_back(remote_track);
+    }
+    {
+      auto lock = std::scoped_lock{track_added_callback_mutex_};
+      auto cb = remote_video_track_added_callback_;
+      if (cb) {
+        const std::string track_id = remote_track->GetName();
+        cb(remote_track.get(), track_id.c_str());
+      }
     }
   } else {
     return;
@@ -1509,6 +1710,46 @@ void PeerConnectionImpl::OnAddTrack(
   }
 }
 
+void PeerConnectionImpl::UpdateRemoteVideoSinkWants() noexcept {
+  VideoFrameObserver* const sink = remote_video_observer_.get();
+  if (!sink) {
+    return;
+  }
+  const rtc::VideoSinkWants wants = sink->GetSinkWants();
+  // Copy the track list to avoid holding the lock while the calls are proxied
+  // to the worker thread.
+  std::vector<RefPtr<RemoteVideoTrack>> tracks;
+  {
+    rtc::CritScope lock(&tracks_mutex_);
+    tracks = remote_video_tracks_;
+  }
+  for (auto&& track : tracks) {
+    track->impl()->AddOrUpdateSink(sink, wants);
+  }
+}
+
+void PeerConnectionImpl::OnRemoteVideoTrackRemoved(
+    RemoteVideoTrack& track) noexcept {
+  track.OnTrackRemoved();
+  auto lock = std::scoped_lock{track_removed_callback_mutex_};
+  auto cb = remote_video_track_removed_callback_;
+  if (cb) {
+    const std::string track_id = track.GetName();
+    cb(&track, track_id.c_str());
+  }
+}
+
+void PeerConnectionImpl::OnRemoteAudioTrackRemoved(
+    RemoteAudioTrack& track) noexcept {
+  track.OnTrackRemoved();
+  auto lock = std::scoped_lock{track_removed_callback_mutex_};
+  auto cb = remote_audio_track_removed_callback_;
+  if (cb) {
+    const std::string track_id = track.GetName();
+    cb(&track, track_id.c_str());
+  }
+}
+
 void PeerConnectionImpl::OnRemoveTrack(
     rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) noexcept {
   RTC_LOG(LS_INFO) << "Removed track #" << receiver->id() << " of type "
@@ -1529,12 +1770,44 @@ void PeerConnectionImpl::OnRemoveTrack(
       auto audio_track = static_cast<webrtc::AudioTrackInterface*>(track.get());
       audio_track->RemoveSink(sink);
     }
+    RefPtr<RemoteAudioTrack> remote_track;
+    {
+      rtc::CritScope lock(&tracks_mutex_);
+      auto it = std::find_if(remote_audio_tracks_.begin(),
+                             remote_audio_tracks_.end(),
+                             [&track](const RefPtr<RemoteAudioTrack>& rt) {
+                               return (rt->impl() == track.get());
+                             });
+      if (it != remote_audio_tracks_.end()) {
+        remote_track = std::move(*it);
+        remote_audio_tracks_.erase(it);
+      }
+    }
+    if (remote_track) {
+      OnRemoteAudioTrackRemoved(*remote_track);
+    }
   } else if (trackKindStr == webrtc::MediaStreamTrackInterface::kVideoKind) {
     trackKind = TrackKind::kVideoTrack;
     if (auto* sink = remote_video_observer_.get()) {
       auto video_track = static_cast<webrtc::VideoTrackInterface*>(track.get());
       video_track->RemoveSink(sink);
     }
+    RefPtr<RemoteVideoTrack> remote_track;
+    {
+      rtc::CritScope lock(&tracks_mutex_);
+      auto it = std::find_if(remote_video_tracks_.begin(),
+                             remote_video_tracks_.end(),
+                             [&track](const RefPtr<RemoteVideoTrack>& rt) {
+                               return (rt->impl() == track.get());
+                             });
+      if (it != remote_video_tracks_.end()) {
+        remote_track = std::move(*it);
+        remote_video_tracks_.erase(it);
+      }
+    }
+    if (remote_track) {
+      OnRemoteVideoTrackRemoved(*remote_track);
+    }
   } else {
     return;
   }
@@ -1649,28 +1922,34 @@ void PeerConnection::GetStats(webrtc::RTCStatsCollectorCallback* callback) {
   ((PeerConnectionImpl*)this)->peer_->GetStats(callback);
 }
 
+namespace {
+
+// Largest frame buffered by AudioReadStream: 10ms of 48kHz stereo audio.
+constexpr uint32_t kMaxAudioSamplesPerFrame = 48000 / 100 * 2;
+
+// Buffer duration of AudioReadStream when none is specified. The drift
+// compensation keeps the buffer half full, so this leaves 30ms of margin on
+// each side for the jitter of WebRTC and of the reader, without adding more
+// latency than needed.
+constexpr int kDefaultAudioBufferMs = 60;
+
+// Number of 10ms frames buffered for a buffer duration.
+uint32_t GetMaxBufferedFrames(int bufferMs) {
+  return (uint32_t)std::max(bufferMs / 10, 1);
+}
+
+}  // namespace
+
 void AudioReadStream::audioFrameCallback(const void* audio_data,
                                          const uint32_t bits_per_sample,
                                          const uint32_t sample_rate,
                                          const uint32_t number_of_channels,
                                          const uint32_t number_of_frames) {
-  std::lock_guard<std::mutex> lock(frames_mutex_);
-  // maintain buffering limits, after adding this frame
-  const size_t maxFrames = std::max(buffer_ms_ / 10, 1);
-  while (frames_.size() > maxFrames) {
-    frames_.pop_front();
-  }
-  // add the new frame
-  auto& frame = frames_.emplace_back();
-  frame.bits_per_sample = bits_per_sample;
-  frame.sample_rate = sample_rate;
-  frame.number_of_channels = number_of_channels;
-  frame.number_of_frames = number_of_frames;
-  size_t size =
-      (size_t)(bits_per_sample / 8) * number_of_channels * number_of_frames;
-  auto src_bytes = static_cast<const std::byte*>(audio_data);
-  frame.audio_data.insert(frame.audio_data.begin(), src_bytes,
-                          src_bytes + size);
+  // This runs on the real-time audio thread, so never blocks. If the ring is
+  // full because Read() is late, the frame is dropped. Otherwise Read()
+  // maintains the buffering limits by dropping the oldest frames.
+  frames_.Write(audio_data, bits_per_sample, sample_rate, number_of_channels,
+                number_of_frames);
 }
 
 void AudioReadStream::staticAudioFrameCallback(void* user_data,
@@ -1681,108 +1960,140 @@ void AudioReadStream::staticAudioFrameCallback(void* user_data,
                           frame.sample_count_);
 }
 
-AudioReadStream::AudioReadStream(PeerConnection* peer, int bufferMs)
+AudioReadStream::AudioReadStream(PeerConnection* peer,
+                                 int bufferMs,
+                                 mrsAudioResampleMode resampleMode)
     : peer_(peer),
-      buffer_ms_(bufferMs >= 10 ? bufferMs : 500 /*TODO good value?*/) {
+      buffer_ms_(bufferMs >= 10 ? bufferMs : kDefaultAudioBufferMs),
+      // Leave room for Read() to be late before dropping the newest frames.
+      frames_(GetMaxBufferedFrames(buffer_ms_) * 2, kMaxAudioSamplesPerFrame) {
+  buffer_.resample_mode_ = resampleMode;
   peer->RegisterRemoteAudioFrameCallback(
       AudioFrameReadyCallback{&staticAudioFrameCallback, this});
 }
 
+AudioReadStream::AudioReadStream(RemoteAudioTrack& track,
+                                 int bufferMs,
+                                 mrsAudioResampleMode resampleMode)
+    : track_(&track),
+      buffer_ms_(bufferMs >= 10 ? bufferMs : kDefaultAudioBufferMs),
+      frames_(GetMaxBufferedFrames(buffer_ms_) * 2, kMaxAudioSamplesPerFrame) {
+  buffer_.resample_mode_ = resampleMode;
+  // Frames are delivered by the track directly, without going through the
+  // connection-wide observer shared with the other remote tracks.
+  track_->SetCallback(AudioFrameReadyCallback{&staticAudioFrameCallback, this});
+}
+
 AudioReadStream::~AudioReadStream() {
-  peer_->RegisterRemoteAudioFrameCallback(AudioFrameReadyCallback{});
+  // This blocks until any in-progress frame delivery returned.
+  if (track_) {
+    // Another stream or the application may have replaced the callback of
+    // the track since this stream was created, so only unregister this one.
+    track_->ClearCallback(
+        AudioFrameReadyCallback{&staticAudioFrameCallback, this});
+  } else {
+    peer_->RegisterRemoteAudioFrameCallback(AudioFrameReadyCallback{});
+  }
 }
 
 AudioReadStream::Buffer::Buffer() {
   resampler_ = std::make_unique<webrtc::Resampler>();
+  float_resampler_ = std::make_unique<webrtc::PushResampler<float>>();
 }
 AudioReadStream::Buffer::~Buffer() {}
 
-void AudioReadStream::Buffer::addFrame(const Frame& frame,
+void AudioReadStream::Buffer::addFrame(const short* samples,
+                                       const AudioFrameRing::FrameInfo& info,
                                        int dstSampleRate,
                                        int dstChannels) {
-  // We may require up to 2 intermediate buffers
-  // We always write into buffer_next and then swap front/back buffers
-  std::vector<short> buffer_front;
-  std::vector<short> buffer_back;
-
-  // tmpData will eventually hold u16 data with the correct number of channels
-  const short* srcData;
-  size_t srcCount;
-
-  // promote to 16 bit
-  if (frame.bits_per_sample == 16) {
-    srcData = (short*)frame.audio_data.data();
-    srcCount = frame.number_of_frames * frame.number_of_channels;
-  } else if (frame.bits_per_sample == 8) {
-    buffer_front.resize(frame.audio_data.size());
-    short* data = buffer_front.data();
-    for (int i = 0; i < (int)frame.audio_data.size(); ++i) {
-      data[i] = ((int)frame.audio_data[i] * 256) - 32768;
-    }
-    srcData = data;
-    srcCount = buffer_front.size();
-    swap(buffer_front, buffer_back);
-  } else {
+  const int srcChannels = (int)info.channel_count;
+  if ((srcChannels < 1) || (srcChannels > 2) || (dstChannels < 1) ||
+      (dstChannels > 2)) {
     assert(false);
     return;
   }
 
-  // match number of channels
-  switch (frame.number_of_channels * 16 + dstChannels) {
-    case 0x11:
-    case 0x22:
-      break;      // nop
-    case 0x12: {  // duplicate
-      buffer_front.resize(srcCount * 2);
-      short* data = buffer_front.data();
-      for (int i = 0; i < (int)srcCount; ++i) {
-        data[2 * i + 0] = srcData[i];
-        data[2 * i + 1] = srcData[i];
-      }
-      srcData = data;
-      srcCount = buffer_front.size();
-      swap(buffer_front, buffer_back);
-      break;
-    }
-    case 0x21: {  // average L&R
-      buffer_front.resize(srcCount / 2);
-      short* data = buffer_front.data();
-      for (int i = 0; i < (int)srcCount; ++i) {
-        data[i] = (srcData[2 * i] + srcData[2 * i + 1]) / 2;
-      }
-      srcData = data;
-      srcCount = buffer_front.size();
-      swap(buffer_front, buffer_back);
-      break;
-    }
-    default:
-      assert(false);
-      return;
+  if (((int)info.sample_rate != dstSampleRate) &&
+      (resample_mode_ == mrsAudioResampleMode::kFloat)) {
+    addFrameFloat(samples, info, dstSampleRate, dstChannels);
+    return;
   }
 
-  // match sample rate
-  if ((int)frame.sample_rate != dstSampleRate) {
-    buffer_front.resize((srcCount * dstSampleRate / frame.sample_rate) + 1);
-    short* data = buffer_front.data();
+  // srcData holds s16 data with the source number of channels. The ring
+  // already promoted 8-bit samples to 16-bit.
+  const short* srcData = samples;
+  size_t srcFrames = info.frame_count;
 
-    resampler_->ResetIfNeeded(frame.sample_rate, dstSampleRate, dstChannels);
+  // match sample rate, before matching the number of channels so that the
+  // channel mapping is fused with the float conversion below
+  if ((int)info.sample_rate != dstSampleRate) {
+    const size_t srcCount = srcFrames * srcChannels;
+    scratch_.resize((srcCount * dstSampleRate / info.sample_rate) + 1);
+    resampler_->ResetIfNeeded(info.sample_rate, dstSampleRate, srcChannels);
     size_t count;
-    resampler_->Push(srcData, srcCount, data, buffer_front.size(), count);
-    srcData = data;
-    srcCount = count;
-    swap(buffer_front, buffer_back);
+    resampler_->Push(srcData, srcCount, scratch_.data(), scratch_.size(),
+                     count);
+    srcData = scratch_.data();
+    srcFrames = count / srcChannels;
   }
 
-  // Convert s16 to f32
-  data_.resize(srcCount);
-  for (size_t i = 0; i < srcCount; ++i) {
-    data_[i] = (float)srcData[i] / 32768.0f;
+  // match number of channels and convert s16 to f32 in a single pass
+  data_.resize(srcFrames * dstChannels);
+  ConvertS16ToFloat(srcData, srcChannels, data_.data(), dstChannels,
+                    srcFrames);
+  finishFrame(dstSampleRate, dstChannels);
+}
+
+void AudioReadStream::Buffer::addFrameFloat(
+    const short* samples,
+    const AudioFrameRing::FrameInfo& info,
+    int dstSampleRate,
+    int dstChannels) {
+  // match number of channels and convert s16 to f32 in a single pass, then
+  // resample in float without quantizing again to 16 bits
+  const size_t srcFrames = info.frame_count;
+  float_scratch_.resize(srcFrames * dstChannels);
+  ConvertS16ToFloat(samples, (int)info.channel_count, float_scratch_.data(),
+                    dstChannels, srcFrames);
+
+  // The resampler consumes and produces whole 10ms frames, as delivered by
+  // WebRTC. Other frames are dropped.
+  data_.resize((size_t)(dstSampleRate / 100) * dstChannels);
+  int count = -1;
+  if (float_resampler_->InitializeIfNeeded(info.sample_rate, dstSampleRate,
+                                           dstChannels) == 0) {
+    count = float_resampler_->Resample(float_scratch_.data(),
+                                       float_scratch_.size(), data_.data(),
+                                       data_.size());
+  }
+  data_.resize((size_t)std::max(count, 0));
+  finishFrame(dstSampleRate, dstChannels);
+}
+
+void AudioReadStream::Buffer::finishFrame(int dstSampleRate, int dstChannels) {
+  // The interpolation history of the previous format is meaningless
+  if ((dstSampleRate != rate_) || (dstChannels != channels_)) {
+    drift_.Reset(dstChannels);
   }
+  drift_out_.clear();
+  drift_.Process(data_.data(), data_.size() / dstChannels, drift_out_);
+  data_.swap(drift_out_);
   used_ = 0;
   channels_ = dstChannels;
   rate_ = dstSampleRate;
 }
 
+double AudioReadStream::getFillMs() const {
+  // WebRTC delivers 10ms frames
+  double fillMs = frames_.size() * 10.0;
+  if ((buffer_.rate_ > 0) && (buffer_.channels_ > 0)) {
+    const size_t buffered = (size_t)(buffer_.available() / buffer_.channels_) +
+                            buffer_.drift_.pending_frame_count();
+    fillMs += buffered * 1000.0 / buffer_.rate_;
+  }
+  return fillMs;
+}
+
 void AudioReadStream::Read(int sampleRate,
                            float dataOrig[],
                            int dataLenOrig,
@@ -1795,6 +2106,16 @@ void AudioReadStream::Read(int sampleRate,
   // channels in buffer_.addFrame(). We could save a bit of work and memory by
   // moving any 1->2 channel conversions into buffer_.readSome().
 
+  // Hold playback until the buffer is half full, after starting or running
+  // out of audio, to absorb the jitter of WebRTC and of the reader.
+  const double targetMs = buffer_ms_ / 2.0;
+  AudioDriftCompensator& drift = buffer_.drift_;
+  if (drift.prebuffering() &&
+      !drift.TryEndPrebuffering(getFillMs(), targetMs)) {
+    memset(dst, 0, dstLen * sizeof(float));
+    return;
+  }
+
   while (dstLen > 0) {
     // format matches, fill some from the buffer. If the format doesn't
     // match we will fall through and ensure the next frame matches. This
@@ -1806,44 +2127,27 @@ void AudioReadStream::Read(int sampleRate,
       dst += len;
       dstLen -= len;
     } else {
-#if 1
-      Frame frame;
-      bool haveFrame = false;
-      {
-        std::unique_lock<std::mutex> lock(frames_mutex_);
-        if (!frames_.empty()) {
-          frame = std::move(frames_.front());
-          frames_.pop_front();
-          haveFrame = true;
-        }
+      // maintain buffering limits by dropping the oldest frames
+      const uint32_t maxFrames = GetMaxBufferedFrames(buffer_ms_);
+      const uint32_t frameCount = frames_.size();
+      if (frameCount > maxFrames) {
+        frames_.Discard(frameCount - maxFrames);
       }
-      if (haveFrame) {
-        buffer_.addFrame(frame, sampleRate, channels);
+      AudioFrameRing::FrameInfo info;
+      if (const short* samples = frames_.Front(info)) {
+        buffer_.addFrame(samples, info, sampleRate, channels);
+        // Release the slot only once its samples are consumed.
+        frames_.Pop();
       } else {
-        memset(dst, 0, dstLen);
+        drift.OnUnderrun();
+        memset(dst, 0, dstLen * sizeof(float));
         dstLen = 0;
       }
-#else
-      Frame frame;
-      {
-        std::unique_lock<std::mutex> lock(frames_mutex_);
-        if (frames_.empty()) {
-          lock.unlock();
-          memset(dst, 0, dstLen);
-          return;  // and return
-        }
-        Frame& f = frames_.front();
-        frame.audio_data.swap(f.audio_data);
-        frame.bits_per_sample = f.bits_per_sample;
-        frame.sample_rate = f.sample_rate;
-        frame.number_of_channels = f.number_of_channels;
-        frame.number_of_frames = f.number_of_frames;
-        frames_.pop_front();
-      }
-      buffer_.addFrame(frame, sampleRate, channels);
-#endif
     }
   }
+
+  // Track the clock drift between WebRTC and the reader from the fill level
+  drift.Update(getFillMs(), targetMs);
 }
 
 }  // namespace Microsoft::MixedReality::WebRTC
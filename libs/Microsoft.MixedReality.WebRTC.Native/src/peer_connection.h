@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "audio_drift_compensator.h"
 #include "audio_frame_observer.h"
+#include "audio_frame_ring.h"
 #include "callback.h"
 #include "data_channel.h"
 #include "mrs_errors.h"
@@ -13,12 +15,15 @@
 
 namespace webrtc {
     class Resampler;
+    template <typename T>
+    class PushResampler;
 }
 
 namespace Microsoft::MixedReality::WebRTC {
 
 class PeerConnection;
 class LocalVideoTrack;
+class RemoteAudioTrack;
 class ExternalVideoTrackSource;
 class DataChannel;
 
@@ -199,6 +204,42 @@ class PeerConnection : public TrackedObject {
   virtual void RegisterTrackRemovedCallback(
       TrackRemovedCallback&& callback) noexcept = 0;
 
+  /// Callback invoked when a remote video track is added, with the handle of
+  /// the |RemoteVideoTrack| object and its track ID.
+  using RemoteVideoTrackAddedCallback =
+      Callback<RemoteVideoTrackHandle, const char*>;
+
+  /// Register a custom RemoteVideoTrackAddedCallback.
+  virtual void RegisterRemoteVideoTrackAddedCallback(
+      RemoteVideoTrackAddedCallback&& callback) noexcept = 0;
+
+  /// Callback invoked when a remote video track is removed, with the handle of
+  /// the |RemoteVideoTrack| object and its track ID.
+  using RemoteVideoTrackRemovedCallback =
+      Callback<RemoteVideoTrackHandle, const char*>;
+
+  /// Register a custom RemoteVideoTrackRemovedCallback.
+  virtual void RegisterRemoteVideoTrackRemovedCallback(
+      RemoteVideoTrackRemovedCallback&& callback) noexcept = 0;
+
+  /// Callback invoked when a remote audio track is added, with the handle of
+  /// the |RemoteAudioTrack| object and its track ID.
+  using RemoteAudioTrackAddedCallback =
+      Callback<RemoteAudioTrackHandle, const char*>;
+
+  /// Register a custom RemoteAudioTrackAddedCallback.
+  virtual void RegisterRemoteAudioTrackAddedCallback(
+      RemoteAudioTrackAddedCallback&& callback) noexcept = 0;
+
+  /// Callback invoked when a remote audio track is removed, with the handle of
+  /// the |RemoteAudioTrack| object and its track ID.
+  using RemoteAudioTrackRemovedCallback =
+      Callback<RemoteAudioTrackHandle, const char*>;
+
+  /// Register a custom RemoteAudioTrackRemovedCallback.
+  virtual void RegisterRemoteAudioTrackRemovedCallback(
+      RemoteAudioTrackRemovedCallback&& callback) noexcept = 0;
+
   //
   // Video
   //
@@ -213,6 +254,62 @@ class PeerConnection : public TrackedObject {
   virtual void RegisterRemoteVideoFrameCallback(
       Argb32FrameReadyCallback callback) noexcept = 0;
 
+  /// Register a custom callback invoked when a remote video frame has been
+  /// received and decompressed, and is ready to be consumed as NV12.
+  virtual void RegisterRemoteVideoFrameCallback(
+      Nv12FrameReadyCallback callback) noexcept = 0;
+
+  /// Register a custom callback invoked when a remote video frame has been
+  /// received and decompressed, and is ready to be consumed as RGBA32.
+  virtual void RegisterRemoteVideoFrameCallback(
+      Rgba32FrameReadyCallback callback) noexcept = 0;
+
+  /// Register a custom callback invoked when a remote video frame has been
+  /// received and decompressed, and is ready to be consumed as BGR24.
+  virtual void RegisterRemoteVideoFrameCallback(
+      Bgr24FrameReadyCallback callback) noexcept = 0;
+
+  /// Register a custom callback invoked when a remote video frame has been
+  /// received and decompressed, and is ready to be consumed as I420 packed in
+  /// a single contiguous memory block.
+  virtual void RegisterRemoteVideoFrameCallback(
+      I420PackedFrameReadyCallback callback) noexcept = 0;
+
+  /// Set the maximum number of threads used to convert each remote video
+  /// frame before delivering it to the ARGB32, NV12, RGBA32, BGR24 and packed
+  /// I420 callbacks. See |VideoFrameObserver::SetConversionParallelism()|.
+  virtual void SetRemoteVideoConversionParallelism(
+      int max_parallelism) noexcept = 0;
+
+  /// Set the maximum dimensions of the remote video frames delivered to the
+  /// callback for |format|, and request the remote video tracks to lower their
+  /// resolution if no registered callback needs more pixels. See
+  /// |VideoFrameObserver::SetCallbackTargetSize()|.
+  virtual Result SetRemoteVideoFrameTargetSize(VideoFrameFormat format,
+                                               int width,
+                                               int height) noexcept = 0;
+
+  /// Set the delivery mode of the remote video frames to the callbacks. See
+  /// |VideoFrameObserver::SetDeliveryMode()|.
+  virtual void SetRemoteVideoDeliveryMode(
+      VideoFrameDeliveryMode mode) noexcept = 0;
+
+  /// In polled delivery mode, deliver the latest remote video frame to the
+  /// callbacks on the calling thread. See |VideoFrameObserver::PollFrame()|.
+  virtual bool PollRemoteVideoFrame() noexcept = 0;
+
+  /// Register application-owned destination buffers for the ARGB32 remote
+  /// video frame callback. See |VideoFrameObserver::SetArgb32Destinations()|.
+  virtual Result SetRemoteVideoArgb32Destinations(void* const* buffers,
+                                                  int count,
+                                                  uint64_t size,
+                                                  int stride) noexcept = 0;
+
+  /// Release a destination buffer reserved by a delivered ARGB32 remote video
+  /// frame. See |VideoFrameObserver::ReleaseArgb32Destination()|.
+  virtual Result ReleaseRemoteVideoArgb32Destination(
+      const void* buffer) noexcept = 0;
+
   /// Add a video track to the peer connection. If no RTP sender/transceiver
   /// exist, create a new one for that track.
   virtual ErrorOr<RefPtr<LocalVideoTrack>> AddLocalVideoTrack(
@@ -223,9 +320,9 @@ class PeerConnection : public TrackedObject {
   virtual webrtc::RTCError RemoveLocalVideoTrack(
       LocalVideoTrack& video_track) noexcept = 0;
 
-  /// Remove all tracks sharing the given video track source.
-  /// Note that currently video source sharing is not supported, so this will
-  /// remove at most a single track backed by the given source.
+  /// Remove from this peer connection all tracks sharing the given video track
+  /// source. The source itself is left untouched, and keeps feeding the tracks
+  /// it is attached to on other peer connections, if any.
   virtual void RemoveLocalVideoTracksFromSource(
       ExternalVideoTrackSource& source) noexcept = 0;
 
@@ -269,7 +366,9 @@ class PeerConnection : public TrackedObject {
       AudioFrameReadyCallback callback) noexcept = 0;
 
   /// Register a custom callback invoked when a remote audio frame has been
-  /// received and uncompressed, and is ready to be output locally.
+  /// received and uncompressed, and is ready to be output locally. Frames of
+  /// all remote audio tracks are delivered to this callback; use a
+  /// |RemoteAudioTrack| to receive the frames of each track separately.
   virtual void RegisterRemoteAudioFrameCallback(
       AudioFrameReadyCallback callback) noexcept = 0;
 
@@ -372,14 +471,34 @@ class PeerConnection : public TrackedObject {
    public:
     /// Create a new stream which buffers 'bufferMs' milliseconds of audio.
     /// WebRTC delivers audio at 10ms intervals so pass a multiple of 10.
-    /// Or pass -1 for automaticlly chosen buffer size.
-    AudioReadStream(PeerConnection* peer, int bufferMs);
+    /// Or pass -1 for the default buffer size of 60ms.
+    /// The stream compensates the clock drift between WebRTC and the reader
+    /// to keep the buffer half full, so small buffers of 40-60ms are enough
+    /// to absorb the jitter of both sides.
+    /// 'resampleMode' selects the sample format in which audio is resampled
+    /// when its sample rate differs from the one read.
+    AudioReadStream(
+        PeerConnection* peer,
+        int bufferMs,
+        mrsAudioResampleMode resampleMode = mrsAudioResampleMode::kInt16);
+    /// Create a new stream reading the audio of a single remote audio track,
+    /// instead of the audio of all remote tracks of a peer connection. This
+    /// allows reading the audio of each remote participant separately, for
+    /// example to spatialize it. The stream keeps the track alive, and reads
+    /// silence once the track is removed. It replaces the frame callback of
+    /// the track, and on destruction only unregisters its own callback, so a
+    /// callback registered after it is left in place.
+    AudioReadStream(
+        RemoteAudioTrack& track,
+        int bufferMs,
+        mrsAudioResampleMode resampleMode = mrsAudioResampleMode::kInt16);
     ~AudioReadStream();
 
     /// Fill data with samples at the given sampleRate and number of channels.
     /// If the internal buffer overruns, the oldest data will be dropped.
-    /// If the internal buffer is exhausted, the data is padded with white
-    /// noise. In any case the entire data array is filled.
+    /// If the internal buffer is exhausted, the data is padded with silence
+    /// until the buffer is half full again. In any case the entire data array
+    /// is filled.
     void Read(int sampleRate,
               float data[],
               int dataLen,
@@ -388,6 +507,8 @@ class PeerConnection : public TrackedObject {
    private:
     // Buffer the next frame. Return false on failure.
     bool bufferNextFrame(int sampleRate, int channels);
+    // Duration of the audio buffered and not read yet, in milliseconds.
+    double getFillMs() const;
     static void MRS_CALL staticAudioFrameCallback(void* user_data,
                                                   const AudioFrame& frame);
     void audioFrameCallback(const void* audio_data,
@@ -396,28 +517,34 @@ class PeerConnection : public TrackedObject {
                             const uint32_t number_of_channels,
                             const uint32_t number_of_frames);
 
+    // Source of the audio frames: either all remote audio tracks of a peer
+    // connection, or a single remote audio track.
     PeerConnection* peer_ = nullptr;
-    struct Frame {
-      std::vector<std::byte> audio_data;
-      uint32_t bits_per_sample;
-      uint32_t sample_rate;
-      uint32_t number_of_channels;
-      uint32_t number_of_frames;
-    };
-    // Frames received from webrtc
-    std::deque<Frame> frames_;
-    std::mutex
-        frames_mutex_;  // frames accessed by Read() and audioFrameCallback()
+    RefPtr<RemoteAudioTrack> track_;
     int buffer_ms_ = 0;
+    // Frames received from webrtc. Written by audioFrameCallback() on the
+    // audio thread and read by Read(), without locking.
+    AudioFrameRing frames_;
     int sinwave_iter_ = 0;
 
     struct Buffer {
+      mrsAudioResampleMode resample_mode_ = mrsAudioResampleMode::kInt16;
       std::unique_ptr<webrtc::Resampler> resampler_ = nullptr;
+      std::unique_ptr<webrtc::PushResampler<float>> float_resampler_ = nullptr;
       std::vector<float> data_;
       int used_ = 0;
       int channels_ = 0;
       int rate_ = 0;
 
+      // Intermediate samples of addFrame(), kept to avoid reallocating them:
+      // resampled samples in int16 mode, or converted samples in float mode.
+      std::vector<short> scratch_;
+      std::vector<float> float_scratch_;
+
+      // Clock drift compensation of the converted frames.
+      AudioDriftCompensator drift_;
+      std::vector<float> drift_out_;
+
       Buffer();
       ~Buffer();
       int available() const { return (int)data_.size() - used_; }
@@ -427,7 +554,18 @@ class PeerConnection : public TrackedObject {
         used_ += take;
         return take;
       }
-      void addFrame(const Frame& frame, int dstSampleRate, int dstChannels);
+      void addFrame(const short* samples,
+                    const AudioFrameRing::FrameInfo& info,
+                    int dstSampleRate,
+                    int dstChannels);
+      // Float resampling path of addFrame().
+      void addFrameFloat(const short* samples,
+                         const AudioFrameRing::FrameInfo& info,
+                         int dstSampleRate,
+                         int dstChannels);
+      // Compensate the clock drift of the frame converted in data_, and make
+      // it available for reading.
+      void finishFrame(int dstSampleRate, int dstChannels);
     };
     // Only accessed from callers of Read - no locking needed.
     Buffer buffer_;
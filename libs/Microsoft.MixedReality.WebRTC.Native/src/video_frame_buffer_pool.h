@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Pool of reusable video frame buffers of type |T|, similar to
+/// |webrtc::I420BufferPool| but for any buffer type constructible from a
+/// (width, height) pair, like |ArgbBuffer|.
+///
+/// A buffer returned by |CreateBuffer()| is exclusively owned by its users
+/// until all external references are released, at which point the pool can
+/// recycle it for a later frame of the same dimensions. References can be
+/// released from any thread, which allows consumers to hold onto a frame
+/// beyond the callback which delivered it without any copy. The pool itself
+/// is not thread-safe however, and calls to |CreateBuffer()| and |Release()|
+/// must be serialized by the caller.
+///
+/// The pool keeps at most a fixed number of buffers. If all of them are in
+/// use, |CreateBuffer()| allocates a temporary buffer which is not recycled,
+/// so that frames are never dropped for lack of a buffer.
+template <typename T>
+class VideoFrameBufferPool {
+ public:
+  /// Default maximum number of buffers the pool allocates, including
+  /// buffers currently in use.
+  static constexpr size_t kDefaultMaxNumberOfBuffers = 8;
+
+  explicit VideoFrameBufferPool(
+      size_t max_number_of_buffers = kDefaultMaxNumberOfBuffers) noexcept
+      : max_number_of_buffers_(max_number_of_buffers) {}
+
+  /// Get a buffer with the given dimensions, reusing a free pooled buffer if
+  /// any, or allocating a new one otherwise. If all |max_number_of_buffers_|
+  /// buffers are in use, the new buffer is not pooled. The buffer content is
+  /// undefined.
+  rtc::scoped_refptr<T> CreateBuffer(int width, int height) {
+    // Release free buffers with the wrong dimensions, which are unlikely to
+    // be used again since frame dimensions rarely change.
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                  [width, height](const auto& buffer) {
+                                    return buffer->HasOneRef() &&
+                                           ((buffer->width() != width) ||
+                                            (buffer->height() != height));
+                                  }),
+                   buffers_.end());
+    for (const rtc::scoped_refptr<PooledBuffer>& buffer : buffers_) {
+      // The pool holds one reference; any other one means in use.
+      if (buffer->HasOneRef()) {
+        exhausted_ = false;
+        return buffer;
+      }
+    }
+    rtc::scoped_refptr<PooledBuffer> buffer =
+        new PooledBuffer(width, height);
+    ++allocation_count_;
+    if (buffers_.size() < max_number_of_buffers_) {
+      buffers_.push_back(buffer);
+      exhausted_ = false;
+    } else if (!exhausted_) {
+      RTC_LOG(LS_WARNING) << "Video frame buffer pool exhausted with "
+                          << max_number_of_buffers_ << " buffers of "
+                          << width << "x" << height
+                          << "; allocating unpooled buffers until retained "
+                             "frames are released.";
+      exhausted_ = true;
+    }
+    return buffer;
+  }
+
+  /// Release all the buffers held by the pool. Buffers still in use remain
+  /// valid until their last reference is released.
+  void Release() noexcept { buffers_.clear(); }
+
+  /// Total number of buffers allocated by the pool since its creation, pooled
+  /// or not. This stops increasing once the pool reached a steady state.
+  size_t allocation_count() const noexcept { return allocation_count_; }
+
+ private:
+  using PooledBuffer = rtc::RefCountedObject<T>;
+
+  /// Pooled buffers, either free (single reference held by the pool) or in
+  /// use (extra external references).
+  std::vector<rtc::scoped_refptr<PooledBuffer>> buffers_;
+
+  /// Maximum number of buffers in |buffers_|.
+  const size_t max_number_of_buffers_;
+
+  /// Number of buffers allocated since the pool was created.
+  size_t allocation_count_{0};
+
+  /// Set while all pooled buffers are in use, to log a warning only once per
+  /// exhaustion instead of once per unpooled allocation.
+  bool exhausted_{false};
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
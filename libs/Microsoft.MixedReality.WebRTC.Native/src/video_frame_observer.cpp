@@ -4,6 +4,9 @@
 
 #include "pch.h"
 
+#include <thread>
+
+#include "interop/global_factory.h"
 #include "video_frame_observer.h"
 
 namespace {
@@ -11,11 +14,43 @@ namespace {
 // Aligning pointer to 64 bytes for improved performance, e.g. use SIMD.
 constexpr int kBufferAlignment = 64;
 
+// Minimum number of rows converted by a single thread. Below that, the cost
+// of dispatching to the worker pool outweighs the gain, so smaller frames are
+// converted on the calling thread only.
+constexpr int kMinRowsPerConversionStripe = 64;
+
 }  // namespace
 
 namespace Microsoft::MixedReality::WebRTC {
 
-ArgbBuffer::ArgbBuffer(int width, int height, int stride) noexcept
+VideoFrameSize FitFrameSize(int width,
+                            int height,
+                            VideoFrameSize target) noexcept {
+  if ((target.width_ <= 0) || (target.height_ <= 0) ||
+      ((width <= target.width_) && (height <= target.height_))) {
+    return {width, height};
+  }
+  VideoFrameSize size;
+  // Compare the aspect ratios to find which dimension limits the size.
+  if (static_cast<int64_t>(target.width_) * height <=
+      static_cast<int64_t>(target.height_) * width) {
+    size.width_ = target.width_;
+    size.height_ = static_cast<int>(static_cast<int64_t>(height) *
+                                    target.width_ / width);
+  } else {
+    size.width_ = static_cast<int>(static_cast<int64_t>(width) *
+                                   target.height_ / height);
+    size.height_ = target.height_;
+  }
+  size.width_ = std::max(size.width_ & ~1, 2);
+  size.height_ = std::max(size.height_ & ~1, 2);
+  return size;
+}
+
+PackedRgbBuffer::PackedRgbBuffer(int width,
+                                 int height,
+                                 int stride,
+                                 int bytes_per_pixel) noexcept
     : width_(width),
       height_(height),
       stride_(stride),
@@ -24,131 +59,763 @@ ArgbBuffer::ArgbBuffer(int width, int height, int stride) noexcept
                                 kBufferAlignment))) {
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
-  RTC_DCHECK_GE(stride, 4 * width);
+  RTC_DCHECK_GE(stride, bytes_per_pixel * width);
 }
 
 rtc::scoped_refptr<webrtc::I420BufferInterface> ArgbBuffer::ToI420() {
   rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer =
-      webrtc::I420Buffer::Create(width_, height_, stride_, stride_ / 2,
-                                 stride_ / 2);
+      webrtc::I420Buffer::Create(width(), height(), Stride(), Stride() / 2,
+                                 Stride() / 2);
   libyuv::ARGBToI420(Data(), Stride(), i420_buffer->MutableDataY(),
                      i420_buffer->StrideY(), i420_buffer->MutableDataU(),
                      i420_buffer->StrideU(), i420_buffer->MutableDataV(),
-                     i420_buffer->StrideV(), width_, height_);
+                     i420_buffer->StrideV(), width(), height());
   return i420_buffer;
 }
 
+rtc::scoped_refptr<webrtc::I420BufferInterface> Rgba32Buffer::ToI420() {
+  rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer =
+      webrtc::I420Buffer::Create(width(), height());
+  libyuv::ABGRToI420(Data(), Stride(), i420_buffer->MutableDataY(),
+                     i420_buffer->StrideY(), i420_buffer->MutableDataU(),
+                     i420_buffer->StrideU(), i420_buffer->MutableDataV(),
+                     i420_buffer->StrideV(), width(), height());
+  return i420_buffer;
+}
+
+rtc::scoped_refptr<webrtc::I420BufferInterface> Bgr24Buffer::ToI420() {
+  rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer =
+      webrtc::I420Buffer::Create(width(), height());
+  libyuv::RGB24ToI420(Data(), Stride(), i420_buffer->MutableDataY(),
+                      i420_buffer->StrideY(), i420_buffer->MutableDataU(),
+                      i420_buffer->StrideU(), i420_buffer->MutableDataV(),
+                      i420_buffer->StrideV(), width(), height());
+  return i420_buffer;
+}
+
+Nv12Buffer::Nv12Buffer(int width, int height) noexcept
+    : width_(width),
+      height_(height),
+      stride_y_(width),
+      stride_uv_(((width + 1) / 2) * 2),
+      data_(static_cast<uint8_t*>(webrtc::AlignedMalloc(
+          static_cast<size_t>(width) * height +
+              static_cast<size_t>(((width + 1) / 2) * 2) * ((height + 1) / 2),
+          kBufferAlignment))) {
+  RTC_DCHECK_GT(width, 0);
+  RTC_DCHECK_GT(height, 0);
+}
+
+rtc::scoped_refptr<webrtc::I420BufferInterface> Nv12Buffer::ToI420() {
+  rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer =
+      webrtc::I420Buffer::Create(width_, height_);
+  libyuv::NV12ToI420(DataY(), StrideY(), DataUV(), StrideUV(),
+                     i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                     i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                     i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                     width_, height_);
+  return i420_buffer;
+}
+
+bool VideoFrameObserver::CallbackSet::has_callback(
+    VideoFrameFormat format) const noexcept {
+  switch (format) {
+    case VideoFrameFormat::kI420A:
+      return static_cast<bool>(i420a_callback_);
+    case VideoFrameFormat::kArgb32:
+      return static_cast<bool>(argb_callback_);
+    case VideoFrameFormat::kNv12:
+      return static_cast<bool>(nv12_callback_);
+    case VideoFrameFormat::kRgba32:
+      return static_cast<bool>(rgba32_callback_);
+    case VideoFrameFormat::kBgr24:
+      return static_cast<bool>(bgr24_callback_);
+    case VideoFrameFormat::kI420Packed:
+      return static_cast<bool>(i420_packed_callback_);
+  }
+  return false;
+}
+
+VideoFrameObserver::~VideoFrameObserver() noexcept {
+  // The observer must have been removed from all sources before being
+  // destroyed, so there is no in-flight delivery left.
+  RTC_DCHECK_EQ(0, callback_readers_[0].load());
+  RTC_DCHECK_EQ(0, callback_readers_[1].load());
+  delete callbacks_.exchange(nullptr);
+}
+
+VideoFrameObserver::CallbackReadScope::CallbackReadScope(
+    VideoFrameObserver& observer) noexcept
+    : observer_(observer) {
+  // Announce the reader in the counter of the current epoch, then check that
+  // the epoch did not change in between, before loading the snapshot. All
+  // operations are sequentially consistent, so a reader which registered in
+  // the new epoch is ordered after the writer published the new snapshot, and
+  // will not load the retired one. A reader racing with the epoch change
+  // retries in the new epoch, so it delays the writer by one retry at most.
+  for (;;) {
+    const unsigned int epoch =
+        observer_.callback_epoch_.load(std::memory_order_seq_cst);
+    readers_ = &observer_.callback_readers_[epoch & 1u];
+    readers_->fetch_add(1, std::memory_order_seq_cst);
+    if (observer_.callback_epoch_.load(std::memory_order_seq_cst) == epoch) {
+      break;
+    }
+    readers_->fetch_sub(1, std::memory_order_release);
+  }
+  callbacks_ = observer_.callbacks_.load(std::memory_order_seq_cst);
+}
+
+VideoFrameObserver::CallbackReadScope::~CallbackReadScope() noexcept {
+  readers_->fetch_sub(1, std::memory_order_release);
+}
+
+template <typename Updater>
+void VideoFrameObserver::UpdateCallbacks(Updater&& updater) noexcept {
+  auto lock = std::scoped_lock{mutex_};
+  const CallbackSet* const old_callbacks =
+      callbacks_.load(std::memory_order_relaxed);
+  auto new_callbacks = std::make_unique<CallbackSet>(
+      old_callbacks ? *old_callbacks : CallbackSet{});
+  updater(*new_callbacks);
+  callbacks_.exchange(new_callbacks.release(), std::memory_order_seq_cst);
+  // Retire the epoch of the old snapshot. Writers are serialized by |mutex_|,
+  // and each one drains its retired epoch before returning, so the counter of
+  // the new epoch only holds readers of the new snapshot.
+  const unsigned int old_epoch =
+      callback_epoch_.fetch_add(1, std::memory_order_seq_cst);
+  std::atomic<int>& old_readers = callback_readers_[old_epoch & 1u];
+  // Wait for in-flight deliveries which may still use the old snapshot. This
+  // only blocks the caller for at most the duration of the frame callbacks
+  // currently executing, since later deliveries register in the new epoch;
+  // the decoder thread is never blocked.
+  while (old_readers.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
+  delete old_callbacks;
+}
+
 void VideoFrameObserver::SetCallback(
     I420AFrameReadyCallback callback) noexcept {
-  auto lock = std::scoped_lock{mutex_};
-  i420a_callback_ = std::move(callback);
+  UpdateCallbacks(
+      [&callback](CallbackSet& cbs) { cbs.i420a_callback_ = callback; });
 }
 
 void VideoFrameObserver::SetCallback(
     Argb32FrameReadyCallback callback) noexcept {
-  auto lock = std::scoped_lock{mutex_};
-  argb_callback_ = std::move(callback);
+  UpdateCallbacks(
+      [&callback](CallbackSet& cbs) { cbs.argb_callback_ = callback; });
+}
+
+void VideoFrameObserver::SetCallback(Nv12FrameReadyCallback callback) noexcept {
+  UpdateCallbacks(
+      [&callback](CallbackSet& cbs) { cbs.nv12_callback_ = callback; });
+}
+
+void VideoFrameObserver::SetCallback(
+    Rgba32FrameReadyCallback callback) noexcept {
+  UpdateCallbacks(
+      [&callback](CallbackSet& cbs) { cbs.rgba32_callback_ = callback; });
+}
+
+void VideoFrameObserver::SetCallback(
+    Bgr24FrameReadyCallback callback) noexcept {
+  UpdateCallbacks(
+      [&callback](CallbackSet& cbs) { cbs.bgr24_callback_ = callback; });
+}
+
+void VideoFrameObserver::SetCallback(
+    I420PackedFrameReadyCallback callback) noexcept {
+  UpdateCallbacks(
+      [&callback](CallbackSet& cbs) { cbs.i420_packed_callback_ = callback; });
+}
+
+template <typename T>
+rtc::scoped_refptr<T> VideoFrameObserver::AcquireBuffer(
+    VideoFrameBufferPool<T>& pool,
+    int width,
+    int height) noexcept {
+  if (buffer_pools_in_use_.test_and_set(std::memory_order_acquire)) {
+    // Another thread is acquiring a buffer from the pools; this is rare, so
+    // fall back to a temporary buffer instead of waiting.
+    return new rtc::RefCountedObject<T>(width, height);
+  }
+  // If the consumers retain all the pooled buffers, the pool allocates a
+  // temporary one rather than dropping the frame, which would freeze the
+  // video until a frame is released.
+  rtc::scoped_refptr<T> buffer = pool.CreateBuffer(width, height);
+  buffer_pools_in_use_.clear(std::memory_order_release);
+  return buffer;
+}
+
+rtc::scoped_refptr<ArgbBuffer> VideoFrameObserver::AcquireArgbBuffer(
+    int width,
+    int height) noexcept {
+  return AcquireBuffer(argb_buffer_pool_, width, height);
+}
+
+void VideoFrameObserver::SetConversionParallelism(
+    int max_parallelism) noexcept {
+  conversion_parallelism_.store(std::max(max_parallelism, 1),
+                                std::memory_order_relaxed);
+}
+
+Result VideoFrameObserver::SetCallbackTargetSize(VideoFrameFormat format,
+                                                 int width,
+                                                 int height) noexcept {
+  const int index = static_cast<int>(format);
+  if ((index < 0) || (index >= kVideoFrameFormatCount) || (width < 0) ||
+      (height < 0)) {
+    return Result::kInvalidParameter;
+  }
+  UpdateCallbacks([index, width, height](CallbackSet& cbs) {
+    cbs.target_sizes_[index] = VideoFrameSize{width, height};
+  });
+  return Result::kSuccess;
+}
+
+rtc::VideoSinkWants VideoFrameObserver::GetSinkWants() noexcept {
+  rtc::VideoSinkWants wants{};
+  // No exposed API for the caller to handle rotation.
+  wants.rotation_applied = true;
+  const CallbackReadScope read_scope(*this);
+  const CallbackSet* const callbacks = read_scope.get();
+  if (!callbacks || callbacks->empty()) {
+    return wants;
+  }
+  int max_pixel_count = 0;
+  for (int i = 0; i < kVideoFrameFormatCount; ++i) {
+    if (!callbacks->has_callback(static_cast<VideoFrameFormat>(i))) {
+      continue;
+    }
+    const VideoFrameSize& target = callbacks->target_sizes_[i];
+    if ((target.width_ <= 0) || (target.height_ <= 0)) {
+      // This callback needs the full decoded resolution.
+      return wants;
+    }
+    max_pixel_count =
+        std::max(max_pixel_count, target.width_ * target.height_);
+  }
+  wants.max_pixel_count = max_pixel_count;
+  return wants;
+}
+
+Result VideoFrameObserver::SetArgb32Destinations(void* const* buffers,
+                                                 int count,
+                                                 uint64_t size,
+                                                 int stride) noexcept {
+  if (count < 0) {
+    return Result::kInvalidParameter;
+  }
+  std::shared_ptr<DestinationRing> ring;
+  if (count > 0) {
+    if (!buffers || (size == 0) || (stride <= 0)) {
+      return Result::kInvalidParameter;
+    }
+    ring = std::make_shared<DestinationRing>(count, size, stride);
+    for (int i = 0; i < count; ++i) {
+      if (!buffers[i]) {
+        return Result::kInvalidParameter;
+      }
+      ring->slots_[i].data_ = static_cast<uint8_t*>(buffers[i]);
+    }
+  }
+  UpdateCallbacks([&ring](CallbackSet& cbs) {
+    cbs.argb_destinations_ = std::move(ring);
+  });
+  destinations_exhausted_.store(false, std::memory_order_relaxed);
+  return Result::kSuccess;
+}
+
+Result VideoFrameObserver::ReleaseArgb32Destination(
+    const void* buffer) noexcept {
+  // Pin the current snapshot so the ring cannot be destroyed concurrently by
+  // |SetArgb32Destinations()|.
+  const CallbackReadScope read_scope(*this);
+  const CallbackSet* const callbacks = read_scope.get();
+  if (!callbacks || !callbacks->argb_destinations_) {
+    return Result::kNotFound;
+  }
+  DestinationRing& ring = *callbacks->argb_destinations_;
+  for (int i = 0; i < ring.count_; ++i) {
+    DestinationRing::Slot& slot = ring.slots_[i];
+    if (slot.data_ == buffer) {
+      if (!slot.in_use_.exchange(false, std::memory_order_acq_rel)) {
+        return Result::kInvalidOperation;
+      }
+      return Result::kSuccess;
+    }
+  }
+  return Result::kNotFound;
 }
 
-ArgbBuffer* VideoFrameObserver::GetArgbScratchBuffer(int width, int height) {
-  const size_t needed_size = Argb32FrameSize(width, height);
-  if (auto* buffer = argb_scratch_buffer_.get()) {
-    if (buffer->Size() >= needed_size) {
-      return buffer;
+VideoFrameObserver::DestinationRing::Slot*
+VideoFrameObserver::AcquireDestination(DestinationRing& ring) noexcept {
+  const int first = ring.next_slot_.load(std::memory_order_relaxed);
+  for (int i = 0; i < ring.count_; ++i) {
+    const int index = (first + i) % ring.count_;
+    DestinationRing::Slot& slot = ring.slots_[index];
+    if (!slot.in_use_.exchange(true, std::memory_order_acq_rel)) {
+      ring.next_slot_.store((index + 1) % ring.count_,
+                            std::memory_order_relaxed);
+      return &slot;
     }
   }
-  argb_scratch_buffer_ = ArgbBuffer::Create(width, height);
-  return argb_scratch_buffer_.get();
+  return nullptr;
+}
+
+void VideoFrameObserver::SetDeliveryMode(
+    VideoFrameDeliveryMode mode) noexcept {
+  delivery_mode_.store(mode, std::memory_order_relaxed);
+  if (mode == VideoFrameDeliveryMode::kInline) {
+    // Drop the pending frame to release its buffer.
+    auto lock = std::scoped_lock{mailbox_poll_mutex_};
+    mailbox_.Take();
+  }
+}
+
+void VideoFrameObserver::GetLatencyStats(
+    VideoFrameLatencyStats& stats) const noexcept {
+  delivery_latency_.GetSnapshot(stats.delivery_);
+  callback_latency_.GetSnapshot(stats.callback_);
+}
+
+void VideoFrameObserver::ResetLatencyStats() noexcept {
+  delivery_latency_.Reset();
+  callback_latency_.Reset();
+}
+
+bool VideoFrameObserver::PollFrame() noexcept {
+  absl::optional<ReceivedFrame> frame;
+  {
+    auto lock = std::scoped_lock{mailbox_poll_mutex_};
+    frame = mailbox_.Take();
+  }
+  if (!frame) {
+    return false;
+  }
+  DeliverFrame(*frame);
+  return true;
 }
 
 void VideoFrameObserver::OnFrame(const webrtc::VideoFrame& frame) noexcept {
-  auto lock = std::scoped_lock{mutex_};
-  if (!i420a_callback_ && !argb_callback_) {
+  ReceivedFrame received{
+      frame, last_frame_id_.fetch_add(1, std::memory_order_relaxed) + 1,
+      rtc::TimeMicros()};
+  if (delivery_mode_.load(std::memory_order_relaxed) ==
+      VideoFrameDeliveryMode::kInline) {
+    DeliverFrame(received);
+    return;
+  }
+  // Only keep a reference to the frame buffer; the conversion is deferred to
+  // |PollFrame()|, and skipped if the frame is replaced before being polled.
+  if (mailbox_posting_.test_and_set(std::memory_order_acquire)) {
+    // Another thread is posting a frame concurrently, which would replace
+    // this one anyway.
+    skipped_frame_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (mailbox_.Post(std::move(received))) {
+    skipped_frame_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  mailbox_posting_.clear(std::memory_order_release);
+}
+
+template <typename CallbackT, typename FrameT>
+void VideoFrameObserver::InvokeCallback(
+    const CallbackT& callback,
+    const FrameT& frame,
+    std::int64_t received_time_us) noexcept {
+  const int64_t entered_time_us = rtc::TimeMicros();
+  delivery_latency_.Record(entered_time_us - received_time_us);
+  callback(frame);
+  callback_latency_.Record(rtc::TimeMicros() - entered_time_us);
+}
+
+void VideoFrameObserver::DeliverFrame(const ReceivedFrame& received) noexcept {
+  const CallbackReadScope read_scope(*this);
+  const CallbackSet* const callbacks = read_scope.get();
+  if (!callbacks || callbacks->empty()) {
     return;
   }
 
+  const webrtc::VideoFrame& frame = received.frame_;
+  const int64_t received_time_us = received.received_time_us_;
+  VideoFrameTiming timing;
+  timing.frame_id_ = received.frame_id_;
+  timing.timestamp_us_ = frame.timestamp_us();
+  timing.ntp_time_ms_ = frame.ntp_time_ms();
+  timing.received_time_us_ = received_time_us;
+  timing.rtp_timestamp_ = frame.timestamp();
+
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer(
       frame.video_frame_buffer());
 
   const int width = frame.width();
   const int height = frame.height();
 
+  I420AVideoFrame i420a_frame;
+  i420a_frame.width_ = width;
+  i420a_frame.height_ = height;
+  i420a_frame.timing_ = timing;
+
+  // Keep the I420 buffer alive until all callbacks returned.
+  rtc::scoped_refptr<webrtc::I420BufferInterface> i420_buffer;
   if (buffer->type() != webrtc::VideoFrameBuffer::Type::kI420A) {
     // The buffer is not encoded in I420 with alpha channel; use I420 without
     // alpha channel as interchange format for the callback, and convert the
     // buffer to that (or do nothing if already in I420).
-    rtc::scoped_refptr<webrtc::I420BufferInterface> i420_buffer =
-        buffer->ToI420();
-    const uint8_t* const yptr = i420_buffer->DataY();
-    const uint8_t* const uptr = i420_buffer->DataU();
-    const uint8_t* const vptr = i420_buffer->DataV();
-
-    if (i420a_callback_) {
-      I420AVideoFrame i420a_frame;
-      i420a_frame.ydata_ = yptr;
-      i420a_frame.udata_ = uptr;
-      i420a_frame.vdata_ = vptr;
-      i420a_frame.adata_ = nullptr;
-      i420a_frame.ystride_ = i420_buffer->StrideY();
-      i420a_frame.ustride_ = i420_buffer->StrideU();
-      i420a_frame.vstride_ = i420_buffer->StrideV();
-      i420a_frame.astride_ = 0;
-      i420a_frame.width_ = width;
-      i420a_frame.height_ = height;
-      i420a_callback_(i420a_frame);
-    }
-
-    if (argb_callback_) {
-      ArgbBuffer* const argb_buffer = GetArgbScratchBuffer(width, height);
-      libyuv::I420ToARGB(yptr, i420_buffer->StrideY(), uptr,
-                         i420_buffer->StrideU(), vptr, i420_buffer->StrideV(),
-                         argb_buffer->Data(), argb_buffer->Stride(), width,
-                         height);
-      Argb32VideoFrame argb32_frame;
-      argb32_frame.argb32_data_ = argb_buffer->Data();
-      argb32_frame.stride_ = argb_buffer->Stride();
-      argb32_frame.width_ = width;
-      argb32_frame.height_ = height;
-      argb_callback_(argb32_frame);
-    }
-
+    i420_buffer = buffer->ToI420();
+    i420a_frame.ydata_ = i420_buffer->DataY();
+    i420a_frame.udata_ = i420_buffer->DataU();
+    i420a_frame.vdata_ = i420_buffer->DataV();
+    i420a_frame.adata_ = nullptr;
+    i420a_frame.ystride_ = i420_buffer->StrideY();
+    i420a_frame.ustride_ = i420_buffer->StrideU();
+    i420a_frame.vstride_ = i420_buffer->StrideV();
+    i420a_frame.astride_ = 0;
+    i420a_frame.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(i420_buffer.get());
   } else {
     // The buffer is encoded in I420 with alpha channel, use it directly.
     webrtc::I420ABufferInterface* i420a_buffer = buffer->GetI420A();
-    const uint8_t* const yptr = i420a_buffer->DataY();
-    const uint8_t* const uptr = i420a_buffer->DataU();
-    const uint8_t* const vptr = i420a_buffer->DataV();
-    const uint8_t* const aptr = i420a_buffer->DataA();
-
-    if (i420a_callback_) {
-      I420AVideoFrame i420a_frame;
-      i420a_frame.ydata_ = yptr;
-      i420a_frame.udata_ = uptr;
-      i420a_frame.vdata_ = vptr;
-      i420a_frame.adata_ = aptr;
-      i420a_frame.ystride_ = i420a_buffer->StrideY();
-      i420a_frame.ustride_ = i420a_buffer->StrideU();
-      i420a_frame.vstride_ = i420a_buffer->StrideV();
-      i420a_frame.astride_ = i420a_buffer->StrideA();
-      i420a_frame.width_ = width;
-      i420a_frame.height_ = height;
-      i420a_callback_(i420a_frame);
+    i420a_frame.ydata_ = i420a_buffer->DataY();
+    i420a_frame.udata_ = i420a_buffer->DataU();
+    i420a_frame.vdata_ = i420a_buffer->DataV();
+    i420a_frame.adata_ = i420a_buffer->DataA();
+    i420a_frame.ystride_ = i420a_buffer->StrideY();
+    i420a_frame.ustride_ = i420a_buffer->StrideU();
+    i420a_frame.vstride_ = i420a_buffer->StrideV();
+    i420a_frame.astride_ = i420a_buffer->StrideA();
+    i420a_frame.buffer_handle_ = buffer.get();
+  }
+
+  // Frames scaled down for callbacks with a target size, shared by all the
+  // callbacks with the same output size.
+  struct ScaledFrame {
+    rtc::scoped_refptr<webrtc::I420Buffer> buffer_;
+    I420AVideoFrame view_;
+  };
+  ScaledFrame scaled_frames[kVideoFrameFormatCount];
+  int scaled_frame_count = 0;
+
+  // Get the frame to deliver to the callback for |format|, scaled down to its
+  // target size if any.
+  auto get_source = [&](VideoFrameFormat format) -> const I420AVideoFrame* {
+    const int index = static_cast<int>(format);
+    const VideoFrameSize size =
+        FitFrameSize(width, height, callbacks->target_sizes_[index]);
+    if ((size.width_ == width) && (size.height_ == height)) {
+      return &i420a_frame;
     }
+    for (int i = 0; i < scaled_frame_count; ++i) {
+      const I420AVideoFrame& view = scaled_frames[i].view_;
+      if ((view.width_ == static_cast<uint32_t>(size.width_)) &&
+          (view.height_ == static_cast<uint32_t>(size.height_))) {
+        return &view;
+      }
+    }
+    rtc::scoped_refptr<webrtc::I420Buffer> scaled_buffer = AcquireBuffer(
+        scaled_buffer_pools_[index], size.width_, size.height_);
+    libyuv::I420Scale(
+        static_cast<const uint8_t*>(i420a_frame.ydata_), i420a_frame.ystride_,
+        static_cast<const uint8_t*>(i420a_frame.udata_), i420a_frame.ustride_,
+        static_cast<const uint8_t*>(i420a_frame.vdata_), i420a_frame.vstride_,
+        width, height, scaled_buffer->MutableDataY(), scaled_buffer->StrideY(),
+        scaled_buffer->MutableDataU(), scaled_buffer->StrideU(),
+        scaled_buffer->MutableDataV(), scaled_buffer->StrideV(), size.width_,
+        size.height_, libyuv::kFilterBox);
+    ScaledFrame& scaled = scaled_frames[scaled_frame_count++];
+    scaled.view_.width_ = size.width_;
+    scaled.view_.height_ = size.height_;
+    scaled.view_.timing_ = timing;
+    scaled.view_.ydata_ = scaled_buffer->DataY();
+    scaled.view_.udata_ = scaled_buffer->DataU();
+    scaled.view_.vdata_ = scaled_buffer->DataV();
+    scaled.view_.adata_ = nullptr;
+    scaled.view_.ystride_ = scaled_buffer->StrideY();
+    scaled.view_.ustride_ = scaled_buffer->StrideU();
+    scaled.view_.vstride_ = scaled_buffer->StrideV();
+    scaled.view_.astride_ = 0;
+    scaled.view_.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(scaled_buffer.get());
+    scaled.buffer_ = std::move(scaled_buffer);
+    return &scaled.view_;
+  };
 
-    if (argb_callback_) {
-      ArgbBuffer* const argb_buffer = GetArgbScratchBuffer(width, height);
-      libyuv::I420AlphaToARGB(
-          yptr, i420a_buffer->StrideY(), uptr, i420a_buffer->StrideU(), vptr,
-          i420a_buffer->StrideV(), aptr, i420a_buffer->StrideA(),
-          argb_buffer->Data(), argb_buffer->Stride(), width, height, 0);
+  if (callbacks->i420a_callback_) {
+    const I420AVideoFrame* const src = get_source(VideoFrameFormat::kI420A);
+    InvokeCallback(callbacks->i420a_callback_, *src, received_time_us);
+  }
+
+  const int parallelism =
+      conversion_parallelism_.load(std::memory_order_relaxed);
+
+  if (callbacks->argb_callback_ && callbacks->argb_destinations_) {
+    // Convert directly into the next free application buffer.
+    DestinationRing& ring = *callbacks->argb_destinations_;
+    const I420AVideoFrame* const src = get_source(VideoFrameFormat::kArgb32);
+    if ((ring.stride_ < static_cast<int>(src->width_) * 4) ||
+        (ring.size_ < static_cast<uint64_t>(ring.stride_) * src->height_)) {
+      if (!destinations_exhausted_.exchange(true, std::memory_order_relaxed)) {
+        RTC_LOG(LS_WARNING) << "Destination buffers too small for remote "
+                               "video frame of size "
+                            << src->width_ << "x" << src->height_
+                            << "; dropping frames.";
+      }
+    } else if (DestinationRing::Slot* slot = AcquireDestination(ring)) {
+      destinations_exhausted_.store(false, std::memory_order_relaxed);
+      ConvertI420AToArgb32(*src, slot->data_, ring.stride_, parallelism);
       Argb32VideoFrame argb32_frame;
-      argb32_frame.argb32_data_ = argb_buffer->Data();
-      argb32_frame.stride_ = argb_buffer->Stride();
-      argb32_frame.width_ = width;
-      argb32_frame.height_ = height;
-      argb_callback_(argb32_frame);
+      argb32_frame.argb32_data_ = slot->data_;
+      argb32_frame.stride_ = ring.stride_;
+      argb32_frame.width_ = src->width_;
+      argb32_frame.timing_ = timing;
+      argb32_frame.height_ = src->height_;
+      // The application owns the buffer, which is released explicitly with
+      // |ReleaseArgb32Destination()| instead of by reference counting.
+      argb32_frame.buffer_handle_ = nullptr;
+      InvokeCallback(callbacks->argb_callback_, argb32_frame, received_time_us);
+    } else if (!destinations_exhausted_.exchange(true,
+                                                 std::memory_order_relaxed)) {
+      RTC_LOG(LS_WARNING) << "All destination buffers in use; dropping "
+                             "remote video frames until one is released.";
     }
+  } else if (callbacks->argb_callback_) {
+    const I420AVideoFrame* const src = get_source(VideoFrameFormat::kArgb32);
+    rtc::scoped_refptr<ArgbBuffer> argb_buffer =
+        AcquireBuffer(argb_buffer_pool_, src->width_, src->height_);
+    ConvertI420AToArgb32(*src, argb_buffer->Data(), argb_buffer->Stride(),
+                         parallelism);
+    Argb32VideoFrame argb32_frame;
+    argb32_frame.argb32_data_ = argb_buffer->Data();
+    argb32_frame.stride_ = argb_buffer->Stride();
+    argb32_frame.width_ = src->width_;
+    argb32_frame.timing_ = timing;
+    argb32_frame.height_ = src->height_;
+    argb32_frame.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(argb_buffer.get());
+    InvokeCallback(callbacks->argb_callback_, argb32_frame, received_time_us);
+  }
+
+  if (callbacks->nv12_callback_) {
+    const I420AVideoFrame* const src = get_source(VideoFrameFormat::kNv12);
+    rtc::scoped_refptr<Nv12Buffer> nv12_buffer =
+        AcquireBuffer(nv12_buffer_pool_, src->width_, src->height_);
+    ConvertI420AToNv12(*src, nv12_buffer->MutableDataY(),
+                       nv12_buffer->StrideY(), nv12_buffer->MutableDataUV(),
+                       nv12_buffer->StrideUV(), parallelism);
+    Nv12VideoFrame nv12_frame;
+    nv12_frame.width_ = src->width_;
+    nv12_frame.timing_ = timing;
+    nv12_frame.height_ = src->height_;
+    nv12_frame.ydata_ = nv12_buffer->DataY();
+    nv12_frame.uvdata_ = nv12_buffer->DataUV();
+    nv12_frame.ystride_ = nv12_buffer->StrideY();
+    nv12_frame.uvstride_ = nv12_buffer->StrideUV();
+    nv12_frame.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(nv12_buffer.get());
+    InvokeCallback(callbacks->nv12_callback_, nv12_frame, received_time_us);
+  }
+
+  if (callbacks->rgba32_callback_) {
+    const I420AVideoFrame* const src = get_source(VideoFrameFormat::kRgba32);
+    rtc::scoped_refptr<Rgba32Buffer> rgba32_buffer =
+        AcquireBuffer(rgba32_buffer_pool_, src->width_, src->height_);
+    ConvertI420AToRgba32(*src, rgba32_buffer->Data(), rgba32_buffer->Stride(),
+                         parallelism);
+    Rgba32VideoFrame rgba32_frame;
+    rgba32_frame.width_ = src->width_;
+    rgba32_frame.timing_ = timing;
+    rgba32_frame.height_ = src->height_;
+    rgba32_frame.rgba32_data_ = rgba32_buffer->Data();
+    rgba32_frame.stride_ = rgba32_buffer->Stride();
+    rgba32_frame.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(rgba32_buffer.get());
+    InvokeCallback(callbacks->rgba32_callback_, rgba32_frame, received_time_us);
+  }
+
+  if (callbacks->bgr24_callback_) {
+    const I420AVideoFrame* const src = get_source(VideoFrameFormat::kBgr24);
+    rtc::scoped_refptr<Bgr24Buffer> bgr24_buffer =
+        AcquireBuffer(bgr24_buffer_pool_, src->width_, src->height_);
+    ConvertI420AToBgr24(*src, bgr24_buffer->Data(), bgr24_buffer->Stride(),
+                        parallelism);
+    Bgr24VideoFrame bgr24_frame;
+    bgr24_frame.width_ = src->width_;
+    bgr24_frame.timing_ = timing;
+    bgr24_frame.height_ = src->height_;
+    bgr24_frame.bgr24_data_ = bgr24_buffer->Data();
+    bgr24_frame.stride_ = bgr24_buffer->Stride();
+    bgr24_frame.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(bgr24_buffer.get());
+    InvokeCallback(callbacks->bgr24_callback_, bgr24_frame, received_time_us);
+  }
+
+  if (callbacks->i420_packed_callback_) {
+    // The pool allocates I420 buffers with the default strides, which are
+    // tightly packed, and the planes are contiguous in a single allocation.
+    const I420AVideoFrame* const src =
+        get_source(VideoFrameFormat::kI420Packed);
+    rtc::scoped_refptr<webrtc::I420Buffer> packed_buffer =
+        AcquireBuffer(i420_buffer_pool_, src->width_, src->height_);
+    RTC_DCHECK_EQ(packed_buffer->width(), packed_buffer->StrideY());
+    CopyI420AToI420(*src, packed_buffer->MutableDataY(),
+                    packed_buffer->StrideY(), packed_buffer->MutableDataU(),
+                    packed_buffer->StrideU(), packed_buffer->MutableDataV(),
+                    packed_buffer->StrideV(), parallelism);
+    const int chroma_size =
+        packed_buffer->StrideU() * packed_buffer->ChromaHeight();
+    I420PackedVideoFrame packed_frame;
+    packed_frame.width_ = src->width_;
+    packed_frame.timing_ = timing;
+    packed_frame.height_ = src->height_;
+    packed_frame.data_ = packed_buffer->DataY();
+    packed_frame.size_ =
+        static_cast<uint64_t>(src->width_) * src->height_ + 2 * chroma_size;
+    packed_frame.buffer_handle_ =
+        static_cast<webrtc::VideoFrameBuffer*>(packed_buffer.get());
+    InvokeCallback(callbacks->i420_packed_callback_, packed_frame,
+                   received_time_us);
+  }
+}
+
+namespace {
+
+/// Source I420A plane pointers for a stripe of rows of a frame.
+struct I420AStripe {
+  const uint8_t* y;
+  const uint8_t* u;
+  const uint8_t* v;
+  const uint8_t* a;
+  int first_row;
+  int row_count;
+};
+
+/// Invoke |func(stripe)| for each stripe of rows of |src|, in parallel on the
+/// global worker pool if |max_parallelism| is greater than 1. Stripes always
+/// start on an even row so the chroma row offset is exact, which makes the
+/// result independent of the stripe split.
+template <typename Func>
+void ForEachStripe(const I420AVideoFrame& src,
+                   int max_parallelism,
+                   Func&& func) noexcept {
+  auto process_rows = [&src, &func](int first_row, int row_count) {
+    RTC_DCHECK_EQ(0, first_row % 2);
+    const int chroma_row = first_row / 2;
+    I420AStripe stripe;
+    stripe.y =
+        static_cast<const uint8_t*>(src.ydata_) + first_row * src.ystride_;
+    stripe.u =
+        static_cast<const uint8_t*>(src.udata_) + chroma_row * src.ustride_;
+    stripe.v =
+        static_cast<const uint8_t*>(src.vdata_) + chroma_row * src.vstride_;
+    stripe.a = (src.adata_ ? static_cast<const uint8_t*>(src.adata_) +
+                                 first_row * src.astride_
+                           : nullptr);
+    stripe.first_row = first_row;
+    stripe.row_count = row_count;
+    func(stripe);
+  };
+  const int height = static_cast<int>(src.height_);
+  if (max_parallelism <= 1) {
+    process_rows(0, height);
+    return;
   }
+  WorkerPool* const pool = GlobalFactory::Instance()->GetOrCreateWorkerPool();
+  pool->ParallelForRows(height, max_parallelism, kMinRowsPerConversionStripe,
+                        process_rows);
+}
+
+}  // namespace
+
+void ConvertI420AToArgb32(const I420AVideoFrame& src,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int max_parallelism) noexcept {
+  const int width = static_cast<int>(src.width_);
+  ForEachStripe(src, max_parallelism, [&](const I420AStripe& stripe) {
+    uint8_t* const dst_row = dst + stripe.first_row * dst_stride;
+    if (stripe.a) {
+      libyuv::I420AlphaToARGB(stripe.y, src.ystride_, stripe.u, src.ustride_,
+                              stripe.v, src.vstride_, stripe.a, src.astride_,
+                              dst_row, dst_stride, width, stripe.row_count, 0);
+    } else {
+      libyuv::I420ToARGB(stripe.y, src.ystride_, stripe.u, src.ustride_,
+                         stripe.v, src.vstride_, dst_row, dst_stride, width,
+                         stripe.row_count);
+    }
+  });
+}
+
+void ConvertI420AToRgba32(const I420AVideoFrame& src,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int max_parallelism) noexcept {
+  const int width = static_cast<int>(src.width_);
+  ForEachStripe(src, max_parallelism, [&](const I420AStripe& stripe) {
+    // libyuv names formats after the order of a little endian 32-bit word, so
+    // its "ABGR" is RGBA in memory byte order.
+    uint8_t* const dst_row = dst + stripe.first_row * dst_stride;
+    if (stripe.a) {
+      libyuv::I420AlphaToABGR(stripe.y, src.ystride_, stripe.u, src.ustride_,
+                              stripe.v, src.vstride_, stripe.a, src.astride_,
+                              dst_row, dst_stride, width, stripe.row_count, 0);
+    } else {
+      libyuv::I420ToABGR(stripe.y, src.ystride_, stripe.u, src.ustride_,
+                         stripe.v, src.vstride_, dst_row, dst_stride, width,
+                         stripe.row_count);
+    }
+  });
+}
+
+void ConvertI420AToBgr24(const I420AVideoFrame& src,
+                         uint8_t* dst,
+                         int dst_stride,
+                         int max_parallelism) noexcept {
+  const int width = static_cast<int>(src.width_);
+  ForEachStripe(src, max_parallelism, [&](const I420AStripe& stripe) {
+    // libyuv "RGB24" is BGR in memory byte order.
+    libyuv::I420ToRGB24(stripe.y, src.ystride_, stripe.u, src.ustride_,
+                        stripe.v, src.vstride_,
+                        dst + stripe.first_row * dst_stride, dst_stride, width,
+                        stripe.row_count);
+  });
+}
+
+void ConvertI420AToNv12(const I420AVideoFrame& src,
+                        uint8_t* dst_y,
+                        int dst_stride_y,
+                        uint8_t* dst_uv,
+                        int dst_stride_uv,
+                        int max_parallelism) noexcept {
+  const int width = static_cast<int>(src.width_);
+  ForEachStripe(src, max_parallelism, [&](const I420AStripe& stripe) {
+    libyuv::I420ToNV12(stripe.y, src.ystride_, stripe.u, src.ustride_,
+                       stripe.v, src.vstride_,
+                       dst_y + stripe.first_row * dst_stride_y, dst_stride_y,
+                       dst_uv + (stripe.first_row / 2) * dst_stride_uv,
+                       dst_stride_uv, width, stripe.row_count);
+  });
+}
+
+void CopyI420AToI420(const I420AVideoFrame& src,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int max_parallelism) noexcept {
+  const int width = static_cast<int>(src.width_);
+  ForEachStripe(src, max_parallelism, [&](const I420AStripe& stripe) {
+    const int chroma_row = stripe.first_row / 2;
+    libyuv::I420Copy(stripe.y, src.ystride_, stripe.u, src.ustride_, stripe.v,
+                     src.vstride_, dst_y + stripe.first_row * dst_stride_y,
+                     dst_stride_y, dst_u + chroma_row * dst_stride_u,
+                     dst_stride_u, dst_v + chroma_row * dst_stride_v,
+                     dst_stride_v, width, stripe.row_count);
+  });
 }
 
 }  // namespace Microsoft::MixedReality::WebRTC
@@ -3,13 +3,20 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
+#include "api/video/video_source_interface.h"
 
 #include "callback.h"
+#include "frame_mailbox.h"
+#include "latency_histogram.h"
+#include "result.h"
 #include "video_frame.h"
+#include "video_frame_buffer_pool.h"
 
 #include "rtc_base/memory/aligned_malloc.h"
 
@@ -21,14 +28,89 @@ using I420AFrameReadyCallback = Callback<const I420AVideoFrame&>;
 /// Callback fired on newly available video frame, encoded as ARGB.
 using Argb32FrameReadyCallback = Callback<const Argb32VideoFrame&>;
 
+/// Callback fired on newly available video frame, encoded as NV12.
+using Nv12FrameReadyCallback = Callback<const Nv12VideoFrame&>;
+
+/// Callback fired on newly available video frame, encoded as RGBA.
+using Rgba32FrameReadyCallback = Callback<const Rgba32VideoFrame&>;
+
+/// Callback fired on newly available video frame, encoded as BGR24.
+using Bgr24FrameReadyCallback = Callback<const Bgr24VideoFrame&>;
+
+/// Callback fired on newly available video frame, encoded as I420 packed in a
+/// single contiguous memory block.
+using I420PackedFrameReadyCallback = Callback<const I420PackedVideoFrame&>;
+
+/// Number of values of |VideoFrameFormat|.
+constexpr int kVideoFrameFormatCount = 6;
+
+/// Dimensions of a video frame, in pixels.
+struct VideoFrameSize {
+  int width_{0};
+  int height_{0};
+};
+
+/// Compute the dimensions of a |width| x |height| frame downscaled to fit into
+/// |target| while preserving its aspect ratio. Frames are never upscaled, and
+/// a |target| with a zero dimension leaves the frame size unchanged. The
+/// result is rounded down to even dimensions to keep chroma planes aligned.
+VideoFrameSize FitFrameSize(int width,
+                            int height,
+                            VideoFrameSize target) noexcept;
+
 /// Helper function to calculate the minimum size of an ARGB32 frame given its
 /// dimensions in pixels.
 constexpr inline size_t Argb32FrameSize(int width, int height) {
   return (static_cast<size_t>(height) * width) * 4;
 }
 
-// Plain 32-bit ARGB buffer in standard memory.
-class ArgbBuffer : public webrtc::VideoFrameBuffer {
+/// Single-plane buffer of packed RGB pixels in standard memory, with
+/// |bytes_per_pixel| bytes per pixel. Buffers are reference-counted and can be
+/// retained by consumers via the opaque handle exposed in the
+/// |buffer_handle_| field of the frame views.
+class PackedRgbBuffer : public webrtc::VideoFrameBuffer {
+ public:
+  // VideoFrameBuffer implementation.
+
+  inline Type type() const override { return VideoFrameBuffer::Type::kNative; }
+  inline int width() const override { return width_; }
+  inline int height() const override { return height_; }
+
+  inline uint8_t* Data() { return data_.get(); }
+  inline const uint8_t* Data() const { return data_.get(); }
+
+  /// Row stride, in bytes.
+  inline constexpr int Stride() const { return stride_; }
+
+  /// Total buffer size, in bytes.
+  inline constexpr size_t Size() const {
+    return static_cast<size_t>(height_) * stride_;
+  }
+
+ protected:
+  PackedRgbBuffer(int width,
+                  int height,
+                  int stride,
+                  int bytes_per_pixel) noexcept;
+  ~PackedRgbBuffer() override = default;
+
+ private:
+  /// Frame width, in pixels.
+  const int width_;
+
+  /// Frame height, in pixels.
+  const int height_;
+
+  /// Row stride, in bytes. This is always >= (bytes_per_pixel * width_).
+  const int stride_;
+
+  /// Raw buffer of pixel data for the frame.
+  const std::unique_ptr<uint8_t, webrtc::AlignedFreeDeleter> data_;
+};
+
+/// Plain 32-bit ARGB buffer in standard memory, in little endian order (B
+/// first, A last).
+class ArgbBuffer : public PackedRgbBuffer {
  public:
   // Create a new buffer with enough storage for a frame with the given
   // width and height in pixels.
@@ -61,25 +143,95 @@ class ArgbBuffer : public webrtc::VideoFrameBuffer {
 
   // VideoFrameBuffer implementation.
 
+  rtc::scoped_refptr<webrtc::I420BufferInterface> ToI420() override;
+
+ protected:
+  ArgbBuffer(int width, int height) noexcept
+      : ArgbBuffer(width, height, width * 4) {}
+  ArgbBuffer(int width, int height, int stride) noexcept
+      : PackedRgbBuffer(width, height, stride, 4) {}
+  ~ArgbBuffer() override = default;
+};
+
+/// Plain 32-bit RGBA buffer in standard memory, in byte order (R first, A
+/// last). This is the "ABGR" format in libyuv terminology.
+class Rgba32Buffer : public PackedRgbBuffer {
+ public:
+  static inline rtc::scoped_refptr<Rgba32Buffer> Create(int width,
+                                                        int height) {
+    return new rtc::RefCountedObject<Rgba32Buffer>(width, height);
+  }
+
+  // VideoFrameBuffer implementation.
+
+  rtc::scoped_refptr<webrtc::I420BufferInterface> ToI420() override;
+
+ protected:
+  Rgba32Buffer(int width, int height) noexcept
+      : PackedRgbBuffer(width, height, width * 4, 4) {}
+  ~Rgba32Buffer() override = default;
+};
+
+/// Plain 24-bit BGR buffer in standard memory, in byte order (B first, R
+/// last). This is the "RGB24" format in libyuv terminology.
+class Bgr24Buffer : public PackedRgbBuffer {
+ public:
+  static inline rtc::scoped_refptr<Bgr24Buffer> Create(int width,
+                                                       int height) {
+    return new rtc::RefCountedObject<Bgr24Buffer>(width, height);
+  }
+
+  // VideoFrameBuffer implementation.
+
+  rtc::scoped_refptr<webrtc::I420BufferInterface> ToI420() override;
+
+ protected:
+  Bgr24Buffer(int width, int height) noexcept
+      : PackedRgbBuffer(width, height, width * 3, 3) {}
+  ~Bgr24Buffer() override = default;
+};
+
+/// NV12 buffer in standard memory, with a full-resolution Y plane followed by
+/// a half-resolution plane of interleaved U and V samples. Both planes are
+/// tightly packed and contiguous, so the whole frame is a single block of
+/// |Size()| bytes starting at |DataY()|.
+class Nv12Buffer : public webrtc::VideoFrameBuffer {
+ public:
+  static inline rtc::scoped_refptr<Nv12Buffer> Create(int width, int height) {
+    return new rtc::RefCountedObject<Nv12Buffer>(width, height);
+  }
+
+  // VideoFrameBuffer implementation.
+
   inline Type type() const override { return VideoFrameBuffer::Type::kNative; }
   inline int width() const override { return width_; }
   inline int height() const override { return height_; }
   rtc::scoped_refptr<webrtc::I420BufferInterface> ToI420() override;
 
-  inline uint8_t* Data() { return data_.get(); }
-  inline const uint8_t* Data() const { return data_.get(); }
+  inline uint8_t* MutableDataY() { return data_.get(); }
+  inline const uint8_t* DataY() const { return data_.get(); }
+  inline uint8_t* MutableDataUV() {
+    return data_.get() + static_cast<size_t>(stride_y_) * height_;
+  }
+  inline const uint8_t* DataUV() const {
+    return data_.get() + static_cast<size_t>(stride_y_) * height_;
+  }
 
-  /// Row stride, in bytes.
-  inline constexpr int Stride() const { return stride_; }
+  /// Row stride of the Y plane, in bytes.
+  inline constexpr int StrideY() const { return stride_y_; }
+
+  /// Row stride of the interleaved UV plane, in bytes.
+  inline constexpr int StrideUV() const { return stride_uv_; }
 
   /// Total buffer size, in bytes.
   inline constexpr size_t Size() const {
-    return static_cast<size_t>(height_) * stride_;
+    return static_cast<size_t>(stride_y_) * height_ +
+           static_cast<size_t>(stride_uv_) * ((height_ + 1) / 2);
   }
 
  protected:
-  ArgbBuffer(int width, int height, int stride) noexcept;
-  ~ArgbBuffer() override = default;
+  Nv12Buffer(int width, int height) noexcept;
+  ~Nv12Buffer() override = default;
 
  private:
   /// Frame width, in pixels.
@@ -88,49 +240,381 @@ class ArgbBuffer : public webrtc::VideoFrameBuffer {
   /// Frame height, in pixels.
   const int height_;
 
-  /// Row stride, in pixels. This is always >= (4 * width_).
-  const int stride_;
+  /// Row stride of the Y plane, in bytes.
+  const int stride_y_;
+
+  /// Row stride of the UV plane, in bytes.
+  const int stride_uv_;
 
-  /// Raw buffer of ARGB32 data for the frame.
+  /// Raw buffer holding both planes.
   const std::unique_ptr<uint8_t, webrtc::AlignedFreeDeleter> data_;
 };
 
+/// Convert an I420 frame, with or without alpha plane, into the given ARGB32
+/// destination buffer. When |max_parallelism| is greater than 1, the frame is
+/// split into horizontal stripes converted in parallel on the worker pool of
+/// the |GlobalFactory|, using the same libyuv kernels as the single-threaded
+/// path, so the output is bit-identical.
+void ConvertI420AToArgb32(const I420AVideoFrame& src,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int max_parallelism) noexcept;
+
+/// Same as |ConvertI420AToArgb32()|, for RGBA32 output (R first, A last).
+void ConvertI420AToRgba32(const I420AVideoFrame& src,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int max_parallelism) noexcept;
+
+/// Same as |ConvertI420AToArgb32()|, for BGR24 output. The alpha plane of
+/// the source frame, if any, is ignored.
+void ConvertI420AToBgr24(const I420AVideoFrame& src,
+                         uint8_t* dst,
+                         int dst_stride,
+                         int max_parallelism) noexcept;
+
+/// Same as |ConvertI420AToArgb32()|, for NV12 output. The alpha plane of the
+/// source frame, if any, is ignored.
+void ConvertI420AToNv12(const I420AVideoFrame& src,
+                        uint8_t* dst_y,
+                        int dst_stride_y,
+                        uint8_t* dst_uv,
+                        int dst_stride_uv,
+                        int max_parallelism) noexcept;
+
+/// Same as |ConvertI420AToArgb32()|, copying the Y, U, and V planes into the
+/// given I420 destination planes. The alpha plane of the source frame, if any,
+/// is ignored.
+void CopyI420AToI420(const I420AVideoFrame& src,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int max_parallelism) noexcept;
+
+/// Pool of ARGB32 buffers used to deliver converted frames without per-frame
+/// allocation.
+using ArgbBufferPool = VideoFrameBufferPool<ArgbBuffer>;
+
 /// Video frame observer to get notified of newly available video frames.
+///
+/// Frame delivery in |OnFrame()| is lock-free: the registered callbacks are
+/// stored in an immutable snapshot which |SetCallback()| replaces atomically,
+/// so the WebRTC decoder thread never blocks on the application thread
+/// changing callbacks, and vice versa. Retiring a snapshot waits until all
+/// in-flight deliveries which may still reference it have returned.
+///
+/// Frames are delivered in each of the formats for which a callback is
+/// registered. Conversions are done in a single pass from the decoded I420
+/// frame into pooled destination buffers, so there is no per-frame allocation
+/// in steady state.
 class VideoFrameObserver : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
  public:
+  VideoFrameObserver() noexcept = default;
+  ~VideoFrameObserver() noexcept override;
+
   /// Register a callback to get notified on frame available,
   /// and received that frame as a I420-encoded buffer.
-  /// This is not exclusive and can be used along another ARGB callback.
+  /// This is not exclusive and can be used along other callbacks.
+  /// On return, the previous callback is guaranteed not to be invoked anymore.
+  /// This must not be called from inside a frame callback.
   void SetCallback(I420AFrameReadyCallback callback) noexcept;
 
   /// Register a callback to get notified on frame available,
   /// and received that frame as a raw decoded ARGB buffer.
-  /// This is not exclusive and can be used along another I420 callback.
+  /// This is not exclusive and can be used along other callbacks.
+  /// On return, the previous callback is guaranteed not to be invoked anymore.
+  /// This must not be called from inside a frame callback.
   void SetCallback(Argb32FrameReadyCallback callback) noexcept;
 
+  /// Same as |SetCallback(Argb32FrameReadyCallback)|, for NV12 frames.
+  void SetCallback(Nv12FrameReadyCallback callback) noexcept;
+
+  /// Same as |SetCallback(Argb32FrameReadyCallback)|, for RGBA32 frames.
+  void SetCallback(Rgba32FrameReadyCallback callback) noexcept;
+
+  /// Same as |SetCallback(Argb32FrameReadyCallback)|, for BGR24 frames.
+  void SetCallback(Bgr24FrameReadyCallback callback) noexcept;
+
+  /// Same as |SetCallback(Argb32FrameReadyCallback)|, for I420 frames packed
+  /// in a single contiguous memory block.
+  void SetCallback(I420PackedFrameReadyCallback callback) noexcept;
+
+  /// Set the maximum number of threads used to convert a single frame,
+  /// including the calling thread. The default of 1 converts frames on the
+  /// thread delivering them. Larger values split the conversion of large
+  /// frames across the shared worker pool, reducing the delivery latency of
+  /// high resolution frames at the expense of more CPU cores.
+  void SetConversionParallelism(int max_parallelism) noexcept;
+
+  /// Set the maximum dimensions of the frames delivered to the callback for
+  /// |format|. Larger frames are downscaled with |libyuv::I420Scale()| before
+  /// being converted, preserving their aspect ratio, so callbacks for small
+  /// views only pay for the pixels they display. Callbacks with the same
+  /// output size share a single scaled frame. A zero |width| or |height|
+  /// delivers frames at their decoded resolution, which is the default.
+  /// Scaled frames have no alpha plane.
+  Result SetCallbackTargetSize(VideoFrameFormat format,
+                               int width,
+                               int height) noexcept;
+
+  /// Get the sink wants to use when adding the observer to a video track. If
+  /// all registered callbacks have a target size, |max_pixel_count| is set to
+  /// the largest of them, so that the source can lower its resolution.
+  rtc::VideoSinkWants GetSinkWants() noexcept;
+
+  /// Set the delivery mode of the frames to the callbacks. In polled mode,
+  /// |OnFrame()| only stores the latest frame, without any conversion, and
+  /// returns immediately; the frame is converted and delivered when the
+  /// application calls |PollFrame()|. Switching back to inline mode drops the
+  /// pending frame, if any.
+  void SetDeliveryMode(VideoFrameDeliveryMode mode) noexcept;
+
+  /// In polled delivery mode, deliver the latest frame received since the
+  /// previous call, if any, to the registered callbacks on the calling thread.
+  /// Return |true| if a frame was delivered. Older frames received in between
+  /// are skipped without being converted.
+  bool PollFrame() noexcept;
+
+  /// Number of frames skipped in polled delivery mode because a newer frame
+  /// was received before they were polled.
+  uint64_t skipped_frame_count() const noexcept {
+    return skipped_frame_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Get the latency statistics of the frames delivered since the observer
+  /// was created or the statistics were last reset.
+  void GetLatencyStats(VideoFrameLatencyStats& stats) const noexcept;
+
+  /// Reset the latency statistics returned by |GetLatencyStats()|.
+  void ResetLatencyStats() noexcept;
+
+  /// Register a ring of |count| application-owned destination buffers of
+  /// |size| bytes each, into which frames for the ARGB32 callback are
+  /// converted directly with the given row |stride|, instead of into an
+  /// internal buffer. This allows converting into memory the application
+  /// consumes directly, like a persistently mapped staging buffer, without
+  /// any extra copy. Each buffer passed to the callback is reserved until
+  /// released with |ReleaseArgb32Destination()|; frames arriving while all
+  /// buffers are reserved, or which do not fit into a buffer, are dropped.
+  /// Passing a |count| of zero reverts to internal buffers. The buffers must
+  /// remain valid until unregistered, and on return the previous buffers are
+  /// guaranteed not to be written to anymore.
+  Result SetArgb32Destinations(void* const* buffers,
+                               int count,
+                               uint64_t size,
+                               int stride) noexcept;
+
+  /// Release a destination buffer registered with |SetArgb32Destinations()|
+  /// and reserved by a frame delivery, so that it can receive a new frame.
+  Result ReleaseArgb32Destination(const void* buffer) noexcept;
+
  protected:
-  /// Get a temporary scratch buffer for an ARGB32 frame of the given
-  /// dimensions. The returned buffer does not need to be deallocated, but can
-  /// be reused by a later call so concurrent access is not supported.
-  /// Before calling this method the caller needs to acquire |mutex_|, and keep
-  /// it for the duration of its access.
-  ArgbBuffer* GetArgbScratchBuffer(int width, int height);
+  /// Application-owned destination buffers for ARGB32 frames.
+  struct DestinationRing {
+    struct Slot {
+      uint8_t* data_;
+      /// Set while the buffer holds a frame not released by the application.
+      std::atomic_bool in_use_{false};
+    };
+    DestinationRing(int count, uint64_t size, int stride)
+        : slots_(new Slot[count]),
+          count_(count),
+          size_(size),
+          stride_(stride) {}
+    std::unique_ptr<Slot[]> slots_;
+    const int count_;
+    /// Size of each buffer, in bytes.
+    const uint64_t size_;
+    /// Row stride of the frames converted into the buffers, in bytes.
+    const int stride_;
+    /// Index of the slot following the last one used, to cycle through the
+    /// ring in order.
+    std::atomic<int> next_slot_{0};
+  };
+
+  /// Immutable snapshot of all the callbacks registered on the observer.
+  struct CallbackSet {
+    /// Registered callback for receiving I420-encoded frame.
+    I420AFrameReadyCallback i420a_callback_;
+
+    /// Registered callback for receiving raw decoded ARGB frame.
+    Argb32FrameReadyCallback argb_callback_;
+
+    /// Registered callback for receiving NV12 frame.
+    Nv12FrameReadyCallback nv12_callback_;
+
+    /// Registered callback for receiving RGBA32 frame.
+    Rgba32FrameReadyCallback rgba32_callback_;
+
+    /// Registered callback for receiving BGR24 frame.
+    Bgr24FrameReadyCallback bgr24_callback_;
+
+    /// Registered callback for receiving packed I420 frame.
+    I420PackedFrameReadyCallback i420_packed_callback_;
+
+    /// Optional application-owned destination buffers for
+    /// |argb_callback_|. Shared between snapshots, since reservations must
+    /// survive callback changes.
+    std::shared_ptr<DestinationRing> argb_destinations_;
+
+    /// Maximum dimensions of the frames delivered to each callback, indexed
+    /// by |VideoFrameFormat|. Zero means the decoded frame size.
+    VideoFrameSize target_sizes_[kVideoFrameFormatCount];
+
+    /// Check if a callback is registered for |format|.
+    bool has_callback(VideoFrameFormat format) const noexcept;
+
+    /// Check if at least one callback is registered.
+    constexpr bool empty() const noexcept {
+      return (!i420a_callback_ && !argb_callback_ && !nv12_callback_ &&
+              !rgba32_callback_ && !bgr24_callback_ && !i420_packed_callback_);
+    }
+  };
+
+  /// Frame received by the observer, with the metadata assigned on receipt.
+  struct ReceivedFrame {
+    webrtc::VideoFrame frame_;
+    std::int64_t frame_id_;
+    std::int64_t received_time_us_;
+  };
+
+  /// RAII helper pinning the current callback snapshot for the duration of a
+  /// frame delivery. While alive, the snapshot returned by |get()| cannot be
+  /// destroyed by a concurrent |SetCallback()|.
+  class CallbackReadScope {
+   public:
+    explicit CallbackReadScope(VideoFrameObserver& observer) noexcept;
+    ~CallbackReadScope() noexcept;
+    const CallbackSet* get() const noexcept { return callbacks_; }
+
+   private:
+    VideoFrameObserver& observer_;
+    std::atomic<int>* readers_;
+    const CallbackSet* callbacks_;
+  };
+
+  /// Get an ARGB32 buffer of the given dimensions from the internal pool,
+  /// exclusively owned by the caller until released. The buffer is recycled
+  /// for a later frame once all references to it are released, including the
+  /// ones taken by consumers retaining the frame. If the pool is exhausted
+  /// because consumers retain too many frames, return a temporary buffer
+  /// which is not recycled instead.
+  rtc::scoped_refptr<ArgbBuffer> AcquireArgbBuffer(int width,
+                                                   int height) noexcept;
+
+  /// Reserve the next free slot of |ring|, or return |nullptr| if all slots
+  /// are in use.
+  static DestinationRing::Slot* AcquireDestination(
+      DestinationRing& ring) noexcept;
+
+  /// Same as |AcquireArgbBuffer()|, for any pool of the observer.
+  template <typename T>
+  rtc::scoped_refptr<T> AcquireBuffer(VideoFrameBufferPool<T>& pool,
+                                      int width,
+                                      int height) noexcept;
+
+  /// Replace the current callback snapshot with a copy modified by |updater|,
+  /// then wait for the in-flight deliveries of the previous epoch to release
+  /// the previous snapshot before destroying it.
+  template <typename Updater>
+  void UpdateCallbacks(Updater&& updater) noexcept;
 
   // VideoSinkInterface interface
   void OnFrame(const webrtc::VideoFrame& frame) noexcept override;
 
+  /// Convert |received.frame_| and deliver it to the registered callbacks on
+  /// the calling thread.
+  void DeliverFrame(const ReceivedFrame& received) noexcept;
+
+  /// Invoke |callback| with |frame|, recording the latency statistics of the
+  /// frame received at |received_time_us|.
+  template <typename CallbackT, typename FrameT>
+  void InvokeCallback(const CallbackT& callback,
+                      const FrameT& frame,
+                      std::int64_t received_time_us) noexcept;
+
  private:
-  /// Registered callback for receiving I420-encoded frame.
-  I420AFrameReadyCallback i420a_callback_ RTC_GUARDED_BY(mutex_);
+  /// Current immutable snapshot of the registered callbacks, or |nullptr| if
+  /// none was ever registered. Owned by the observer.
+  std::atomic<const CallbackSet*> callbacks_{nullptr};
+
+  /// Epoch of |callbacks_|, incremented by each writer after publishing a new
+  /// snapshot. Only the parity is used to select a reader counter.
+  std::atomic<unsigned int> callback_epoch_{0};
 
-  /// Registered callback for receiving raw decoded ARGB frame.
-  Argb32FrameReadyCallback argb_callback_ RTC_GUARDED_BY(mutex_);
+  /// Number of frame deliveries currently reading |callbacks_|, per epoch
+  /// parity. A writer only waits for the readers of the epoch it retires, so
+  /// readers entering the new epoch cannot starve it.
+  std::atomic<int> callback_readers_[2]{};
 
-  /// Mutex protecting all callbacks as well as the ARGB32 scratch buffer.
+  /// Mutex serializing writers of |callbacks_|. Never acquired by
+  /// |OnFrame()|.
   std::mutex mutex_;
 
-  /// Reusable ARGB scratch buffer to avoid per-frame allocation.
-  rtc::scoped_refptr<ArgbBuffer> argb_scratch_buffer_ RTC_GUARDED_BY(mutex_);
+  /// Flag guarding exclusive access to the buffer pools when the observer
+  /// receives frames from multiple threads, e.g. when used as sink for
+  /// multiple tracks at once. This is only held while acquiring a buffer, not
+  /// during conversion.
+  std::atomic_flag buffer_pools_in_use_ = ATOMIC_FLAG_INIT;
+
+  /// Current |VideoFrameDeliveryMode|.
+  std::atomic<VideoFrameDeliveryMode> delivery_mode_{
+      VideoFrameDeliveryMode::kInline};
+
+  /// Latest frame received in polled delivery mode and not polled yet.
+  FrameMailbox<ReceivedFrame> mailbox_;
+
+  /// Flag serializing producers of |mailbox_| when the observer receives
+  /// frames from multiple threads. A frame arriving while another one is
+  /// being posted is dropped instead of waiting.
+  std::atomic_flag mailbox_posting_ = ATOMIC_FLAG_INIT;
+
+  /// Mutex serializing consumers of |mailbox_|. Never acquired by
+  /// |OnFrame()|.
+  std::mutex mailbox_poll_mutex_;
+
+  /// Number of frames skipped in polled delivery mode.
+  std::atomic<uint64_t> skipped_frame_count_{0};
+
+  /// Identifier of the last frame received.
+  std::atomic<std::int64_t> last_frame_id_{0};
+
+  /// Time from receiving a frame to invoking a callback with it.
+  LatencyHistogram delivery_latency_;
+
+  /// Time spent in the callbacks.
+  LatencyHistogram callback_latency_;
+
+  /// Maximum number of threads used to convert a frame.
+  std::atomic<int> conversion_parallelism_{1};
+
+  /// Pool of ARGB32 buffers to avoid per-frame allocation.
+  ArgbBufferPool argb_buffer_pool_;
+
+  /// Pool of NV12 buffers to avoid per-frame allocation.
+  VideoFrameBufferPool<Nv12Buffer> nv12_buffer_pool_;
+
+  /// Pool of RGBA32 buffers to avoid per-frame allocation.
+  VideoFrameBufferPool<Rgba32Buffer> rgba32_buffer_pool_;
+
+  /// Pool of BGR24 buffers to avoid per-frame allocation.
+  VideoFrameBufferPool<Bgr24Buffer> bgr24_buffer_pool_;
+
+  /// Pool of packed I420 buffers to avoid per-frame allocation.
+  VideoFrameBufferPool<webrtc::I420Buffer> i420_buffer_pool_;
+
+  /// Pools of I420 buffers holding frames scaled down to the target size of
+  /// each callback, indexed by |VideoFrameFormat|. Separate pools avoid
+  /// evicting buffers when callbacks have different target sizes.
+  VideoFrameBufferPool<webrtc::I420Buffer>
+      scaled_buffer_pools_[kVideoFrameFormatCount];
+
+  /// Set while frames are dropped for lack of a free or large enough
+  /// application destination buffer, to avoid logging for each frame.
+  std::atomic_bool destinations_exhausted_{false};
 };
 
 }  // namespace Microsoft::MixedReality::WebRTC
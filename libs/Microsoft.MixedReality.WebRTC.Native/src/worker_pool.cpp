@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// This is a precompiled header, it must be on its own, followed by a blank
+// line, to prevent clang-format from reordering it with other headers.
+#include "pch.h"
+
+#include "worker_pool.h"
+
+namespace Microsoft::MixedReality::WebRTC {
+
+WorkerPool::WorkerPool(int thread_count) {
+  if (thread_count <= 0) {
+    thread_count =
+        std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+  }
+  threads_.reserve(thread_count);
+  for (int i = 0; i < thread_count; ++i) {
+    threads_.emplace_back([this]() { WorkerMain(); });
+  }
+}
+
+WorkerPool::~WorkerPool() noexcept {
+  {
+    auto lock = std::scoped_lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto&& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::ParallelFor(int count,
+                             int max_parallelism,
+                             const std::function<void(int)>& func) noexcept {
+  const int helper_count =
+      std::min({count - 1, max_parallelism - 1, thread_count()});
+  if (helper_count <= 0) {
+    for (int i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  Job job;
+  job.func_ = &func;
+  job.count_ = count;
+  job.pending_workers_.store(helper_count, std::memory_order_relaxed);
+  {
+    auto lock = std::scoped_lock{mutex_};
+    for (int i = 0; i < helper_count; ++i) {
+      queue_.push_back(&job);
+    }
+  }
+  if (helper_count == 1) {
+    cv_.notify_one();
+  } else {
+    cv_.notify_all();
+  }
+
+  // The calling thread participates, so the job completes even if all workers
+  // are busy with other jobs.
+  RunJob(job);
+
+  // Withdraw the entries of the job which no worker claimed yet. Otherwise
+  // this thread would wait for workers busy with unrelated jobs queued ahead
+  // to get to them only to find no item left, or forever if the pool is
+  // stopping and the workers exit without draining the queue.
+  int unclaimed_count;
+  {
+    auto lock = std::scoped_lock{mutex_};
+    const auto unclaimed = std::remove(queue_.begin(), queue_.end(), &job);
+    unclaimed_count = static_cast<int>(queue_.end() - unclaimed);
+    queue_.erase(unclaimed, queue_.end());
+  }
+
+  // Wait for all the workers which picked up the job to release it, since it
+  // lives on the stack of this thread.
+  std::unique_lock<std::mutex> lock(job.done_mutex_);
+  job.pending_workers_.fetch_sub(unclaimed_count, std::memory_order_acq_rel);
+  job.done_cv_.wait(lock, [&job]() {
+    return (job.pending_workers_.load(std::memory_order_acquire) == 0);
+  });
+}
+
+void WorkerPool::ParallelForRows(
+    int row_count,
+    int max_parallelism,
+    int min_rows_per_stripe,
+    const std::function<void(int, int)>& func) noexcept {
+  const int max_stripes =
+      std::max(row_count / std::max(min_rows_per_stripe, 2), 1);
+  const int stripe_count = std::min(std::max(max_parallelism, 1), max_stripes);
+  if (stripe_count <= 1) {
+    func(0, row_count);
+    return;
+  }
+  // Round up to an even row count so that each stripe starts on an even row,
+  // which keeps chroma rows shared by two luma rows in the same stripe.
+  int rows_per_stripe = (row_count + stripe_count - 1) / stripe_count;
+  rows_per_stripe = (rows_per_stripe + 1) & ~1;
+  const int actual_stripe_count =
+      (row_count + rows_per_stripe - 1) / rows_per_stripe;
+  ParallelFor(actual_stripe_count, max_parallelism,
+              [&func, row_count, rows_per_stripe](int stripe) {
+                const int first_row = stripe * rows_per_stripe;
+                func(first_row,
+                     std::min(rows_per_stripe, row_count - first_row));
+              });
+}
+
+void WorkerPool::RunJob(Job& job) noexcept {
+  for (;;) {
+    const int index = job.next_index_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= job.count_) {
+      break;
+    }
+    (*job.func_)(index);
+  }
+}
+
+void WorkerPool::WorkerMain() noexcept {
+  for (;;) {
+    Job* job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      job = queue_.front();
+      queue_.pop_front();
+    }
+    RunJob(*job);
+    // Signal under the lock, since |job| is destroyed by the waiting thread
+    // as soon as it observes no pending worker.
+    auto lock = std::scoped_lock{job->done_mutex_};
+    if (job->pending_workers_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      job->done_cv_.notify_one();
+    }
+  }
+}
+
+}  // namespace Microsoft::MixedReality::WebRTC
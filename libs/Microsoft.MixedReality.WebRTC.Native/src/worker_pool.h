@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Microsoft::MixedReality::WebRTC {
+
+/// Small pool of worker threads shared by all objects of the library, used to
+/// split CPU-heavy per-frame work like color conversion of large video frames
+/// across multiple cores. The pool is owned by the |GlobalFactory|.
+class WorkerPool {
+ public:
+  /// Create a pool with the given number of worker threads. Zero means one
+  /// thread per hardware core, minus one for the calling thread which always
+  /// participates in the work.
+  explicit WorkerPool(int thread_count = 0);
+  ~WorkerPool() noexcept;
+
+  /// Number of worker threads, not including the calling thread.
+  int thread_count() const noexcept {
+    return static_cast<int>(threads_.size());
+  }
+
+  /// Invoke |func(index)| for each |index| in [0:|count|[, splitting the work
+  /// across the calling thread and up to (|max_parallelism| - 1) worker
+  /// threads, and block until all invocations returned. The invocation order
+  /// is unspecified.
+  void ParallelFor(int count,
+                   int max_parallelism,
+                   const std::function<void(int)>& func) noexcept;
+
+  /// Split |row_count| rows into stripes of an even number of rows (to keep
+  /// chroma subsampling aligned), and invoke |func(first_row, row_count)| for
+  /// each of them in parallel, using up to |max_parallelism| threads. Stripes
+  /// smaller than |min_rows_per_stripe| are avoided, so small frames are
+  /// processed on the calling thread only.
+  void ParallelForRows(int row_count,
+                       int max_parallelism,
+                       int min_rows_per_stripe,
+                       const std::function<void(int, int)>& func) noexcept;
+
+ private:
+  /// Single |ParallelFor()| invocation shared by the participating threads.
+  struct Job {
+    const std::function<void(int)>* func_;
+    int count_;
+    std::atomic<int> next_index_{0};
+    /// Number of workers which picked up or will pick up this job and have
+    /// not finished with it yet. Entries still queued when the calling thread
+    /// finished the job are withdrawn and not counted anymore.
+    std::atomic<int> pending_workers_{0};
+    std::mutex done_mutex_;
+    std::condition_variable done_cv_;
+  };
+
+  /// Process items of |job| until none is left.
+  static void RunJob(Job& job) noexcept;
+
+  /// Entry point of the worker threads.
+  void WorkerMain() noexcept;
+
+  std::vector<std::thread> threads_;
+
+  /// Queue of jobs waiting for a worker. A job is queued once per worker
+  /// requested to help with it.
+  std::deque<Job*> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_{false};
+};
+
+}  // namespace Microsoft::MixedReality::WebRTC
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+//< FIXME - Internal symbols not exported, need static linking
+#if 0
+
+#include <cstdint>
+#include <vector>
+
+#include "audio_conversion.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+namespace {
+
+/// Frame counts covering whole vectors, scalar tails, and both together.
+constexpr size_t kFrameCounts[]{0, 1, 3, 4, 7, 8, 9, 17, 480};
+
+std::vector<int16_t> MakeSamples(size_t count) {
+  std::vector<int16_t> samples(count);
+  for (size_t i = 0; i < count; ++i) {
+    samples[i] = (int16_t)((i * 7919) & 0xFFFF);
+  }
+  if (count > 1) {
+    // Extreme values must not overflow when averaged.
+    samples[0] = INT16_MIN;
+    samples[1] = INT16_MIN;
+  }
+  return samples;
+}
+
+}  // namespace
+
+TEST(AudioConversion, SameChannels) {
+  for (int channels = 1; channels <= 2; ++channels) {
+    for (size_t frame_count : kFrameCounts) {
+      const std::vector<int16_t> src = MakeSamples(frame_count * channels);
+      std::vector<float> dst(src.size() + 1, -2.0f);
+      ASSERT_TRUE(ConvertS16ToFloat(src.data(), channels, dst.data(),
+                                    channels, frame_count));
+      for (size_t i = 0; i < src.size(); ++i) {
+        ASSERT_EQ(src[i] / 32768.0f, dst[i]);
+      }
+      ASSERT_EQ(-2.0f, dst.back());
+    }
+  }
+}
+
+TEST(AudioConversion, MonoToStereo) {
+  for (size_t frame_count : kFrameCounts) {
+    const std::vector<int16_t> src = MakeSamples(frame_count);
+    std::vector<float> dst(frame_count * 2 + 1, -2.0f);
+    ASSERT_TRUE(ConvertS16ToFloat(src.data(), 1, dst.data(), 2, frame_count));
+    for (size_t i = 0; i < frame_count; ++i) {
+      ASSERT_EQ(src[i] / 32768.0f, dst[2 * i]);
+      ASSERT_EQ(src[i] / 32768.0f, dst[2 * i + 1]);
+    }
+    ASSERT_EQ(-2.0f, dst.back());
+  }
+}
+
+TEST(AudioConversion, StereoToMono) {
+  for (size_t frame_count : kFrameCounts) {
+    const std::vector<int16_t> src = MakeSamples(frame_count * 2);
+    std::vector<float> dst(frame_count + 1, -2.0f);
+    ASSERT_TRUE(ConvertS16ToFloat(src.data(), 2, dst.data(), 1, frame_count));
+    for (size_t i = 0; i < frame_count; ++i) {
+      ASSERT_EQ(((int)src[2 * i] + (int)src[2 * i + 1]) / 65536.0f, dst[i]);
+    }
+    ASSERT_EQ(-2.0f, dst.back());
+  }
+}
+
+TEST(AudioConversion, UnsupportedChannels) {
+  const int16_t src[6]{};
+  float dst[6]{};
+  ASSERT_FALSE(ConvertS16ToFloat(src, 3, dst, 2, 2));
+  ASSERT_FALSE(ConvertS16ToFloat(src, 2, dst, 0, 2));
+}
+
+#endif  // #if 0
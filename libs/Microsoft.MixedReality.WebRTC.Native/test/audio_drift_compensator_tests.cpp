@@ -0,0 +1,231 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "audio_drift_compensator.h"
+#include "audio_frame_ring.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+TEST(AudioDriftCompensator, PassThrough) {
+  AudioDriftCompensator drift;
+  drift.Reset(2);
+  std::vector<float> src(20);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = (float)i;
+  }
+  // The last 2 frames are held back as interpolation history
+  std::vector<float> dst;
+  drift.Process(src.data(), 10, dst);
+  ASSERT_EQ(16u, dst.size());
+  ASSERT_EQ(2u, drift.pending_frame_count());
+  drift.Process(src.data(), 10, dst);
+  ASSERT_EQ(36u, dst.size());
+  for (size_t i = 0; i < dst.size(); ++i) {
+    ASSERT_EQ(src[i % 20], dst[i]);
+  }
+}
+
+TEST(AudioDriftCompensator, Prebuffering) {
+  AudioDriftCompensator drift;
+  ASSERT_TRUE(drift.prebuffering());
+  ASSERT_FALSE(drift.TryEndPrebuffering(20.0, 30.0));
+  ASSERT_TRUE(drift.TryEndPrebuffering(30.0, 30.0));
+  ASSERT_FALSE(drift.prebuffering());
+  drift.OnUnderrun();
+  ASSERT_TRUE(drift.prebuffering());
+
+  // The ratio is not updated while prebuffering
+  drift.Update(0.0, 30.0);
+  ASSERT_EQ(1.0, drift.ratio());
+}
+
+TEST(AudioDriftCompensator, Ratio) {
+  AudioDriftCompensator drift;
+  ASSERT_TRUE(drift.TryEndPrebuffering(30.0, 30.0));
+  drift.Update(30.0, 30.0);
+  ASSERT_EQ(1.0, drift.ratio());
+
+  // Consume faster when the buffer is too full, within limits
+  for (int i = 0; i < 1000; ++i) {
+    drift.Update(1000.0, 30.0);
+  }
+  ASSERT_DOUBLE_EQ(1.0 + AudioDriftCompensator::kMaxRatioDeviation,
+                   drift.ratio());
+  for (int i = 0; i < 1000; ++i) {
+    drift.Update(0.0, 30.0);
+  }
+  ASSERT_DOUBLE_EQ(1.0 - AudioDriftCompensator::kMaxRatioDeviation,
+                   drift.ratio());
+}
+
+TEST(AudioDriftCompensator, Resample) {
+  AudioDriftCompensator drift;
+  drift.Reset(1);
+  ASSERT_TRUE(drift.TryEndPrebuffering(30.0, 30.0));
+  for (int i = 0; i < 1000; ++i) {
+    drift.Update(1000.0, 30.0);
+  }
+
+  // A linear ramp is interpolated exactly, and consumed faster
+  std::vector<float> src(1000);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = (float)i;
+  }
+  std::vector<float> dst;
+  drift.Process(src.data(), src.size(), dst);
+  ASSERT_GT(src.size() - 2, dst.size());
+  for (size_t i = 0; i < dst.size(); ++i) {
+    ASSERT_NEAR(i * drift.ratio(), dst[i], 1e-3);
+  }
+}
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr size_t kFrameSize = kSampleRate / 100;  // 10ms mono frames
+
+/// Simulation of an AudioReadStream with clocks drifting apart. The producer
+/// delivers 10ms frames with some jitter on its own clock, and the consumer
+/// reads chunks on the nominal clock. This mirrors AudioReadStream::Read()
+/// for a stream which does not need any conversion.
+class DriftingClockSimulation {
+ public:
+  DriftingClockSimulation(int buffer_ms, size_t read_size)
+      : max_frames_(buffer_ms / 10),
+        target_ms_(buffer_ms / 2.0),
+        read_size_(read_size),
+        ring_(max_frames_ * 2, kFrameSize) {
+    drift_.Reset(1);
+  }
+
+  int underrun_count() const { return underrun_count_; }
+  int overrun_count() const { return overrun_count_; }
+
+  /// Run the simulation for |duration_s| seconds, with the producer clock
+  /// faster than the consumer clock by |drift|. Glitches are only counted
+  /// after |settle_s| seconds. Return the mean ratio of the compensator over
+  /// the last half of the simulation.
+  double Run(double drift, double settle_s, double duration_s) {
+    const double produce_period_us = 10000.0 / (1.0 + drift);
+    const double read_period_us = read_size_ * 1e6 / kSampleRate;
+    const double settle_us = settle_s * 1e6;
+    const double end_us = duration_s * 1e6;
+    std::vector<int16_t> frame(kFrameSize);
+    std::vector<float> output(read_size_);
+    uint32_t jitter_state = 12345;
+    double next_produce_us = 0.0;
+    double next_read_us = read_period_us;
+    double ratio_sum = 0.0;
+    int ratio_count = 0;
+    for (double now_us = 0.0; now_us < end_us;) {
+      if (next_produce_us <= next_read_us) {
+        now_us = next_produce_us;
+        ring_.Write(frame.data(), 16, kSampleRate, 1, kFrameSize);
+        // Deliver up to 3ms late, from a simple linear congruential generator
+        jitter_state = jitter_state * 1664525u + 1013904223u;
+        const double jitter_us = (jitter_state >> 16) % 3000;
+        next_produce_us += produce_period_us + jitter_us - last_jitter_us_;
+        next_produce_us = std::max(next_produce_us, now_us);
+        last_jitter_us_ = jitter_us;
+      } else {
+        now_us = next_read_us;
+        if (now_us < settle_us) {
+          underrun_count_ = 0;
+          overrun_count_ = 0;
+        }
+        Read(output.data(), output.size());
+        next_read_us += read_period_us;
+        if (now_us >= end_us / 2) {
+          ratio_sum += drift_.ratio();
+          ++ratio_count;
+        }
+      }
+    }
+    return ratio_sum / ratio_count;
+  }
+
+ private:
+  double GetFillMs() const {
+    const size_t buffered =
+        (buffer_.size() - used_) + drift_.pending_frame_count();
+    return (ring_.size() * 10.0) + (buffered * 1000.0 / kSampleRate);
+  }
+
+  void Read(float* dst, size_t size) {
+    if (drift_.prebuffering() &&
+        !drift_.TryEndPrebuffering(GetFillMs(), target_ms_)) {
+      std::fill_n(dst, size, 0.0f);
+      return;
+    }
+    while (size > 0) {
+      if (used_ < buffer_.size()) {
+        const size_t len = std::min(buffer_.size() - used_, size);
+        std::copy_n(buffer_.data() + used_, len, dst);
+        used_ += len;
+        dst += len;
+        size -= len;
+        continue;
+      }
+      const uint32_t frame_count = ring_.size();
+      if (frame_count > max_frames_) {
+        ring_.Discard(frame_count - max_frames_);
+        ++overrun_count_;
+      }
+      AudioFrameRing::FrameInfo info;
+      if (const int16_t* samples = ring_.Front(info)) {
+        converted_.assign(samples, samples + kFrameSize);
+        buffer_.clear();
+        used_ = 0;
+        drift_.Process(converted_.data(), kFrameSize, buffer_);
+        ring_.Pop();
+      } else {
+        drift_.OnUnderrun();
+        ++underrun_count_;
+        std::fill_n(dst, size, 0.0f);
+        size = 0;
+      }
+    }
+    drift_.Update(GetFillMs(), target_ms_);
+  }
+
+  const uint32_t max_frames_;
+  const double target_ms_;
+  const size_t read_size_;
+  AudioFrameRing ring_;
+  AudioDriftCompensator drift_;
+  std::vector<float> converted_;
+  std::vector<float> buffer_;
+  size_t used_ = 0;
+  double last_jitter_us_ = 0.0;
+  int underrun_count_ = 0;
+  int overrun_count_ = 0;
+};
+
+}  // namespace
+
+TEST(AudioDriftCompensator, DriftingClocks) {
+  struct Config {
+    int buffer_ms;
+    size_t read_size;
+  };
+  // 1024 samples is a typical read size of game engines, and 480 samples is
+  // the size of the frames delivered by WebRTC.
+  for (const Config& config : {Config{60, 1024}, Config{40, 480}}) {
+    for (double drift : {-0.002, -0.0001, 0.0, 0.0001, 0.002}) {
+      DriftingClockSimulation simulation(config.buffer_ms, config.read_size);
+      const double ratio = simulation.Run(drift, 10.0, 120.0);
+      ASSERT_EQ(0, simulation.underrun_count())
+          << config.buffer_ms << "ms, drift=" << drift;
+      ASSERT_EQ(0, simulation.overrun_count())
+          << config.buffer_ms << "ms, drift=" << drift;
+      ASSERT_NEAR(1.0 + drift, ratio, 2e-4)
+          << config.buffer_ms << "ms, drift=" << drift;
+    }
+  }
+}
@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio_frame_ring.h"
+#include "benchmark_test_helpers.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+TEST(AudioFrameRing, WriteRead) {
+  AudioFrameRing ring(3, 8);
+  ASSERT_EQ(4u, ring.capacity());
+  ASSERT_EQ(0u, ring.size());
+  AudioFrameRing::FrameInfo info{};
+  ASSERT_EQ(nullptr, ring.Front(info));
+
+  const int16_t stereo[6]{1, -1, 2, -2, 3, -3};
+  ASSERT_TRUE(ring.Write(stereo, 16, 48000, 2, 3));
+  const int16_t mono[2]{7, 8};
+  ASSERT_TRUE(ring.Write(mono, 16, 16000, 1, 2));
+  ASSERT_EQ(2u, ring.size());
+
+  // Frames are read in order, each with its own format
+  const int16_t* samples = ring.Front(info);
+  ASSERT_NE(nullptr, samples);
+  ASSERT_EQ(48000u, info.sample_rate);
+  ASSERT_EQ(2u, info.channel_count);
+  ASSERT_EQ(3u, info.frame_count);
+  ASSERT_TRUE(std::equal(stereo, stereo + 6, samples));
+  ring.Pop();
+  samples = ring.Front(info);
+  ASSERT_NE(nullptr, samples);
+  ASSERT_EQ(16000u, info.sample_rate);
+  ASSERT_EQ(1u, info.channel_count);
+  ASSERT_EQ(2u, info.frame_count);
+  ASSERT_TRUE(std::equal(mono, mono + 2, samples));
+  ring.Pop();
+  ASSERT_EQ(0u, ring.size());
+  ASSERT_EQ(nullptr, ring.Front(info));
+}
+
+TEST(AudioFrameRing, Promote8Bit) {
+  AudioFrameRing ring(1, 4);
+  const uint8_t samples[3]{0, 128, 255};
+  ASSERT_TRUE(ring.Write(samples, 8, 8000, 1, 3));
+  AudioFrameRing::FrameInfo info{};
+  const int16_t* promoted = ring.Front(info);
+  ASSERT_NE(nullptr, promoted);
+  ASSERT_EQ(-32768, promoted[0]);
+  ASSERT_EQ(0, promoted[1]);
+  ASSERT_EQ(32512, promoted[2]);
+}
+
+TEST(AudioFrameRing, InvalidFrame) {
+  AudioFrameRing ring(1, 4);
+  const int16_t samples[6]{};
+  ASSERT_FALSE(ring.Write(samples, 16, 48000, 2, 3));  // too large
+  ASSERT_FALSE(ring.Write(samples, 24, 48000, 1, 1));  // unsupported
+  ASSERT_EQ(0u, ring.size());
+}
+
+TEST(AudioFrameRing, Full) {
+  AudioFrameRing ring(2, 1);
+  for (int16_t i = 0; i < 2; ++i) {
+    ASSERT_TRUE(ring.Write(&i, 16, 48000, 1, 1));
+  }
+
+  // The newest frames are dropped
+  const int16_t dropped = 2;
+  ASSERT_FALSE(ring.Write(&dropped, 16, 48000, 1, 1));
+  ASSERT_EQ(2u, ring.size());
+
+  // The consumer discards the oldest frames
+  ring.Discard(1);
+  const int16_t written = 3;
+  ASSERT_TRUE(ring.Write(&written, 16, 48000, 1, 1));
+  AudioFrameRing::FrameInfo info{};
+  ASSERT_EQ(1, *ring.Front(info));
+  ring.Pop();
+  ASSERT_EQ(3, *ring.Front(info));
+}
+
+TEST(AudioFrameRing, ProducerConsumer) {
+  constexpr int16_t kFrameCount = 30000;
+  AudioFrameRing ring(4, 2);
+  std::thread producer([&ring]() {
+    for (int16_t i = 0; i < kFrameCount; ++i) {
+      const int16_t samples[2]{i, (int16_t)-i};
+      while (!ring.Write(samples, 16, 48000, 2, 1)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  // The consumer sees all the frames, in order and complete. Drain all of
+  // them before asserting, so that the producer can always be joined.
+  int16_t expected = 0;
+  int first_mismatch = -1;
+  while (expected < kFrameCount) {
+    AudioFrameRing::FrameInfo info{};
+    if (const int16_t* samples = ring.Front(info)) {
+      if ((first_mismatch < 0) &&
+          ((samples[0] != expected) || (samples[1] != -expected))) {
+        first_mismatch = expected;
+      }
+      ring.Pop();
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  ASSERT_EQ(-1, first_mismatch);
+  ASSERT_EQ(0u, ring.size());
+}
+
+namespace {
+
+// 10ms of 48kHz stereo audio, as delivered by WebRTC.
+constexpr uint32_t kBenchFramesPerChannel = 480;
+constexpr uint32_t kBenchChannelCount = 2;
+constexpr uint32_t kBenchSampleCount =
+    kBenchFramesPerChannel * kBenchChannelCount;
+constexpr int kBenchCallbackCount = 5000;
+constexpr uint32_t kBenchMaxFrames = 50;  // 500ms
+
+/// Previous buffering of AudioReadStream, for comparison: a deque of frames
+/// each copied into its own allocation, under a mutex shared with the reader.
+struct MutexDequeBuffer {
+  std::mutex mutex_;
+  std::deque<std::vector<int16_t>> frames_;
+
+  void Write(const int16_t* samples) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (frames_.size() > kBenchMaxFrames) {
+      frames_.pop_front();
+    }
+    frames_.emplace_back(samples, samples + kBenchSampleCount);
+  }
+
+  bool Read(std::vector<float>& dst) {
+    std::vector<int16_t> frame;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (frames_.empty()) {
+        return false;
+      }
+      frame = std::move(frames_.front());
+      frames_.pop_front();
+    }
+    std::transform(frame.begin(), frame.end(), dst.begin(),
+                   [](int16_t s) { return s / 32768.0f; });
+    return true;
+  }
+};
+
+/// Buffering of AudioReadStream with the lock-free ring.
+struct RingBuffer {
+  AudioFrameRing ring_{kBenchMaxFrames * 2, kBenchSampleCount};
+
+  void Write(const int16_t* samples) {
+    ring_.Write(samples, 16, 48000, kBenchChannelCount,
+                kBenchFramesPerChannel);
+  }
+
+  bool Read(std::vector<float>& dst) {
+    const uint32_t frame_count = ring_.size();
+    if (frame_count > kBenchMaxFrames) {
+      ring_.Discard(frame_count - kBenchMaxFrames);
+    }
+    AudioFrameRing::FrameInfo info{};
+    const int16_t* samples = ring_.Front(info);
+    if (!samples) {
+      return false;
+    }
+    std::transform(samples, samples + kBenchSampleCount, dst.begin(),
+                   [](int16_t s) { return s / 32768.0f; });
+    ring_.Pop();
+    return true;
+  }
+};
+
+/// Measure the duration of each audio callback while a reader thread
+/// continuously reads from the buffer, as an application polling audio from
+/// its own thread would.
+template <typename Buffer>
+DurationStats MeasureCallbacksUnderBusyReader(Buffer& buffer) {
+  std::vector<int16_t> samples(kBenchSampleCount, 1000);
+  std::vector<Clock::duration> durations;
+  durations.reserve(kBenchCallbackCount);
+  std::atomic_bool done{false};
+  std::thread reader([&buffer, &done]() {
+    std::vector<float> dst(kBenchSampleCount);
+    while (!done.load()) {
+      buffer.Read(dst);
+    }
+  });
+  for (int i = 0; i < kBenchCallbackCount; ++i) {
+    const Clock::time_point start = Clock::now();
+    buffer.Write(samples.data());
+    durations.push_back(Clock::now() - start);
+    // Leave some time to the reader, without sleeping for a full 10ms.
+    std::this_thread::yield();
+  }
+  done = true;
+  reader.join();
+  return ComputeStats(durations);
+}
+
+}  // namespace
+
+TEST(AudioFrameRing, BusyReaderBenchmark) {
+  MutexDequeBuffer mutex_buffer;
+  const DurationStats mutex_cost =
+      MeasureCallbacksUnderBusyReader(mutex_buffer);
+  RingBuffer ring_buffer;
+  const DurationStats ring_cost = MeasureCallbacksUnderBusyReader(ring_buffer);
+  printf(
+      "Audio callback under busy reader, %d callbacks: mutex+deque "
+      "mean=%.2fus p99=%.2fus max=%.2fus; ring mean=%.2fus p99=%.2fus "
+      "max=%.2fus\n",
+      kBenchCallbackCount, mutex_cost.mean_us, mutex_cost.p99_us,
+      mutex_cost.max_us, ring_cost.mean_us, ring_cost.p99_us,
+      ring_cost.max_us);
+}
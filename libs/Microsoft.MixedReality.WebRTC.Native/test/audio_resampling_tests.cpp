@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+//< FIXME - Internal symbols not exported, need static linking
+#if 0
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "audio_conversion.h"
+#include "benchmark_test_helpers.h"
+#include "common_audio/resampler/include/push_resampler.h"
+#include "common_audio/resampler/include/resampler.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr int kDstRate = 48000;
+constexpr double kToneHz = 1000.0;
+constexpr int kToneFrameCount = 100;  // 1 second of 10ms frames
+
+/// Generate 10ms frames of a mono 16-bit sine tone at half the full scale.
+std::vector<int16_t> MakeTone(int sample_rate) {
+  std::vector<int16_t> samples((size_t)(sample_rate / 100) * kToneFrameCount);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const double phase = 2.0 * kPi * kToneHz * i / sample_rate;
+    samples[i] = (int16_t)std::lround(16384.0 * std::sin(phase));
+  }
+  return samples;
+}
+
+/// Resampling path of AudioReadStream in int16 mode: resample, then convert.
+class Int16Path {
+ public:
+  void Process(const int16_t* src,
+               size_t src_count,
+               int src_rate,
+               std::vector<float>& out) {
+    resampler_.ResetIfNeeded(src_rate, kDstRate, 1);
+    scratch_.resize((src_count * kDstRate / src_rate) + 1);
+    size_t count = 0;
+    if (resampler_.Push(src, src_count, scratch_.data(), scratch_.size(),
+                        count) != 0) {
+      return;
+    }
+    const size_t offset = out.size();
+    out.resize(offset + count);
+    ConvertS16ToFloat(scratch_.data(), 1, out.data() + offset, 1, count);
+  }
+
+ private:
+  webrtc::Resampler resampler_;
+  std::vector<int16_t> scratch_;
+};
+
+/// Resampling path of AudioReadStream in float mode: convert, then resample.
+class FloatPath {
+ public:
+  void Process(const int16_t* src,
+               size_t src_count,
+               int src_rate,
+               std::vector<float>& out) {
+    scratch_.resize(src_count);
+    ConvertS16ToFloat(src, 1, scratch_.data(), 1, src_count);
+    resampler_.InitializeIfNeeded(src_rate, kDstRate, 1);
+    const size_t offset = out.size();
+    out.resize(offset + (kDstRate / 100));
+    const int count = resampler_.Resample(scratch_.data(), src_count,
+                                          out.data() + offset, kDstRate / 100);
+    out.resize(offset + (size_t)std::max(count, 0));
+  }
+
+ private:
+  webrtc::PushResampler<float> resampler_;
+  std::vector<float> scratch_;
+};
+
+/// Resample a tone to |kDstRate| in 10ms frames, as AudioReadStream does.
+template <typename Path>
+void Resample(Path& path,
+              const std::vector<int16_t>& tone,
+              int src_rate,
+              std::vector<float>& out) {
+  const size_t frame_size = (size_t)(src_rate / 100);
+  for (size_t i = 0; i + frame_size <= tone.size(); i += frame_size) {
+    path.Process(&tone[i], frame_size, src_rate, out);
+  }
+}
+
+/// Compute the signal-to-noise ratio in dB of a resampled tone. The reference
+/// tone is fitted by least squares, so that the delay of the resampler does
+/// not count as noise. The analysis window starts after the resampler warmed
+/// up, and covers whole periods of the tone.
+double ComputeToneSnrDb(const std::vector<float>& samples) {
+  constexpr size_t kWarmup = kDstRate / 10;
+  constexpr size_t kWindow = kDstRate / 2;
+  if (samples.size() < kWarmup + kWindow) {
+    return 0.0;
+  }
+  double sin_coef = 0.0;
+  double cos_coef = 0.0;
+  for (size_t i = 0; i < kWindow; ++i) {
+    const double phase = 2.0 * kPi * kToneHz * i / kDstRate;
+    sin_coef += samples[kWarmup + i] * std::sin(phase);
+    cos_coef += samples[kWarmup + i] * std::cos(phase);
+  }
+  sin_coef *= 2.0 / kWindow;
+  cos_coef *= 2.0 / kWindow;
+  double signal = 0.0;
+  double noise = 0.0;
+  for (size_t i = 0; i < kWindow; ++i) {
+    const double phase = 2.0 * kPi * kToneHz * i / kDstRate;
+    const double fit = sin_coef * std::sin(phase) + cos_coef * std::cos(phase);
+    const double error = samples[kWarmup + i] - fit;
+    signal += fit * fit;
+    noise += error * error;
+  }
+  return 10.0 * std::log10(signal / noise);
+}
+
+/// Measure the mean time to resample a 10ms frame, in microseconds.
+template <typename Path>
+double MeasureFrameTimeUs(const std::vector<int16_t>& tone, int src_rate) {
+  constexpr int kIterationCount = 20;
+  Path path;
+  std::vector<float> out;
+  out.reserve((size_t)(kDstRate / 100) * kToneFrameCount + 1);
+  const Clock::time_point start = Clock::now();
+  for (int i = 0; i < kIterationCount; ++i) {
+    out.clear();
+    Resample(path, tone, src_rate, out);
+  }
+  const Clock::duration elapsed = Clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() /
+         (kIterationCount * kToneFrameCount);
+}
+
+}  // namespace
+
+TEST(AudioResampling, Quality) {
+  for (int src_rate : {16000, 32000}) {
+    const std::vector<int16_t> tone = MakeTone(src_rate);
+    Int16Path int16_path;
+    std::vector<float> int16_out;
+    Resample(int16_path, tone, src_rate, int16_out);
+    FloatPath float_path;
+    std::vector<float> float_out;
+    Resample(float_path, tone, src_rate, float_out);
+
+    const double int16_snr = ComputeToneSnrDb(int16_out);
+    const double float_snr = ComputeToneSnrDb(float_out);
+    printf("Resampling %d Hz to %d Hz: int16 SNR=%.1fdB; float SNR=%.1fdB\n",
+           src_rate, kDstRate, int16_snr, float_snr);
+    ASSERT_LT(60.0, float_snr);
+    ASSERT_LE(int16_snr - 1.0, float_snr);
+  }
+}
+
+TEST(AudioResampling, ThroughputBenchmark) {
+  for (int src_rate : {16000, 32000}) {
+    const std::vector<int16_t> tone = MakeTone(src_rate);
+    const double int16_us = MeasureFrameTimeUs<Int16Path>(tone, src_rate);
+    const double float_us = MeasureFrameTimeUs<FloatPath>(tone, src_rate);
+    printf(
+        "Resampling %d Hz to %d Hz: int16 %.2fus per 10ms frame; float "
+        "%.2fus per 10ms frame\n",
+        src_rate, kDstRate, int16_us, float_us);
+  }
+}
+
+#endif  // #if 0
@@ -3,8 +3,12 @@
 
 #include "pch.h"
 
+#include <atomic>
+#include <vector>
+
 #include "interop_api.h"
 #include "audio_frame.h"
+#include "remote_audio_track_interop.h"
 
 #if !defined(MRSW_EXCLUDE_DEVICE_TESTS)
 
@@ -13,6 +17,10 @@ namespace {
 // PeerConnectionAudioFrameCallback
 using AudioFrameCallback = InteropCallback<const AudioFrame&>;
 
+// PeerConnectionRemoteAudioTrackAddedCallback
+using RemoteAudioTrackCallback =
+    InteropCallback<RemoteAudioTrackHandle, const char*>;
+
 bool IsSilent_uint8(const uint8_t* data,
                     uint32_t size,
                     uint8_t& min,
@@ -188,4 +196,140 @@ TEST(AudioTrack, Muted) {
                                                     nullptr);
 }
 
+TEST(AudioTrack, RemoteTrack) {
+  LocalPeerPairRaii pair;
+
+  ASSERT_EQ(Result::kSuccess,
+            mrsPeerConnectionAddLocalAudioTrack(pair.pc1()));
+
+  uint32_t call_count = 0;
+  AudioFrameCallback audio_cb = [&call_count](const AudioFrame& frame) {
+    ASSERT_NE(nullptr, frame.data_);
+    ASSERT_LT(0u, frame.sample_count_);
+    ++call_count;
+  };
+
+  // Receive the frames of the remote track alone
+  RemoteAudioTrackHandle track_handle = nullptr;
+  RemoteAudioTrackCallback track_added_cb =
+      [&track_handle, &audio_cb](RemoteAudioTrackHandle handle,
+                                 const char* track_id) {
+        ASSERT_NE(nullptr, handle);
+        ASSERT_NE(nullptr, track_id);
+        mrsRemoteAudioTrackAddRef(handle);
+        track_handle = handle;
+        mrsRemoteAudioTrackRegisterFrameCallback(handle, CB(audio_cb));
+      };
+  mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(pair.pc2(),
+                                                         CB(track_added_cb));
+
+  pair.ConnectAndWait();
+
+  Event ev;
+  ev.WaitFor(5s);
+  ASSERT_NE(nullptr, track_handle);
+  ASSERT_LT(50u, call_count);  // at least 10 CPS
+
+  mrsRemoteAudioTrackRegisterFrameCallback(track_handle, nullptr, nullptr);
+  mrsRemoteAudioTrackRemoveRef(track_handle);
+  mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(pair.pc2(), nullptr,
+                                                         nullptr);
+}
+
+// Check that the callbacks and read streams of two remote audio tracks only
+// receive the frames of their own track, and that destroying a read stream
+// does not unregister a callback registered on its track after it.
+TEST(AudioTrack, TwoRemoteTracks) {
+  LocalPeerPairRaii pair;
+
+  // Each peer sends audio, so each one has a different remote audio track.
+  ASSERT_EQ(Result::kSuccess,
+            mrsPeerConnectionAddLocalAudioTrack(pair.pc1()));
+  ASSERT_EQ(Result::kSuccess,
+            mrsPeerConnectionAddLocalAudioTrack(pair.pc2()));
+
+  std::atomic<uint32_t> call_count1{0};
+  AudioFrameCallback audio_cb1 = [&call_count1](const AudioFrame& frame) {
+    ASSERT_NE(nullptr, frame.data_);
+    ++call_count1;
+  };
+  std::atomic<uint32_t> call_count2{0};
+  AudioFrameCallback audio_cb2 = [&call_count2](const AudioFrame& frame) {
+    ASSERT_NE(nullptr, frame.data_);
+    ++call_count2;
+  };
+
+  RemoteAudioTrackHandle track_handle1 = nullptr;
+  RemoteAudioTrackCallback track_added_cb1 =
+      [&track_handle1, &audio_cb1](RemoteAudioTrackHandle handle,
+                                   const char* /*track_id*/) {
+        ASSERT_NE(nullptr, handle);
+        mrsRemoteAudioTrackAddRef(handle);
+        track_handle1 = handle;
+        mrsRemoteAudioTrackRegisterFrameCallback(handle, CB(audio_cb1));
+      };
+  mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(pair.pc1(),
+                                                         CB(track_added_cb1));
+  RemoteAudioTrackHandle track_handle2 = nullptr;
+  RemoteAudioTrackCallback track_added_cb2 =
+      [&track_handle2, &audio_cb2](RemoteAudioTrackHandle handle,
+                                   const char* /*track_id*/) {
+        ASSERT_NE(nullptr, handle);
+        mrsRemoteAudioTrackAddRef(handle);
+        track_handle2 = handle;
+        mrsRemoteAudioTrackRegisterFrameCallback(handle, CB(audio_cb2));
+      };
+  mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(pair.pc2(),
+                                                         CB(track_added_cb2));
+
+  pair.ConnectAndWait();
+
+  Event ev;
+  ev.WaitFor(5s);
+  ASSERT_NE(nullptr, track_handle1);
+  ASSERT_NE(nullptr, track_handle2);
+  ASSERT_LT(50u, call_count1.load());  // at least 10 CPS
+  ASSERT_LT(50u, call_count2.load());
+
+  // Unregistering the callback of one track stops it, but not the callback of
+  // the other track, so neither received the frames of the other track.
+  mrsRemoteAudioTrackRegisterFrameCallback(track_handle1, nullptr, nullptr);
+  const uint32_t stopped_count1 = call_count1.load();
+  uint32_t running_count2 = call_count2.load();
+  ev.WaitFor(1s);
+  ASSERT_EQ(stopped_count1, call_count1.load());
+  ASSERT_LT(running_count2 + 10, call_count2.load());
+
+  // A read stream on the first track replaces its callback only.
+  AudioReadStreamHandle stream1 = nullptr;
+  ASSERT_EQ(Result::kSuccess,
+            mrsRemoteAudioTrackCreateReadStream(
+                track_handle1, -1, mrsAudioResampleMode::kInt16, &stream1));
+  ASSERT_NE(nullptr, stream1);
+  running_count2 = call_count2.load();
+  ev.WaitFor(1s);
+  std::vector<float> data(480 * 2);  // 10ms of 48kHz stereo
+  ASSERT_EQ(Result::kSuccess,
+            mrsAudioReadStreamRead(stream1, 48000, data.data(),
+                                   (int)data.size(), 2));
+  ASSERT_EQ(stopped_count1, call_count1.load());
+  ASSERT_LT(running_count2 + 10, call_count2.load());
+
+  // Destroying the stream leaves the callback registered after it in place.
+  mrsRemoteAudioTrackRegisterFrameCallback(track_handle1, CB(audio_cb1));
+  mrsAudioReadStreamDestroy(stream1);
+  const uint32_t restarted_count1 = call_count1.load();
+  ev.WaitFor(1s);
+  ASSERT_LT(restarted_count1 + 10, call_count1.load());
+
+  mrsRemoteAudioTrackRegisterFrameCallback(track_handle1, nullptr, nullptr);
+  mrsRemoteAudioTrackRegisterFrameCallback(track_handle2, nullptr, nullptr);
+  mrsRemoteAudioTrackRemoveRef(track_handle1);
+  mrsRemoteAudioTrackRemoveRef(track_handle2);
+  mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(pair.pc1(), nullptr,
+                                                         nullptr);
+  mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback(pair.pc2(), nullptr,
+                                                         nullptr);
+}
+
 #endif  // MRSW_EXCLUDE_DEVICE_TESTS
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+/// Clock used to time the benchmarks.
+using Clock = std::chrono::steady_clock;
+
+/// Summary of a set of durations, in microseconds.
+struct DurationStats {
+  double mean_us{};
+  double p99_us{};
+  double max_us{};
+};
+
+/// Compute the summary of |durations|, which are sorted in place.
+inline DurationStats ComputeStats(std::vector<Clock::duration>& durations) {
+  DurationStats stats{};
+  if (durations.empty()) {
+    return stats;
+  }
+  std::sort(durations.begin(), durations.end());
+  auto to_us = [](Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+  };
+  double sum = 0.0;
+  for (auto&& d : durations) {
+    sum += to_us(d);
+  }
+  stats.mean_us = sum / durations.size();
+  stats.p99_us = to_us(durations[(durations.size() * 99) / 100]);
+  stats.max_us = to_us(durations.back());
+  return stats;
+}
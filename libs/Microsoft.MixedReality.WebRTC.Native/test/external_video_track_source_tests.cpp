@@ -3,6 +3,20 @@
 
 #include "pch.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark_test_helpers.h"
 #include "data_channel.h"
 #include "external_video_track_source_interop.h"
 #include "interop_api.h"
@@ -104,9 +118,37 @@ void ValidateQuadTestFrame(const void* data,
   ASSERT_LE(std::fabs(err), 768.0);  // +/-1 per component over 256 pixels
 }
 
+// PeerConnectionI420AVideoFrameCallback
+using I420VideoFrameCallback = InteropCallback<const mrsI420AVideoFrame&>;
+
 // PeerConnectionArgb32VideoFrameCallback
 using Argb32VideoFrameCallback = InteropCallback<const mrsArgb32VideoFrame&>;
 
+/// Time and timestamp of the frame requests of a source.
+struct FrameRequestLog {
+  std::mutex mutex_;
+  std::vector<std::chrono::steady_clock::time_point> request_times_;
+  std::vector<int64_t> timestamps_ms_;
+};
+
+/// Log the frame request in the |FrameRequestLog| passed as user data, then
+/// complete it like |GenerateQuadTestFrame()|.
+mrsResult MRS_CALL
+LogAndGenerateQuadTestFrame(void* user_data,
+                            ExternalVideoTrackSourceHandle source_handle,
+                            uint32_t request_id,
+                            int64_t timestamp_ms) {
+  auto now = std::chrono::steady_clock::now();
+  auto log = (FrameRequestLog*)user_data;
+  {
+    std::scoped_lock lock(log->mutex_);
+    log->request_times_.push_back(now);
+    log->timestamps_ms_.push_back(timestamp_ms);
+  }
+  return GenerateQuadTestFrame(nullptr, source_handle, request_id,
+                               timestamp_ms);
+}
+
 }  // namespace
 
 TEST(ExternalVideoTrackSource, Simple) {
@@ -154,4 +196,1183 @@ TEST(ExternalVideoTrackSource, Simple) {
   mrsExternalVideoTrackSourceRemoveRef(source_handle);
 }
 
+TEST(ExternalVideoTrackSource, FrameRateLongRun) {
+  LocalPeerPairRaii pair;
+
+  FrameRequestLog log;
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                &LogAndGenerateQuadTestFrame, &log, &source_handle));
+  ASSERT_NE(nullptr, source_handle);
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourceSetFrameRate(source_handle, 0.0));
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceSetFrameRate(source_handle, 60.0));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  LocalVideoTrackHandle track_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                pair.pc1(), "gen_track", source_handle, &track_handle));
+  ASSERT_NE(nullptr, track_handle);
+
+  pair.ConnectAndWait();
+
+  // Run for a few minutes, for any drift to accumulate
+  Event ev;
+  ev.WaitFor(180s);
+
+  mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(), source_handle);
+  mrsLocalVideoTrackRemoveRef(track_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+
+  std::scoped_lock lock(log.mutex_);
+  const size_t count = log.timestamps_ms_.size();
+  ASSERT_LT(60u * 170u, count);  // at least ~170s worth of 60 FPS frames
+
+  // Timestamps follow the schedule exactly, so the average frame interval is
+  // exactly the frame period, up to the millisecond rounding of the first and
+  // last timestamps.
+  const double period_ms = 1000.0 / 60.0;
+  const int64_t first_ts = log.timestamps_ms_.front();
+  const int64_t last_ts = log.timestamps_ms_.back();
+  for (size_t i = 1; i < count; ++i) {
+    const int64_t interval = log.timestamps_ms_[i] - log.timestamps_ms_[i - 1];
+    // Whole number of periods, in case some frames were skipped
+    const double periods = std::max(1.0, std::round(interval / period_ms));
+    ASSERT_LE(std::fabs(interval - periods * period_ms), 1.0);
+  }
+  const double frame_span = std::round((last_ts - first_ts) / period_ms);
+  ASSERT_LE(std::fabs((last_ts - first_ts) - frame_span * period_ms), 1.0);
+
+  // The actual request times stay close to the timestamps. The lateness of
+  // each request is its delay relative to the first request, minus the one
+  // expected from the timestamps; it must not grow over time (drift), nor
+  // vary much between consecutive frames (jitter), accounting for the
+  // coarse timer resolution of some platforms.
+  const auto first_time = log.request_times_.front();
+  double max_lateness_ms = 0.0;
+  double sum_sq_jitter_ms = 0.0;
+  double prev_lateness_ms = 0.0;
+  for (size_t i = 0; i < count; ++i) {
+    const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(log.request_times_[i] -
+                                                  first_time)
+            .count();
+    const double lateness_ms =
+        elapsed_ms - (double)(log.timestamps_ms_[i] - first_ts);
+    max_lateness_ms = std::max(max_lateness_ms, std::fabs(lateness_ms));
+    const double jitter_ms = lateness_ms - prev_lateness_ms;
+    sum_sq_jitter_ms += jitter_ms * jitter_ms;
+    prev_lateness_ms = lateness_ms;
+  }
+  const double rms_jitter_ms = std::sqrt(sum_sq_jitter_ms / count);
+  ASSERT_LT(rms_jitter_ms, 8.0);
+  ASSERT_LT(max_lateness_ms, 4 * period_ms);
+  // Cumulative drift over the entire run
+  ASSERT_LT(std::fabs(prev_lateness_ms), 2 * period_ms);
+
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, Push) {
+  LocalPeerPairRaii pair;
+
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+  ASSERT_NE(nullptr, source_handle);
+
+  uint32_t quad[256]{};
+  FillSquareArgb32(quad, 0, 0, 8, 8, 64, kRed);
+  FillSquareArgb32(quad, 8, 0, 8, 8, 64, kGreen);
+  FillSquareArgb32(quad, 0, 8, 8, 8, 64, kBlue);
+  FillSquareArgb32(quad, 8, 8, 8, 8, 64, kYellow);
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = 16;
+  frame_view.height_ = 16;
+  frame_view.argb32_data_ = quad;
+  frame_view.stride_ = 16 * 4;
+
+  // Frames cannot be pushed before the source is live
+  mrsBool dropped = mrsBool::kTrue;
+  ASSERT_EQ(mrsResult::kInvalidOperation,
+            mrsExternalVideoTrackSourcePushArgb32Frame(source_handle, 1,
+                                                       &frame_view, &dropped));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  LocalVideoTrackHandle track_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                pair.pc1(), "push_track", source_handle, &track_handle));
+  ASSERT_NE(nullptr, track_handle);
+
+  std::atomic_uint32_t frame_count{0};
+  Argb32VideoFrameCallback argb_cb =
+      [&frame_count](const mrsArgb32VideoFrame& frame) {
+        ValidateQuadTestFrame(frame.argb32_data_, frame.stride_, frame.width_,
+                              frame.height_);
+        ++frame_count;
+      };
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(),
+                                                          CB(argb_cb));
+
+  pair.ConnectAndWait();
+
+  // Push frames at 30 FPS on the test thread's own clock for 5 seconds
+  const auto start = std::chrono::steady_clock::now();
+  auto next = start;
+  int64_t timestamp_ms = 0;
+  for (int i = 0; i < 150; ++i) {
+    timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       next - start)
+                       .count() +
+                   1;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourcePushArgb32Frame(
+                  source_handle, timestamp_ms, &frame_view, &dropped));
+    ASSERT_EQ(mrsBool::kFalse, dropped);
+    next += std::chrono::microseconds(33333);
+    std::this_thread::sleep_until(next);
+  }
+  ASSERT_LT(50u, frame_count.load());  // at least 10 FPS
+
+  // Out-of-order frames are dropped
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourcePushArgb32Frame(
+                source_handle, timestamp_ms, &frame_view, &dropped));
+  ASSERT_EQ(mrsBool::kTrue, dropped);
+
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(), nullptr,
+                                                          nullptr);
+  mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(), source_handle);
+  mrsLocalVideoTrackRemoveRef(track_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+
+  // Frames cannot be pushed after shutdown
+  ASSERT_EQ(mrsResult::kInvalidOperation,
+            mrsExternalVideoTrackSourcePushArgb32Frame(
+                source_handle, timestamp_ms + 1, &frame_view, &dropped));
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+namespace {
+
+/// I420 frame memory owned by the test and passed without copy, with a flag
+/// set while the native implementation uses it.
+struct WrappedI420Frame {
+  uint8_t y[16 * 16];
+  uint8_t u[8 * 8];
+  uint8_t v[8 * 8];
+  std::atomic_bool in_use{false};
+  std::atomic_int release_count{0};
+
+  mrsI420AVideoFrame view() {
+    mrsI420AVideoFrame frame_view{};
+    frame_view.width_ = 16;
+    frame_view.height_ = 16;
+    frame_view.ydata_ = y;
+    frame_view.udata_ = u;
+    frame_view.vdata_ = v;
+    frame_view.ystride_ = 16;
+    frame_view.ustride_ = 8;
+    frame_view.vstride_ = 8;
+    return frame_view;
+  }
+};
+
+void MRS_CALL ReleaseWrappedI420Frame(void* user_data) {
+  auto frame = (WrappedI420Frame*)user_data;
+  ++frame->release_count;
+  ASSERT_TRUE(frame->in_use.exchange(false));
+}
+
+}  // namespace
+
+TEST(ExternalVideoTrackSource, PushNoCopy) {
+  constexpr int kBufferCount = 4;
+  WrappedI420Frame buffers[kBufferCount];
+  for (auto&& buffer : buffers) {
+    memset(buffer.y, 0x80, sizeof(buffer.y));
+    memset(buffer.u, 0x40, sizeof(buffer.u));
+    memset(buffer.v, 0xC0, sizeof(buffer.v));
+  }
+  int push_count = 0;
+  {
+    LocalPeerPairRaii pair;
+
+    ExternalVideoTrackSourceHandle source_handle = nullptr;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+    mrsExternalVideoTrackSourceFinishCreation(source_handle);
+    LocalVideoTrackHandle track_handle = nullptr;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                  pair.pc1(), "push_track", source_handle, &track_handle));
+
+    std::atomic_uint32_t frame_count{0};
+    I420VideoFrameCallback i420_cb =
+        [&frame_count](const mrsI420AVideoFrame& frame) {
+          ASSERT_EQ(16u, frame.width_);
+          ASSERT_EQ(16u, frame.height_);
+          ++frame_count;
+        };
+    mrsPeerConnectionRegisterI420ARemoteVideoFrameCallback(pair.pc2(),
+                                                           CB(i420_cb));
+
+    pair.ConnectAndWait();
+
+    // Push at 30 FPS for 5 seconds, reusing the buffers once released
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < 150; ++i) {
+      for (auto&& buffer : buffers) {
+        if (buffer.in_use.exchange(true)) {
+          continue;
+        }
+        const mrsI420AVideoFrame frame_view = buffer.view();
+        mrsBool dropped = mrsBool::kTrue;
+        ASSERT_EQ(mrsResult::kSuccess,
+                  mrsExternalVideoTrackSourcePushI420AFrameNoCopy(
+                      source_handle, (i + 1) * 33, &frame_view,
+                      &ReleaseWrappedI420Frame, &buffer, &dropped));
+        ASSERT_EQ(mrsBool::kFalse, dropped);
+        ++push_count;
+        break;
+      }
+      next += std::chrono::microseconds(33333);
+      std::this_thread::sleep_until(next);
+    }
+    ASSERT_LT(50u, frame_count.load());  // at least 10 FPS
+
+    // Frames not used are released immediately, before the call returns
+    const mrsI420AVideoFrame frame_view = buffers[0].view();
+    while (buffers[0].in_use.exchange(true)) {
+      std::this_thread::yield();
+    }
+    const int release_count = buffers[0].release_count.load();
+    mrsBool dropped = mrsBool::kFalse;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourcePushI420AFrameNoCopy(
+                  source_handle, 1, &frame_view, &ReleaseWrappedI420Frame,
+                  &buffers[0], &dropped));
+    ASSERT_EQ(mrsBool::kTrue, dropped);
+    ASSERT_EQ(release_count + 1, buffers[0].release_count.load());
+    ++push_count;
+
+    mrsPeerConnectionRegisterI420ARemoteVideoFrameCallback(pair.pc2(),
+                                                           nullptr, nullptr);
+    mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(),
+                                                      source_handle);
+    mrsLocalVideoTrackRemoveRef(track_handle);
+    mrsExternalVideoTrackSourceShutdown(source_handle);
+    mrsExternalVideoTrackSourceRemoveRef(source_handle);
+  }
+
+  // All frames are released once the connection is closed
+  int release_count = 0;
+  for (auto&& buffer : buffers) {
+    ASSERT_FALSE(buffer.in_use.load());
+    release_count += buffer.release_count.load();
+  }
+  ASSERT_EQ(push_count, release_count);
+}
+
+TEST(ExternalVideoTrackSource, CompleteNoCopyInvalidRequest) {
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                &GenerateQuadTestFrame, nullptr, &source_handle));
+  WrappedI420Frame buffer;
+  buffer.in_use = true;
+  const mrsI420AVideoFrame frame_view = buffer.view();
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourceCompleteI420AFrameRequestNoCopy(
+                source_handle, 0xFFFFFFFFu, 0, &frame_view,
+                &ReleaseWrappedI420Frame, &buffer));
+  ASSERT_EQ(1, buffer.release_count.load());
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, CompleteDirtyAfterShutdown) {
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                &GenerateQuadTestFrame, nullptr, &source_handle));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+
+  // A request completed late, after the source shut down, fails cleanly
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = 16;
+  frame_view.height_ = 16;
+  frame_view.argb32_data_ = FrameBuffer;
+  frame_view.stride_ = 16 * 4;
+  const mrsVideoRect dirty_rect{0, 0, 16, 16};
+  ASSERT_EQ(mrsResult::kInvalidOperation,
+            mrsExternalVideoTrackSourceCompleteArgb32FrameRequestDirty(
+                source_handle, 0, 0, &frame_view, &dirty_rect, 1));
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, PushToPullSource) {
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                &GenerateQuadTestFrame, nullptr, &source_handle));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = 16;
+  frame_view.height_ = 16;
+  frame_view.argb32_data_ = FrameBuffer;
+  frame_view.stride_ = 16 * 4;
+  ASSERT_EQ(mrsResult::kInvalidOperation,
+            mrsExternalVideoTrackSourcePushArgb32Frame(source_handle, 1,
+                                                       &frame_view, nullptr));
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, WantedFormat) {
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  mrsWantedVideoFormat format{};
+  ASSERT_EQ(mrsResult::kInvalidNativeHandle,
+            mrsExternalVideoTrackSourceGetWantedFormat(nullptr, 1280, 720,
+                                                       &format));
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourceGetWantedFormat(source_handle, 1280,
+                                                       720, nullptr));
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourceGetWantedFormat(source_handle, 0, 720,
+                                                       &format));
+
+  // Without any track, the native format is wanted
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceGetWantedFormat(source_handle, 1280,
+                                                       720, &format));
+  ASSERT_EQ(1280, format.width_);
+  ASSERT_EQ(720, format.height_);
+  ASSERT_EQ(std::numeric_limits<int32_t>::max(), format.max_framerate_);
+
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, StaticFrames) {
+  LocalPeerPairRaii pair;
+
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  ASSERT_EQ(mrsResult::kInvalidNativeHandle,
+            mrsExternalVideoTrackSourceSetStaticFramePolicy(
+                nullptr, mrsStaticFramePolicy::kDrop));
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourceSetStaticFramePolicy(
+                source_handle, (mrsStaticFramePolicy)3));
+
+  LocalVideoTrackHandle track_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                pair.pc1(), "static_track", source_handle, &track_handle));
+
+  std::atomic_uint32_t frame_count{0};
+  Argb32VideoFrameCallback argb_cb =
+      [&frame_count](const mrsArgb32VideoFrame& frame) {
+        ValidateQuadTestFrame(frame.argb32_data_, frame.stride_, frame.width_,
+                              frame.height_);
+        ++frame_count;
+      };
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(),
+                                                          CB(argb_cb));
+
+  pair.ConnectAndWait();
+
+  uint32_t quad[256]{};
+  FillSquareArgb32(quad, 0, 0, 8, 8, 64, kRed);
+  FillSquareArgb32(quad, 8, 0, 8, 8, 64, kGreen);
+  FillSquareArgb32(quad, 0, 8, 8, 8, 64, kBlue);
+  FillSquareArgb32(quad, 8, 8, 8, 8, 64, kYellow);
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = 16;
+  frame_view.height_ = 16;
+  frame_view.argb32_data_ = quad;
+  frame_view.stride_ = 16 * 4;
+
+  // Push frames at 30 FPS, optionally changing one pixel slightly for each
+  // frame, and return the number of frames delivered.
+  int64_t timestamp_ms = 0;
+  auto push_frames = [&](int count, bool change) {
+    int delivered_count = 0;
+    for (int i = 0; i < count; ++i) {
+      if (change) {
+        quad[0] = (i % 2) ? kRed : (kRed ^ 0x00010000u);
+      }
+      timestamp_ms += 33;
+      mrsBool dropped = mrsBool::kTrue;
+      EXPECT_EQ(mrsResult::kSuccess,
+                mrsExternalVideoTrackSourcePushArgb32Frame(
+                    source_handle, timestamp_ms, &frame_view, &dropped));
+      delivered_count += (dropped == mrsBool::kFalse ? 1 : 0);
+      std::this_thread::sleep_for(std::chrono::milliseconds(33));
+    }
+    return delivered_count;
+  };
+
+  // Static frames are dropped, except about once per second
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceSetStaticFramePolicy(
+                source_handle, mrsStaticFramePolicy::kDrop));
+  int delivered_count = push_frames(90, false);
+  ASSERT_LE(1, delivered_count);
+  ASSERT_GE(4, delivered_count);
+
+  // Changing frames are not dropped
+  delivered_count = push_frames(60, true);
+  ASSERT_LT(40, delivered_count);
+
+  // Static frames are repeated without being converted again
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceSetStaticFramePolicy(
+                source_handle, mrsStaticFramePolicy::kRepeat));
+  const uint32_t frame_count_before = frame_count.load();
+  delivered_count = push_frames(60, false);
+  ASSERT_LT(40, delivered_count);
+  ASSERT_LT(frame_count_before + 20, frame_count.load());
+
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(), nullptr,
+                                                          nullptr);
+  mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(), source_handle);
+  mrsLocalVideoTrackRemoveRef(track_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, PushDirty) {
+  LocalPeerPairRaii pair;
+
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  LocalVideoTrackHandle track_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                pair.pc1(), "dirty_track", source_handle, &track_handle));
+
+  uint32_t quad[256]{};
+  FillSquareArgb32(quad, 0, 0, 16, 16, 64, kRed);
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = 16;
+  frame_view.height_ = 16;
+  frame_view.argb32_data_ = quad;
+  frame_view.stride_ = 16 * 4;
+
+  mrsBool dropped = mrsBool::kTrue;
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourcePushArgb32FrameDirty(
+                source_handle, 1, &frame_view, nullptr, 1, &dropped));
+  ASSERT_EQ(mrsResult::kInvalidParameter,
+            mrsExternalVideoTrackSourcePushArgb32FrameDirty(
+                source_handle, 1, &frame_view, nullptr, -1, &dropped));
+
+  // The first frame is converted as a whole, even if dropped because the
+  // track is not connected yet.
+  int64_t timestamp_ms = 1;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourcePushArgb32FrameDirty(
+                source_handle, timestamp_ms, &frame_view, nullptr, 0,
+                &dropped));
+
+  std::atomic_uint32_t frame_count{0};
+  Argb32VideoFrameCallback argb_cb =
+      [&frame_count](const mrsArgb32VideoFrame& frame) {
+        ValidateQuadTestFrame(frame.argb32_data_, frame.stride_, frame.width_,
+                              frame.height_);
+        ++frame_count;
+      };
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(),
+                                                          CB(argb_cb));
+
+  pair.ConnectAndWait();
+
+  // Update all quadrants but the top left one, which changes in memory but is
+  // not marked as dirty, so keeps its previous color.
+  FillSquareArgb32(quad, 0, 0, 8, 8, 64, kBlue);
+  FillSquareArgb32(quad, 8, 0, 8, 8, 64, kGreen);
+  FillSquareArgb32(quad, 0, 8, 8, 8, 64, kBlue);
+  FillSquareArgb32(quad, 8, 8, 8, 8, 64, kYellow);
+  const mrsVideoRect dirty_rects[2]{{8, 0, 8, 8}, {0, 8, 16, 8}};
+  for (int i = 0; i < 150; ++i) {
+    timestamp_ms += 33;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourcePushArgb32FrameDirty(
+                  source_handle, timestamp_ms, &frame_view, dirty_rects, 2,
+                  &dropped));
+    std::this_thread::sleep_for(std::chrono::milliseconds(33));
+  }
+  ASSERT_LT(50u, frame_count.load());  // at least 10 FPS
+
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(), nullptr,
+                                                          nullptr);
+  mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(), source_handle);
+  mrsLocalVideoTrackRemoveRef(track_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+namespace {
+
+/// Threads on which the frame requests of several sources were issued.
+struct CaptureThreadLog {
+  std::mutex mutex_;
+  std::unordered_set<std::thread::id> threads_;
+};
+
+/// Frame requests of a single source sharing a |CaptureThreadLog|.
+struct SourceRequestLog {
+  CaptureThreadLog* threads_;
+  std::atomic_uint32_t request_count_{0};
+};
+
+/// Log the thread of a frame request, without completing it.
+mrsResult MRS_CALL
+LogRequestThread(void* user_data,
+                 ExternalVideoTrackSourceHandle /*source_handle*/,
+                 uint32_t /*request_id*/,
+                 int64_t /*timestamp_ms*/) {
+  auto log = (SourceRequestLog*)user_data;
+  {
+    std::scoped_lock lock(log->threads_->mutex_);
+    log->threads_->threads_.insert(std::this_thread::get_id());
+  }
+  ++log->request_count_;
+  return mrsResult::kSuccess;
+}
+
+}  // namespace
+
+TEST(ExternalVideoTrackSource, SharedCaptureThreads) {
+  constexpr int kSourceCount = 32;
+  CaptureThreadLog thread_log;
+  SourceRequestLog logs[kSourceCount];
+  ExternalVideoTrackSourceHandle source_handles[kSourceCount]{};
+  for (int i = 0; i < kSourceCount; ++i) {
+    logs[i].threads_ = &thread_log;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                  &LogRequestThread, &logs[i], &source_handles[i]));
+    mrsExternalVideoTrackSourceFinishCreation(source_handles[i]);
+  }
+
+  // All sources run at their own rate on a few shared threads
+  Event ev;
+  ev.WaitFor(2s);
+  for (int i = 0; i < kSourceCount; ++i) {
+    ASSERT_LT(40u, logs[i].request_count_.load());  // 30 FPS by default
+  }
+  {
+    std::scoped_lock lock(thread_log.mutex_);
+    ASSERT_GE(4u, thread_log.threads_.size());  // kMaxDefaultThreadCount
+  }
+
+  // Stopped sources do not receive any request anymore, while the sources
+  // sharing their threads keep running.
+  uint32_t stopped_counts[kSourceCount / 2];
+  uint32_t running_counts[kSourceCount / 2];
+  for (int i = 0; i < kSourceCount / 2; ++i) {
+    mrsExternalVideoTrackSourceShutdown(source_handles[i]);
+    stopped_counts[i] = logs[i].request_count_.load();
+  }
+  for (int i = 0; i < kSourceCount / 2; ++i) {
+    running_counts[i] = logs[kSourceCount / 2 + i].request_count_.load();
+  }
+  ev.WaitFor(500ms);
+  for (int i = 0; i < kSourceCount / 2; ++i) {
+    ASSERT_EQ(stopped_counts[i], logs[i].request_count_.load());
+    ASSERT_LT(running_counts[i] + 5,
+              logs[kSourceCount / 2 + i].request_count_.load());
+  }
+
+  for (int i = 0; i < kSourceCount; ++i) {
+    mrsExternalVideoTrackSourceShutdown(source_handles[i]);
+    mrsExternalVideoTrackSourceRemoveRef(source_handles[i]);
+  }
+}
+
+namespace {
+
+/// Count the frame requests of a source in the |std::atomic_uint32_t| passed as
+/// user data, then complete them like |GenerateQuadTestFrame()|. Since each
+/// completed request is converted once, this also counts the conversions.
+mrsResult MRS_CALL
+CountAndGenerateQuadTestFrame(void* user_data,
+                              ExternalVideoTrackSourceHandle source_handle,
+                              uint32_t request_id,
+                              int64_t timestamp_ms) {
+  ++*(std::atomic_uint32_t*)user_data;
+  return GenerateQuadTestFrame(nullptr, source_handle, request_id,
+                               timestamp_ms);
+}
+
+/// Peer pair receiving the frames of a source shared with other pairs.
+struct FanOutPeer {
+  LocalPeerPairRaii pair_;
+  LocalVideoTrackHandle track_handle_ = nullptr;
+  std::atomic_uint32_t frame_count_{0};
+  Argb32VideoFrameCallback argb_cb_;
+};
+
+}  // namespace
+
+TEST(ExternalVideoTrackSource, FanOut) {
+  constexpr int kPeerCount = 32;
+  std::atomic_uint32_t request_count{0};
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                &CountAndGenerateQuadTestFrame, &request_count,
+                &source_handle));
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  // Add a track backed by the same source to each peer connection
+  std::vector<std::unique_ptr<FanOutPeer>> peers(kPeerCount);
+  for (auto&& peer : peers) {
+    peer = std::make_unique<FanOutPeer>();
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                  peer->pair_.pc1(), "fan_out_track", source_handle,
+                  &peer->track_handle_));
+    ASSERT_NE(nullptr, peer->track_handle_);
+    std::atomic_uint32_t* const frame_count = &peer->frame_count_;
+    peer->argb_cb_ = [frame_count](const mrsArgb32VideoFrame& frame) {
+      ValidateQuadTestFrame(frame.argb32_data_, frame.stride_, frame.width_,
+                            frame.height_);
+      ++*frame_count;
+    };
+    mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(
+        peer->pair_.pc2(), CB(peer->argb_cb_));
+  }
+  for (auto&& peer : peers) {
+    peer->pair_.ConnectAndWait();
+  }
+
+  // All peers receive the frames, which are converted once for all of them
+  const uint32_t requests_before = request_count.load();
+  Event ev;
+  ev.WaitFor(5s);
+  const uint32_t requests = request_count.load() - requests_before;
+  ASSERT_GE(160u, requests);  // 30 FPS by default
+  for (auto&& peer : peers) {
+    ASSERT_LT(25u, peer->frame_count_.load());  // at least 5 FPS
+  }
+
+  // Removing the tracks of some peers does not affect the other peers
+  for (int i = 0; i < kPeerCount / 2; ++i) {
+    mrsPeerConnectionRemoveLocalVideoTracksFromSource(peers[i]->pair_.pc1(),
+                                                      source_handle);
+  }
+  ev.WaitFor(500ms);  // let in-flight frames be delivered
+  uint32_t counts[kPeerCount];
+  for (int i = 0; i < kPeerCount; ++i) {
+    counts[i] = peers[i]->frame_count_.load();
+  }
+  ev.WaitFor(1s);
+  for (int i = 0; i < kPeerCount / 2; ++i) {
+    ASSERT_EQ(counts[i], peers[i]->frame_count_.load());
+  }
+  for (int i = kPeerCount / 2; i < kPeerCount; ++i) {
+    ASSERT_LT(counts[i] + 5, peers[i]->frame_count_.load());
+  }
+
+  for (auto&& peer : peers) {
+    mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(peer->pair_.pc2(),
+                                                            nullptr, nullptr);
+    mrsPeerConnectionRemoveLocalVideoTracksFromSource(peer->pair_.pc1(),
+                                                      source_handle);
+    mrsLocalVideoTrackRemoveRef(peer->track_handle_);
+  }
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+namespace {
+
+/// Quad test frame converted from ARGB32 to each of the other input encodings.
+struct QuadTestFrames {
+  uint32_t argb32[256];
+  uint8_t nv12_y[256];
+  uint8_t nv12_uv[128];
+  uint8_t yuy2[512];
+  uint8_t bgr24[768];
+  uint8_t rgba32[1024];
+
+  QuadTestFrames() {
+    memset(argb32, 0, sizeof(argb32));
+    FillSquareArgb32(argb32, 0, 0, 8, 8, 64, kRed);
+    FillSquareArgb32(argb32, 8, 0, 8, 8, 64, kGreen);
+    FillSquareArgb32(argb32, 0, 8, 8, 8, 64, kBlue);
+    FillSquareArgb32(argb32, 8, 8, 8, 8, 64, kYellow);
+    const uint8_t* src = (const uint8_t*)argb32;
+    libyuv::ARGBToNV12(src, 64, nv12_y, 16, nv12_uv, 16, 16, 16);
+    libyuv::ARGBToYUY2(src, 64, yuy2, 32, 16, 16);
+    libyuv::ARGBToRGB24(src, 64, bgr24, 48, 16, 16);
+    libyuv::ARGBToABGR(src, 64, rgba32, 64, 16, 16);
+  }
+
+  mrsNv12VideoFrame nv12_view() const {
+    mrsNv12VideoFrame frame_view{};
+    frame_view.width_ = 16;
+    frame_view.height_ = 16;
+    frame_view.ydata_ = nv12_y;
+    frame_view.uvdata_ = nv12_uv;
+    frame_view.ystride_ = 16;
+    frame_view.uvstride_ = 16;
+    return frame_view;
+  }
+
+  mrsYuy2VideoFrame yuy2_view() const {
+    mrsYuy2VideoFrame frame_view{};
+    frame_view.width_ = 16;
+    frame_view.height_ = 16;
+    frame_view.yuy2_data_ = yuy2;
+    frame_view.stride_ = 32;
+    return frame_view;
+  }
+
+  mrsBgr24VideoFrame bgr24_view() const {
+    mrsBgr24VideoFrame frame_view{};
+    frame_view.width_ = 16;
+    frame_view.height_ = 16;
+    frame_view.bgr24_data_ = bgr24;
+    frame_view.stride_ = 48;
+    return frame_view;
+  }
+
+  mrsRgba32VideoFrame rgba32_view() const {
+    mrsRgba32VideoFrame frame_view{};
+    frame_view.width_ = 16;
+    frame_view.height_ = 16;
+    frame_view.rgba32_data_ = rgba32;
+    frame_view.stride_ = 64;
+    return frame_view;
+  }
+};
+
+/// Complete a frame request with an NV12 quad test frame.
+mrsResult MRS_CALL GenerateNv12QuadTestFrame(
+    void* user_data,
+    ExternalVideoTrackSourceHandle source_handle,
+    uint32_t request_id,
+    int64_t timestamp_ms) {
+  auto frames = (const QuadTestFrames*)user_data;
+  const mrsNv12VideoFrame frame_view = frames->nv12_view();
+  return mrsExternalVideoTrackSourceCompleteNv12FrameRequest(
+      source_handle, request_id, timestamp_ms, &frame_view);
+}
+
+}  // namespace
+
+TEST(ExternalVideoTrackSource, Nv12Callback) {
+  LocalPeerPairRaii pair;
+  QuadTestFrames frames;
+
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromNv12Callback(
+                &GenerateNv12QuadTestFrame, &frames, &source_handle));
+  ASSERT_NE(nullptr, source_handle);
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  LocalVideoTrackHandle track_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                pair.pc1(), "nv12_track", source_handle, &track_handle));
+  ASSERT_NE(nullptr, track_handle);
+
+  std::atomic_uint32_t frame_count{0};
+  Argb32VideoFrameCallback argb_cb =
+      [&frame_count](const mrsArgb32VideoFrame& frame) {
+        ValidateQuadTestFrame(frame.argb32_data_, frame.stride_, frame.width_,
+                              frame.height_);
+        ++frame_count;
+      };
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(),
+                                                          CB(argb_cb));
+
+  pair.ConnectAndWait();
+
+  Event ev;
+  ev.WaitFor(5s);
+  ASSERT_LT(50u, frame_count.load());  // at least 10 FPS
+
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(), nullptr,
+                                                          nullptr);
+  mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(), source_handle);
+  mrsLocalVideoTrackRemoveRef(track_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+TEST(ExternalVideoTrackSource, PushFormats) {
+  LocalPeerPairRaii pair;
+  QuadTestFrames frames;
+  const mrsNv12VideoFrame nv12 = frames.nv12_view();
+  const mrsYuy2VideoFrame yuy2 = frames.yuy2_view();
+  const mrsBgr24VideoFrame bgr24 = frames.bgr24_view();
+  const mrsRgba32VideoFrame rgba32 = frames.rgba32_view();
+
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+  ASSERT_NE(nullptr, source_handle);
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+
+  LocalVideoTrackHandle track_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                pair.pc1(), "push_track", source_handle, &track_handle));
+  ASSERT_NE(nullptr, track_handle);
+
+  std::atomic_uint32_t frame_count{0};
+  Argb32VideoFrameCallback argb_cb =
+      [&frame_count](const mrsArgb32VideoFrame& frame) {
+        ValidateQuadTestFrame(frame.argb32_data_, frame.stride_, frame.width_,
+                              frame.height_);
+        ++frame_count;
+      };
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(),
+                                                          CB(argb_cb));
+
+  pair.ConnectAndWait();
+
+  // Push each encoding in turn at 30 FPS for 2 seconds, and check that the
+  // remote peer receives the same quad each time.
+  int64_t timestamp_ms = 0;
+  for (int format = 0; format < 4; ++format) {
+    frame_count = 0;
+    for (int i = 0; i < 60; ++i) {
+      timestamp_ms += 33;
+      mrsBool dropped = mrsBool::kTrue;
+      mrsResult result = mrsResult::kUnknownError;
+      switch (format) {
+        case 0:
+          result = mrsExternalVideoTrackSourcePushNv12Frame(
+              source_handle, timestamp_ms, &nv12, &dropped);
+          break;
+        case 1:
+          result = mrsExternalVideoTrackSourcePushYuy2Frame(
+              source_handle, timestamp_ms, &yuy2, &dropped);
+          break;
+        case 2:
+          result = mrsExternalVideoTrackSourcePushBgr24Frame(
+              source_handle, timestamp_ms, &bgr24, &dropped);
+          break;
+        case 3:
+          result = mrsExternalVideoTrackSourcePushRgba32Frame(
+              source_handle, timestamp_ms, &rgba32, &dropped);
+          break;
+      }
+      ASSERT_EQ(mrsResult::kSuccess, result);
+      ASSERT_EQ(mrsBool::kFalse, dropped);
+      std::this_thread::sleep_for(std::chrono::milliseconds(33));
+    }
+    ASSERT_LT(20u, frame_count.load());  // at least 10 FPS
+  }
+
+  mrsPeerConnectionRegisterArgb32RemoteVideoFrameCallback(pair.pc2(), nullptr,
+                                                          nullptr);
+  mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(), source_handle);
+  mrsLocalVideoTrackRemoveRef(track_handle);
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+}
+
+namespace {
+
+constexpr int kBenchWidth = 640;
+constexpr int kBenchHeight = 480;
+constexpr int kBenchFrameCount = 300;  // 5 seconds at 60 FPS
+
+/// Producer of 60 FPS frames on its own clock, for the pull model. Frames
+/// are identified by their production time; a request completes with the
+/// latest frame produced.
+struct PullBenchState {
+  std::vector<uint32_t> pixels =
+      std::vector<uint32_t>(kBenchWidth * kBenchHeight, kRed);
+  std::mutex mutex_;
+  Clock::time_point latest_produced_ RTC_GUARDED_BY(mutex_){};
+  uint64_t produced_count_ RTC_GUARDED_BY(mutex_){0};
+  uint64_t last_delivered_index_{0};
+  std::vector<Clock::duration> call_durations_;
+  std::vector<Clock::duration> latencies_;
+  int duplicate_count_{0};
+};
+
+mrsResult MRS_CALL
+CompleteWithLatestFrame(void* user_data,
+                        ExternalVideoTrackSourceHandle source_handle,
+                        uint32_t request_id,
+                        int64_t timestamp_ms) {
+  const Clock::time_point start = Clock::now();
+  auto state = (PullBenchState*)user_data;
+  Clock::time_point produced;
+  {
+    std::scoped_lock lock(state->mutex_);
+    if (state->produced_count_ == 0) {
+      return mrsResult::kSuccess;  // nothing to deliver yet
+    }
+    if (state->produced_count_ == state->last_delivered_index_) {
+      ++state->duplicate_count_;
+    }
+    state->last_delivered_index_ = state->produced_count_;
+    produced = state->latest_produced_;
+  }
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = kBenchWidth;
+  frame_view.height_ = kBenchHeight;
+  frame_view.argb32_data_ = state->pixels.data();
+  frame_view.stride_ = kBenchWidth * 4;
+  const mrsResult result =
+      mrsExternalVideoTrackSourceCompleteArgb32FrameRequest(
+          source_handle, request_id, timestamp_ms, &frame_view);
+  const Clock::time_point end = Clock::now();
+  state->call_durations_.push_back(end - start);
+  state->latencies_.push_back(end - produced);
+  return result;
+}
+
+}  // namespace
+
+// Compare the delivery latency of frames produced on the producer's own 60 FPS
+// clock between the pull model, where the frame waits for the next request,
+// and the push model, where it is delivered immediately.
+TEST(ExternalVideoTrackSource, PushPullBenchmark) {
+  LocalPeerPairRaii pair;
+  const auto period = std::chrono::microseconds(16667);
+
+  // Pull model
+  {
+    PullBenchState state;
+    ExternalVideoTrackSourceHandle source_handle = nullptr;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                  &CompleteWithLatestFrame, &state, &source_handle));
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourceSetFrameRate(source_handle, 60.0));
+    mrsExternalVideoTrackSourceFinishCreation(source_handle);
+    LocalVideoTrackHandle track_handle = nullptr;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                  pair.pc1(), "pull_track", source_handle, &track_handle));
+    auto next = Clock::now();
+    for (int i = 0; i < kBenchFrameCount; ++i) {
+      std::this_thread::sleep_until(next);
+      {
+        std::scoped_lock lock(state.mutex_);
+        state.latest_produced_ = Clock::now();
+        ++state.produced_count_;
+      }
+      next += period;
+    }
+    mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(),
+                                                      source_handle);
+    mrsLocalVideoTrackRemoveRef(track_handle);
+    mrsExternalVideoTrackSourceShutdown(source_handle);
+    mrsExternalVideoTrackSourceRemoveRef(source_handle);
+
+    const int delivered = (int)state.latencies_.size();
+    ASSERT_LT(kBenchFrameCount / 2, delivered);
+    const DurationStats cost = ComputeStats(state.call_durations_);
+    const DurationStats latency = ComputeStats(state.latencies_);
+    printf(
+        "Pull: %d frames produced, %d delivered (%d duplicates); call "
+        "mean=%.2fus p99=%.2fus; latency mean=%.2fus p99=%.2fus "
+        "max=%.2fus\n",
+        kBenchFrameCount, delivered, state.duplicate_count_, cost.mean_us,
+        cost.p99_us, latency.mean_us, latency.p99_us, latency.max_us);
+  }
+
+  // Push model
+  {
+    std::vector<uint32_t> pixels(kBenchWidth * kBenchHeight, kRed);
+    ExternalVideoTrackSourceHandle source_handle = nullptr;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsExternalVideoTrackSourceCreateForPush(&source_handle));
+    mrsExternalVideoTrackSourceFinishCreation(source_handle);
+    LocalVideoTrackHandle track_handle = nullptr;
+    ASSERT_EQ(mrsResult::kSuccess,
+              mrsPeerConnectionAddLocalVideoTrackFromExternalSource(
+                  pair.pc1(), "push_track", source_handle, &track_handle));
+    mrsArgb32VideoFrame frame_view{};
+    frame_view.width_ = kBenchWidth;
+    frame_view.height_ = kBenchHeight;
+    frame_view.argb32_data_ = pixels.data();
+    frame_view.stride_ = kBenchWidth * 4;
+    std::vector<Clock::duration> latencies;
+    latencies.reserve(kBenchFrameCount);
+    int dropped_count = 0;
+    const auto start = Clock::now();
+    auto next = start;
+    for (int i = 0; i < kBenchFrameCount; ++i) {
+      std::this_thread::sleep_until(next);
+      const Clock::time_point produced = Clock::now();
+      const int64_t timestamp_ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(produced -
+                                                                start)
+              .count() +
+          1;
+      mrsBool dropped = mrsBool::kFalse;
+      ASSERT_EQ(mrsResult::kSuccess,
+                mrsExternalVideoTrackSourcePushArgb32Frame(
+                    source_handle, timestamp_ms, &frame_view, &dropped));
+      if (dropped == mrsBool::kFalse) {
+        latencies.push_back(Clock::now() - produced);
+      } else {
+        ++dropped_count;
+      }
+      next += period;
+    }
+    mrsPeerConnectionRemoveLocalVideoTracksFromSource(pair.pc1(),
+                                                      source_handle);
+    mrsLocalVideoTrackRemoveRef(track_handle);
+    mrsExternalVideoTrackSourceShutdown(source_handle);
+    mrsExternalVideoTrackSourceRemoveRef(source_handle);
+
+    ASSERT_EQ(0, dropped_count);
+    // Delivery is synchronous, so the push call duration is the latency.
+    const DurationStats latency = ComputeStats(latencies);
+    printf(
+        "Push: %d frames produced, %d delivered; call/latency "
+        "mean=%.2fus p99=%.2fus max=%.2fus\n",
+        kBenchFrameCount, (int)latencies.size(), latency.mean_us,
+        latency.p99_us, latency.max_us);
+  }
+}
+
+namespace {
+
+/// Frame requests handed over from the capture thread of a source to a pool
+/// of completing threads.
+struct ContentionBenchState {
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::pair<uint32_t, int64_t>> requests_ RTC_GUARDED_BY(mutex_);
+  bool done_ RTC_GUARDED_BY(mutex_){false};
+  uint64_t request_count_ RTC_GUARDED_BY(mutex_){0};
+};
+
+mrsResult MRS_CALL QueueFrameRequest(void* user_data,
+                                     ExternalVideoTrackSourceHandle /*source*/,
+                                     uint32_t request_id,
+                                     int64_t timestamp_ms) {
+  auto state = (ContentionBenchState*)user_data;
+  {
+    std::scoped_lock lock(state->mutex_);
+    state->requests_.emplace_back(request_id, timestamp_ms);
+    ++state->request_count_;
+  }
+  state->cv_.notify_one();
+  return mrsResult::kSuccess;
+}
+
+}  // namespace
+
+// Complete the frame requests of a source at its maximum frame rate from a
+// pool of threads, like producers completing from worker pools, to measure the
+// cost of validating the requests under contention. The source has no track,
+// so frames are dropped right after their request is validated. Requests
+// completed after a more recent one are outdated, and rejected. Completions
+// are serialized by the delivery lock of the source, so that frames are
+// delivered in order.
+TEST(ExternalVideoTrackSource, CompleteContentionBenchmark) {
+  constexpr int kThreadCount = 4;
+  ContentionBenchState state;
+  ExternalVideoTrackSourceHandle source_handle = nullptr;
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceCreateFromArgb32Callback(
+                &QueueFrameRequest, &state, &source_handle));
+  ASSERT_EQ(mrsResult::kSuccess,
+            mrsExternalVideoTrackSourceSetFrameRate(source_handle, 1000.0));
+
+  uint32_t pixels[256]{};
+  FillSquareArgb32(pixels, 0, 0, 16, 16, 64, kRed);
+  mrsArgb32VideoFrame frame_view{};
+  frame_view.width_ = 16;
+  frame_view.height_ = 16;
+  frame_view.argb32_data_ = pixels;
+  frame_view.stride_ = 16 * 4;
+
+  std::atomic_int completed_count{0};
+  std::atomic_int outdated_count{0};
+  std::vector<std::vector<Clock::duration>> durations(kThreadCount);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([&, i]() {
+      while (true) {
+        std::pair<uint32_t, int64_t> request;
+        {
+          std::unique_lock<std::mutex> lock(state.mutex_);
+          state.cv_.wait(lock, [&state]() {
+            return state.done_ || !state.requests_.empty();
+          });
+          if (state.done_) {
+            return;
+          }
+          request = state.requests_.front();
+          state.requests_.pop_front();
+        }
+        const Clock::time_point start = Clock::now();
+        const mrsResult result =
+            mrsExternalVideoTrackSourceCompleteArgb32FrameRequest(
+                source_handle, request.first, request.second, &frame_view);
+        durations[i].push_back(Clock::now() - start);
+        if (result == mrsResult::kSuccess) {
+          ++completed_count;
+        } else if (result == mrsResult::kInvalidParameter) {
+          ++outdated_count;
+        }
+      }
+    });
+  }
+
+  mrsExternalVideoTrackSourceFinishCreation(source_handle);
+  std::this_thread::sleep_for(std::chrono::seconds(3));
+  uint64_t request_count = 0;
+  {
+    std::scoped_lock lock(state.mutex_);
+    state.done_ = true;
+    request_count = state.request_count_;
+  }
+  state.cv_.notify_all();
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  mrsExternalVideoTrackSourceShutdown(source_handle);
+  mrsExternalVideoTrackSourceRemoveRef(source_handle);
+
+  std::vector<Clock::duration> all_durations;
+  for (auto&& thread_durations : durations) {
+    all_durations.insert(all_durations.end(), thread_durations.begin(),
+                         thread_durations.end());
+  }
+  ASSERT_LT(0, completed_count.load());
+  ASSERT_EQ((size_t)(completed_count.load() + outdated_count.load()),
+            all_durations.size());
+  const DurationStats cost = ComputeStats(all_durations);
+  printf(
+      "Contention: %d threads, %llu requests, %d completed, %d outdated; "
+      "call mean=%.2fus p99=%.2fus max=%.2fus\n",
+      kThreadCount, (unsigned long long)request_count, completed_count.load(),
+      outdated_count.load(), cost.mean_us, cost.p99_us, cost.max_us);
+}
+
 #endif  // MRSW_EXCLUDE_DEVICE_TESTS
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+//< FIXME - Internal symbols not exported, need static linking
+#if 0
+
+#include <limits>
+#include <vector>
+
+#include "libyuv.h"
+#include "media/external_video_track_source_impl.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+namespace {
+
+constexpr uint32_t kRed = 0xFF2250F2u;
+constexpr uint32_t kGreen = 0xFF00BA7Fu;
+constexpr uint32_t kBlue = 0xFFEFA400u;
+constexpr uint32_t kYellow = 0xFF00B9FFu;
+
+/// Buffer adapter only used to convert frames.
+class TestBufferAdapter : public detail::BufferAdapter {
+ public:
+  Result RequestFrame(ExternalVideoTrackSource& /*track_source*/,
+                      uint32_t /*request_id*/,
+                      int64_t /*time_ms*/) noexcept override {
+    return Result::kInvalidOperation;
+  }
+};
+
+/// Generate a square ARGB32 frame with one color per quadrant.
+std::vector<uint32_t> MakeQuadFrame(int size) {
+  std::vector<uint32_t> argb(size * size);
+  const int half = size / 2;
+  for (int j = 0; j < size; ++j) {
+    for (int i = 0; i < size; ++i) {
+      argb[j * size + i] = (j < half) ? ((i < half) ? kRed : kGreen)
+                                      : ((i < half) ? kBlue : kYellow);
+    }
+  }
+  return argb;
+}
+
+/// Convert back an I420 buffer to ARGB32 to check its colors.
+std::vector<uint32_t> ToArgb32(webrtc::VideoFrameBuffer& buffer) {
+  rtc::scoped_refptr<webrtc::I420BufferInterface> i420 = buffer.ToI420();
+  std::vector<uint32_t> argb(i420->width() * i420->height());
+  libyuv::I420ToARGB(i420->DataY(), i420->StrideY(), i420->DataU(),
+                     i420->StrideU(), i420->DataV(), i420->StrideV(),
+                     (uint8_t*)argb.data(), i420->width() * 4, i420->width(),
+                     i420->height());
+  return argb;
+}
+
+void ExpectColor(uint32_t expected, uint32_t actual) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    EXPECT_NEAR((expected >> shift) & 0xFF, (actual >> shift) & 0xFF, 4);
+  }
+}
+
+/// Sink recording the frames it receives.
+class FrameCountingSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  void OnFrame(const webrtc::VideoFrame& frame) override {
+    ++frame_count_;
+    width_ = frame.width();
+    height_ = frame.height();
+  }
+  int frame_count_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+};
+
+}  // namespace
+
+TEST(FrameAdaptation, ScaleArgb32) {
+  const std::vector<uint32_t> quad = MakeQuadFrame(64);
+  Argb32VideoFrame frame_view{};
+  frame_view.width_ = 64;
+  frame_view.height_ = 64;
+  frame_view.argb32_data_ = quad.data();
+  frame_view.stride_ = 64 * 4;
+  detail::FrameAdaptation adaptation;
+  adaptation.crop_width_ = 64;
+  adaptation.crop_height_ = 64;
+  adaptation.width_ = 32;
+  adaptation.height_ = 32;
+  TestBufferAdapter adapter;
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+      adapter.FillBuffer(frame_view, adaptation);
+  ASSERT_EQ(32, buffer->width());
+  ASSERT_EQ(32, buffer->height());
+  const std::vector<uint32_t> argb = ToArgb32(*buffer);
+  ExpectColor(kRed, argb[8 * 32 + 8]);
+  ExpectColor(kGreen, argb[8 * 32 + 24]);
+  ExpectColor(kBlue, argb[24 * 32 + 8]);
+  ExpectColor(kYellow, argb[24 * 32 + 24]);
+}
+
+TEST(FrameAdaptation, CropNv12) {
+  // Crop the bottom right quadrant of an NV12 frame
+  const std::vector<uint32_t> quad = MakeQuadFrame(64);
+  std::vector<uint8_t> y(64 * 64);
+  std::vector<uint8_t> uv(64 * 32);
+  libyuv::ARGBToNV12((const uint8_t*)quad.data(), 64 * 4, y.data(), 64,
+                     uv.data(), 64, 64, 64);
+  Nv12VideoFrame frame_view{};
+  frame_view.width_ = 64;
+  frame_view.height_ = 64;
+  frame_view.ydata_ = y.data();
+  frame_view.uvdata_ = uv.data();
+  frame_view.ystride_ = 64;
+  frame_view.uvstride_ = 64;
+  detail::FrameAdaptation adaptation;
+  adaptation.crop_x_ = 32;
+  adaptation.crop_y_ = 32;
+  adaptation.crop_width_ = 32;
+  adaptation.crop_height_ = 32;
+  adaptation.width_ = 16;
+  adaptation.height_ = 16;
+  TestBufferAdapter adapter;
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+      adapter.FillBuffer(frame_view, adaptation);
+  ASSERT_EQ(16, buffer->width());
+  ASSERT_EQ(16, buffer->height());
+  const std::vector<uint32_t> argb = ToArgb32(*buffer);
+  ExpectColor(kYellow, argb[0]);
+  ExpectColor(kYellow, argb[15 * 16 + 15]);
+}
+
+// Push frames to a source whose sink wants fewer and smaller frames, and check
+// that the source drops and scales them, and reports the wanted format.
+TEST(FrameAdaptation, PushToSinkWants) {
+  RefPtr<ExternalVideoTrackSource> source =
+      ExternalVideoTrackSource::createForPush();
+  auto impl = static_cast<detail::ExternalVideoTrackSourceImpl*>(source.get());
+  impl->FinishCreation();
+
+  mrsWantedVideoFormat format = source->GetWantedFormat(64, 64);
+  ASSERT_EQ(64, format.width_);
+  ASSERT_EQ(64, format.height_);
+  ASSERT_EQ(std::numeric_limits<int32_t>::max(), format.max_framerate_);
+
+  FrameCountingSink sink;
+  rtc::VideoSinkWants wants;
+  wants.max_pixel_count = 32 * 32;
+  wants.max_framerate_fps = 15;
+  impl->impl()->AddOrUpdateSink(&sink, wants);
+  format = source->GetWantedFormat(64, 64);
+  ASSERT_EQ(32, format.width_);
+  ASSERT_EQ(32, format.height_);
+  ASSERT_EQ(15, format.max_framerate_);
+
+  // Push 100 frames at 30 FPS; about half of them are dropped
+  const std::vector<uint32_t> quad = MakeQuadFrame(64);
+  Argb32VideoFrame frame_view{};
+  frame_view.width_ = 64;
+  frame_view.height_ = 64;
+  frame_view.argb32_data_ = quad.data();
+  frame_view.stride_ = 64 * 4;
+  int dropped_count = 0;
+  for (int i = 0; i < 100; ++i) {
+    bool dropped = false;
+    ASSERT_EQ(Result::kSuccess,
+              source->PushFrame((i + 1) * 33, frame_view, dropped));
+    dropped_count += (dropped ? 1 : 0);
+  }
+  ASSERT_EQ(100, sink.frame_count_ + dropped_count);
+  ASSERT_LE(40, sink.frame_count_);
+  ASSERT_GE(60, sink.frame_count_);
+  ASSERT_EQ(32, sink.width_);
+  ASSERT_EQ(32, sink.height_);
+
+  // Frames are only pushed to sinks
+  impl->impl()->RemoveSink(&sink);
+  const int frame_count = sink.frame_count_;
+  bool dropped = false;
+  ASSERT_EQ(Result::kSuccess, source->PushFrame(4000, frame_view, dropped));
+  ASSERT_TRUE(dropped);
+  ASSERT_EQ(frame_count, sink.frame_count_);
+
+  impl->Shutdown();
+}
+
+#endif // #if 0
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "frame_mailbox.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+TEST(FrameMailbox, Empty) {
+  FrameMailbox<int> mailbox;
+  ASSERT_FALSE(mailbox.HasValue());
+  ASSERT_FALSE(mailbox.Take().has_value());
+}
+
+TEST(FrameMailbox, PostTake) {
+  FrameMailbox<int> mailbox;
+  ASSERT_FALSE(mailbox.Post(42));
+  ASSERT_TRUE(mailbox.HasValue());
+  absl::optional<int> value = mailbox.Take();
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ(42, *value);
+  // Taken only once
+  ASSERT_FALSE(mailbox.HasValue());
+  ASSERT_FALSE(mailbox.Take().has_value());
+}
+
+TEST(FrameMailbox, KeepsLatest) {
+  FrameMailbox<int> mailbox;
+  ASSERT_FALSE(mailbox.Post(1));
+  ASSERT_TRUE(mailbox.Post(2));
+  ASSERT_TRUE(mailbox.Post(3));
+  ASSERT_EQ(3, *mailbox.Take());
+  ASSERT_FALSE(mailbox.Post(4));
+  ASSERT_EQ(4, *mailbox.Take());
+}
+
+TEST(FrameMailbox, ReleasesDroppedValues) {
+  FrameMailbox<std::shared_ptr<int>> mailbox;
+  auto first = std::make_shared<int>(1);
+  mailbox.Post(first);
+  mailbox.Post(std::make_shared<int>(2));
+  // The replaced value is released by the mailbox right away
+  ASSERT_EQ(1, first.use_count());
+  auto taken = mailbox.Take();
+  ASSERT_EQ(2, **taken);
+  ASSERT_EQ(1, taken->use_count());
+}
+
+TEST(FrameMailbox, ConcurrentProducerConsumer) {
+  constexpr int kValueCount = 100000;
+  FrameMailbox<int> mailbox;
+  std::atomic_bool done{false};
+  std::thread producer([&]() {
+    for (int i = 1; i <= kValueCount; ++i) {
+      mailbox.Post(i);
+    }
+    done.store(true, std::memory_order_release);
+  });
+  // Values are received in increasing order, and the last one is always
+  // received.
+  int last = 0;
+  for (;;) {
+    const bool producer_done = done.load(std::memory_order_acquire);
+    if (absl::optional<int> value = mailbox.Take()) {
+      ASSERT_GT(*value, last);
+      last = *value;
+    } else if (producer_done) {
+      break;
+    }
+  }
+  producer.join();
+  ASSERT_EQ(kValueCount, last);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <cstdint>
+
+#include "frame_request_ring.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+TEST(FrameRequestRing, PushTake) {
+  FrameRequestRing ring;
+  ASSERT_EQ(0u, ring.size());
+  const uint32_t id0 = ring.Push(100);
+  const uint32_t id1 = ring.Push(133);
+  const uint32_t id2 = ring.Push(166);
+  ASSERT_EQ(3u, ring.size());
+
+  // Completing a request discards the older ones
+  int64_t timestamp_ms = 0;
+  ASSERT_TRUE(ring.Take(id1, timestamp_ms));
+  ASSERT_EQ(133, timestamp_ms);
+  ASSERT_EQ(1u, ring.size());
+  ASSERT_FALSE(ring.Take(id0, timestamp_ms));
+  ASSERT_FALSE(ring.Take(id1, timestamp_ms));
+  ASSERT_TRUE(ring.Take(id2, timestamp_ms));
+  ASSERT_EQ(166, timestamp_ms);
+  ASSERT_EQ(0u, ring.size());
+
+  // Requests not issued yet are invalid
+  ASSERT_FALSE(ring.Take(id2 + 1, timestamp_ms));
+}
+
+TEST(FrameRequestRing, Full) {
+  FrameRequestRing ring;
+  const uint32_t first_id = ring.Push(0);
+  for (uint32_t i = 1; i < FrameRequestRing::kCapacity + 10; ++i) {
+    ring.Push(i);
+  }
+  ASSERT_EQ(FrameRequestRing::kCapacity, ring.size());
+
+  // The oldest requests were discarded
+  int64_t timestamp_ms = 0;
+  ASSERT_FALSE(ring.Take(first_id + 9, timestamp_ms));
+  ASSERT_TRUE(ring.Take(first_id + 10, timestamp_ms));
+  ASSERT_EQ(10, timestamp_ms);
+}
+
+TEST(FrameRequestRing, Clear) {
+  FrameRequestRing ring;
+  const uint32_t id = ring.Push(100);
+  ring.Clear();
+  ASSERT_EQ(0u, ring.size());
+  int64_t timestamp_ms = 0;
+  ASSERT_FALSE(ring.Take(id, timestamp_ms));
+
+  // IDs are not reused after clearing
+  const uint32_t next_id = ring.Push(200);
+  ASSERT_NE(id, next_id);
+  ASSERT_TRUE(ring.Take(next_id, timestamp_ms));
+  ASSERT_EQ(200, timestamp_ms);
+}
+
+TEST(FrameRequestRing, WrapAround) {
+  FrameRequestRing ring(UINT32_MAX - 1);
+  const uint32_t before_wrap1 = ring.Push(10);
+  const uint32_t before_wrap2 = ring.Push(11);
+  const uint32_t after_wrap1 = ring.Push(12);
+  const uint32_t after_wrap2 = ring.Push(13);
+  ASSERT_EQ(UINT32_MAX, before_wrap2);
+  ASSERT_EQ(0u, after_wrap1);
+  ASSERT_EQ(4u, ring.size());
+  int64_t timestamp_ms = 0;
+  ASSERT_TRUE(ring.Take(after_wrap1, timestamp_ms));
+  ASSERT_EQ(12, timestamp_ms);
+  ASSERT_FALSE(ring.Take(before_wrap1, timestamp_ms));
+  ASSERT_FALSE(ring.Take(before_wrap2, timestamp_ms));
+  ASSERT_TRUE(ring.Take(after_wrap2, timestamp_ms));
+  ASSERT_EQ(13, timestamp_ms);
+
+  // The ring keeps discarding the oldest requests across wrap-around
+  FrameRequestRing full_ring(UINT32_MAX - 9);
+  for (int64_t i = 0; i < FrameRequestRing::kCapacity + 20; ++i) {
+    full_ring.Push(i);
+  }
+  ASSERT_EQ(FrameRequestRing::kCapacity, full_ring.size());
+  ASSERT_FALSE(full_ring.Take(9, timestamp_ms));
+  ASSERT_TRUE(full_ring.Take(10, timestamp_ms));
+  ASSERT_EQ(20, timestamp_ms);
+}
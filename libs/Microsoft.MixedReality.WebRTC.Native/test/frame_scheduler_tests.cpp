@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "frame_scheduler.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+namespace {
+
+/// Expected deadline of the frame of index |index| at a fixed |frame_rate|.
+int64_t ExpectedDeadline(int64_t origin_us, int64_t index, double frame_rate) {
+  return origin_us + std::llround(index * 1e6 / frame_rate);
+}
+
+}  // namespace
+
+TEST(FrameScheduler, Start) {
+  FrameScheduler scheduler;
+  ASSERT_EQ(FrameScheduler::kDefaultFrameRate, scheduler.frame_rate());
+  ASSERT_EQ(mrsFrameSchedulePolicy::kSkip, scheduler.policy());
+  scheduler.Start(1000);
+  ASSERT_EQ(1000, scheduler.next_deadline_us());
+  ASSERT_EQ(1000, scheduler.Advance(1000));
+  ASSERT_EQ(1000 + 33333, scheduler.next_deadline_us());
+  ASSERT_EQ(0u, scheduler.skipped_frame_count());
+}
+
+TEST(FrameScheduler, NoDrift) {
+  // 60 FPS for one hour, with the caller always a bit late. The deadlines
+  // never accumulate the lateness nor the rounding of the period.
+  constexpr int64_t kOrigin = 5000;
+  constexpr int64_t kFrameCount = 60 * 3600;
+  FrameScheduler scheduler;
+  scheduler.SetFrameRate(60.0);
+  scheduler.Start(kOrigin);
+  for (int64_t i = 0; i < kFrameCount; ++i) {
+    const int64_t deadline = scheduler.next_deadline_us();
+    ASSERT_EQ(ExpectedDeadline(kOrigin, i, 60.0), deadline);
+    ASSERT_EQ(deadline, scheduler.Advance(deadline + 1500 + (i % 7) * 100));
+  }
+  ASSERT_EQ(kOrigin + 3600ll * 1000000, scheduler.next_deadline_us());
+  ASSERT_EQ(0u, scheduler.skipped_frame_count());
+}
+
+TEST(FrameScheduler, Skip) {
+  FrameScheduler scheduler;
+  scheduler.SetFrameRate(100.0);
+  scheduler.Start(0);
+  // Late by 3.5 periods; the 3 missed deadlines are skipped.
+  ASSERT_EQ(0, scheduler.Advance(35000));
+  ASSERT_EQ(3u, scheduler.skipped_frame_count());
+  ASSERT_EQ(40000, scheduler.next_deadline_us());
+  ASSERT_EQ(40000, scheduler.Advance(40000));
+  ASSERT_EQ(50000, scheduler.next_deadline_us());
+  // Late exactly on the following deadline, which is skipped too.
+  ASSERT_EQ(50000, scheduler.Advance(60000));
+  ASSERT_EQ(4u, scheduler.skipped_frame_count());
+  ASSERT_EQ(70000, scheduler.next_deadline_us());
+}
+
+TEST(FrameScheduler, CatchUp) {
+  FrameScheduler scheduler;
+  scheduler.SetFrameRate(100.0);
+  scheduler.SetPolicy(mrsFrameSchedulePolicy::kCatchUp);
+  scheduler.Start(0);
+  // Late by 2.5 periods; the 2 missed deadlines are kept.
+  ASSERT_EQ(0, scheduler.Advance(25000));
+  ASSERT_EQ(10000, scheduler.Advance(25000));
+  ASSERT_EQ(20000, scheduler.Advance(25000));
+  ASSERT_EQ(30000, scheduler.next_deadline_us());
+  ASSERT_EQ(0u, scheduler.skipped_frame_count());
+  // Late by 10.5 periods; only the most recent missed deadlines are kept.
+  ASSERT_EQ(30000, scheduler.Advance(135000));
+  const auto kept = FrameScheduler::kMaxCatchUpFrameCount;
+  ASSERT_EQ(6u, scheduler.skipped_frame_count());
+  ASSERT_EQ(140000 - kept * 10000, scheduler.next_deadline_us());
+  for (int i = 0; i < kept; ++i) {
+    scheduler.Advance(135000);
+  }
+  ASSERT_EQ(140000, scheduler.next_deadline_us());
+  ASSERT_EQ(6u, scheduler.skipped_frame_count());
+}
+
+TEST(FrameScheduler, SetFrameRate) {
+  FrameScheduler scheduler;
+  scheduler.SetFrameRate(50.0);
+  scheduler.Start(0);
+  ASSERT_EQ(0, scheduler.Advance(0));
+  ASSERT_EQ(20000, scheduler.next_deadline_us());
+  // The next deadline is unchanged, the following ones use the new rate.
+  scheduler.SetFrameRate(25.0);
+  ASSERT_EQ(20000, scheduler.next_deadline_us());
+  ASSERT_EQ(20000, scheduler.Advance(20000));
+  ASSERT_EQ(60000, scheduler.next_deadline_us());
+}
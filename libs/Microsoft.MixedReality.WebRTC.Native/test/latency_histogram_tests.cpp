@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <thread>
+#include <vector>
+
+#include "latency_histogram.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+TEST(LatencyHistogram, Empty) {
+  LatencyHistogram histogram;
+  VideoLatencyHistogram snapshot;
+  histogram.GetSnapshot(snapshot);
+  ASSERT_EQ(0u, snapshot.count_);
+  ASSERT_EQ(0, snapshot.sum_us_);
+  ASSERT_EQ(0, snapshot.min_us_);
+  ASSERT_EQ(0, snapshot.max_us_);
+  for (int i = 0; i < kVideoLatencyBucketCount; ++i) {
+    ASSERT_EQ(0u, snapshot.buckets_[i]);
+  }
+}
+
+TEST(LatencyHistogram, BucketIndex) {
+  ASSERT_EQ(0, LatencyHistogram::BucketIndex(0));
+  ASSERT_EQ(0, LatencyHistogram::BucketIndex(63));
+  ASSERT_EQ(1, LatencyHistogram::BucketIndex(64));
+  ASSERT_EQ(1, LatencyHistogram::BucketIndex(127));
+  ASSERT_EQ(2, LatencyHistogram::BucketIndex(128));
+  ASSERT_EQ(14, LatencyHistogram::BucketIndex((1 << 20) - 1));
+  ASSERT_EQ(15, LatencyHistogram::BucketIndex(1 << 20));
+  ASSERT_EQ(15, LatencyHistogram::BucketIndex(int64_t{1} << 40));
+}
+
+TEST(LatencyHistogram, Record) {
+  LatencyHistogram histogram;
+  histogram.Record(10);
+  histogram.Record(100);
+  histogram.Record(5000);
+  histogram.Record(-3);  // clamped to zero
+  VideoLatencyHistogram snapshot;
+  histogram.GetSnapshot(snapshot);
+  ASSERT_EQ(4u, snapshot.count_);
+  ASSERT_EQ(5110, snapshot.sum_us_);
+  ASSERT_EQ(0, snapshot.min_us_);
+  ASSERT_EQ(5000, snapshot.max_us_);
+  ASSERT_EQ(2u, snapshot.buckets_[0]);
+  ASSERT_EQ(1u, snapshot.buckets_[1]);
+  ASSERT_EQ(1u, snapshot.buckets_[LatencyHistogram::BucketIndex(5000)]);
+
+  histogram.Reset();
+  histogram.GetSnapshot(snapshot);
+  ASSERT_EQ(0u, snapshot.count_);
+  ASSERT_EQ(0, snapshot.min_us_);
+}
+
+TEST(LatencyHistogram, ConcurrentRecord) {
+  constexpr int kThreadCount = 4;
+  constexpr int kSampleCount = 10000;
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadCount; ++t) {
+    threads.emplace_back([&histogram, t]() {
+      for (int i = 0; i < kSampleCount; ++i) {
+        histogram.Record(t * kSampleCount + i);
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  VideoLatencyHistogram snapshot;
+  histogram.GetSnapshot(snapshot);
+  ASSERT_EQ(static_cast<uint64_t>(kThreadCount * kSampleCount),
+            snapshot.count_);
+  ASSERT_EQ(0, snapshot.min_us_);
+  ASSERT_EQ(kThreadCount * kSampleCount - 1, snapshot.max_us_);
+  uint64_t bucket_total = 0;
+  for (int i = 0; i < kVideoLatencyBucketCount; ++i) {
+    bucket_total += snapshot.buckets_[i];
+  }
+  ASSERT_EQ(snapshot.count_, bucket_total);
+}
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+//< FIXME - Internal symbols not exported, need static linking
+#if 0
+
+#include <vector>
+
+#include "media/static_frame_detector.h"
+
+using namespace Microsoft::MixedReality::WebRTC;
+
+namespace {
+
+Argb32VideoFrame MakeArgb32Frame(std::vector<uint32_t>& pixels,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 uint32_t stride_pixels) {
+  pixels.resize(stride_pixels * height);
+  for (uint32_t j = 0; j < height; ++j) {
+    for (uint32_t i = 0; i < stride_pixels; ++i) {
+      // Padding pixels past the width change with the stride.
+      pixels[j * stride_pixels + i] =
+          (i < width) ? (0xFF000000u | (j << 8) | i) : stride_pixels;
+    }
+  }
+  Argb32VideoFrame frame_view{};
+  frame_view.width_ = width;
+  frame_view.height_ = height;
+  frame_view.argb32_data_ = pixels.data();
+  frame_view.stride_ = stride_pixels * 4;
+  return frame_view;
+}
+
+}  // namespace
+
+TEST(StaticFrameDetector, HashIgnoresPadding) {
+  std::vector<uint32_t> packed;
+  std::vector<uint32_t> padded;
+  const Argb32VideoFrame packed_view = MakeArgb32Frame(packed, 30, 20, 30);
+  const Argb32VideoFrame padded_view = MakeArgb32Frame(padded, 30, 20, 32);
+  const uint32_t seed = StaticFrameDetector::kHashSeed;
+  ASSERT_EQ(StaticFrameDetector::HashFrame(packed_view, seed),
+            StaticFrameDetector::HashFrame(padded_view, seed));
+}
+
+TEST(StaticFrameDetector, HashChangesWithPixels) {
+  std::vector<uint32_t> pixels;
+  const Argb32VideoFrame frame_view = MakeArgb32Frame(pixels, 30, 20, 32);
+  const uint32_t seed = StaticFrameDetector::kHashSeed;
+  const uint32_t hash = StaticFrameDetector::HashFrame(frame_view, seed);
+  pixels[19 * 32 + 29] ^= 1;
+  ASSERT_NE(hash, StaticFrameDetector::HashFrame(frame_view, seed));
+  pixels[19 * 32 + 29] ^= 1;
+  ASSERT_EQ(hash, StaticFrameDetector::HashFrame(frame_view, seed));
+
+  // Frames of the same bytes with another encoding have another hash
+  Rgba32VideoFrame rgba_view{};
+  rgba_view.width_ = frame_view.width_;
+  rgba_view.height_ = frame_view.height_;
+  rgba_view.rgba32_data_ = frame_view.argb32_data_;
+  rgba_view.stride_ = frame_view.stride_;
+  ASSERT_NE(hash, StaticFrameDetector::HashFrame(rgba_view, seed));
+}
+
+TEST(StaticFrameDetector, FindRepeat) {
+  StaticFrameDetector detector;
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+  ASSERT_FALSE(detector.FindRepeat(42, 0, buffer));
+
+  rtc::scoped_refptr<webrtc::I420Buffer> i420 =
+      webrtc::I420Buffer::Create(2, 2);
+  detector.Update(42, 0, i420);
+  ASSERT_TRUE(detector.FindRepeat(42, 500, buffer));
+  ASSERT_EQ(i420.get(), buffer.get());
+  ASSERT_FALSE(detector.FindRepeat(43, 500, buffer));
+
+  // Static frames are not detected anymore once the refresh interval elapsed
+  ASSERT_FALSE(detector.FindRepeat(
+      42, StaticFrameDetector::kRefreshIntervalMs, buffer));
+
+  // A frame without buffer is detected, but not repeated
+  detector.Update(42, 2000, nullptr);
+  buffer = nullptr;
+  ASSERT_TRUE(detector.FindRepeat(42, 2100, buffer));
+  ASSERT_EQ(nullptr, buffer.get());
+
+  detector.Reset();
+  ASSERT_FALSE(detector.FindRepeat(42, 2100, buffer));
+}
+
+#endif // #if 0
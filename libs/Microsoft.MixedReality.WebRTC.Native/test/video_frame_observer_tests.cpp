@@ -6,6 +6,14 @@
 //< FIXME - Internal symbols not exported, need static linking
 #if 0
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "benchmark_test_helpers.h"
 #include "video_frame_observer.h"
 
 using namespace Microsoft::MixedReality::WebRTC;
@@ -15,11 +23,20 @@ namespace {
 class MockVideoFrameObserver : public VideoFrameObserver {
  public:
   // Expose publicly for testing.
-  ArgbBuffer* mock_GetArgbScratchBuffer(int width, int height) {
-    return GetArgbScratchBuffer(width, height);
+  rtc::scoped_refptr<ArgbBuffer> mock_AcquireArgbBuffer(int width,
+                                                        int height) {
+    return AcquireArgbBuffer(width, height);
   }
+  using VideoFrameObserver::OnFrame;
 };
 
+webrtc::VideoFrame MakeBlackFrame(int width, int height) {
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer =
+      webrtc::I420Buffer::Create(width, height);
+  webrtc::I420Buffer::SetBlack(buffer);
+  return webrtc::VideoFrame(buffer, webrtc::kVideoRotation_0, 0);
+}
+
 }  // namespace
 
 //< FIXME - Internal symbols not exported, need static linking
@@ -40,31 +57,429 @@ class MockVideoFrameObserver : public VideoFrameObserver {
 //  ASSERT_EQ(15 * 16 * 4, buffer->Size());
 //}
 
-TEST(VideoFrameObserver, GetArgbScratchBuffer) {
+TEST(VideoFrameObserver, AcquireArgbBuffer) {
   MockVideoFrameObserver observer;
-  ArgbBuffer* const buffer = observer.mock_GetArgbScratchBuffer(16, 16);
+  rtc::scoped_refptr<ArgbBuffer> buffer =
+      observer.mock_AcquireArgbBuffer(16, 16);
   ASSERT_NE(nullptr, buffer);
   ASSERT_NE(nullptr, buffer->Data());
   ASSERT_EQ(16 * 4, buffer->Stride());
   ASSERT_EQ(16 * 16 * 4, buffer->Size());
 }
 
-TEST(VideoFrameObserver, ReuseArgbScratchBuffer) {
+TEST(VideoFrameObserver, ReuseArgbBuffer) {
+  MockVideoFrameObserver observer;
+  ArgbBuffer* const buffer0 = observer.mock_AcquireArgbBuffer(16, 16).get();
+  // Released, same dimensions -> reused
+  rtc::scoped_refptr<ArgbBuffer> buffer1 =
+      observer.mock_AcquireArgbBuffer(16, 16);
+  ASSERT_EQ(buffer0, buffer1.get());
+  // In use -> not reused
+  rtc::scoped_refptr<ArgbBuffer> buffer2 =
+      observer.mock_AcquireArgbBuffer(16, 16);
+  ASSERT_NE(buffer1.get(), buffer2.get());
+  buffer1 = nullptr;
+  buffer2 = nullptr;
+  // Different dimensions -> new buffer
+  rtc::scoped_refptr<ArgbBuffer> buffer3 =
+      observer.mock_AcquireArgbBuffer(16, 17);
+  ASSERT_EQ(16, buffer3->width());
+  ASSERT_EQ(17, buffer3->height());
+}
+
+TEST(VideoFrameObserver, RetainedArgbBufferNotReused) {
+  MockVideoFrameObserver observer;
+  std::vector<rtc::scoped_refptr<ArgbBuffer>> retained;
+  for (size_t i = 0; i < ArgbBufferPool::kDefaultMaxNumberOfBuffers; ++i) {
+    rtc::scoped_refptr<ArgbBuffer> buffer =
+        observer.mock_AcquireArgbBuffer(16, 16);
+    ASSERT_NE(nullptr, buffer);
+    for (auto&& other : retained) {
+      ASSERT_NE(other.get(), buffer.get());
+    }
+    retained.push_back(buffer);
+  }
+  // Pool exhausted while all buffers are retained -> unpooled buffer, so the
+  // frame is not dropped
+  rtc::scoped_refptr<ArgbBuffer> unpooled =
+      observer.mock_AcquireArgbBuffer(16, 16);
+  ASSERT_NE(nullptr, unpooled);
+  for (auto&& other : retained) {
+    ASSERT_NE(other.get(), unpooled.get());
+  }
+  // Releasing from another thread makes the buffer available again
+  ArgbBuffer* const released = retained.back().get();
+  std::thread([&retained]() { retained.pop_back(); }).join();
+  ASSERT_EQ(released, observer.mock_AcquireArgbBuffer(16, 16).get());
+}
+
+TEST(VideoFrameObserver, Argb32Destinations) {
+  constexpr int kWidth = 16;
+  constexpr int kHeight = 8;
+  constexpr int kStride = 128;  // padded, larger than kWidth * 4
+  std::vector<uint8_t> storage0(kStride * kHeight);
+  std::vector<uint8_t> storage1(kStride * kHeight);
+  void* const buffers[] = {storage0.data(), storage1.data()};
+  std::vector<Argb32VideoFrame> frames;
   MockVideoFrameObserver observer;
-  ArgbBuffer* const buffer0 = observer.mock_GetArgbScratchBuffer(16, 16);
-  ArgbBuffer* const buffer1 = observer.mock_GetArgbScratchBuffer(15, 16);
-  ASSERT_EQ(buffer0, buffer1);
-  ArgbBuffer* const buffer2 = observer.mock_GetArgbScratchBuffer(16, 15);
-  ASSERT_EQ(buffer0, buffer2);
-  ArgbBuffer* const buffer3 = observer.mock_GetArgbScratchBuffer(16, 16);
-  ASSERT_EQ(buffer0, buffer3);
-  ArgbBuffer* const buffer4 = observer.mock_GetArgbScratchBuffer(17, 16);
-  ASSERT_NE(buffer0, buffer4);
-  ArgbBuffer* const buffer5 = observer.mock_GetArgbScratchBuffer(16, 17);
-  ASSERT_NE(buffer0, buffer5);
-  ASSERT_EQ(buffer4, buffer5);
-  ArgbBuffer* const buffer6 = observer.mock_GetArgbScratchBuffer(16, 18);
-  ASSERT_NE(buffer4, buffer6);
+  observer.SetCallback(Argb32FrameReadyCallback{
+      [](void* user_data, const Argb32VideoFrame& frame) {
+        static_cast<std::vector<Argb32VideoFrame>*>(user_data)->push_back(
+            frame);
+      },
+      &frames});
+  ASSERT_EQ(Result::kSuccess,
+            observer.SetArgb32Destinations(buffers, 2, storage0.size(),
+                                           kStride));
+  const webrtc::VideoFrame frame = MakeBlackFrame(kWidth, kHeight);
+
+  // Both buffers are used in turn with the application stride
+  observer.OnFrame(frame);
+  observer.OnFrame(frame);
+  ASSERT_EQ(2u, frames.size());
+  ASSERT_EQ(buffers[0], frames[0].argb32_data_);
+  ASSERT_EQ(buffers[1], frames[1].argb32_data_);
+  ASSERT_EQ(kStride, frames[1].stride_);
+  ASSERT_EQ(nullptr, frames[1].buffer_handle_);
+
+  // All buffers reserved -> frame dropped
+  observer.OnFrame(frame);
+  ASSERT_EQ(2u, frames.size());
+
+  // Releasing a buffer makes it available again
+  ASSERT_EQ(Result::kSuccess, observer.ReleaseArgb32Destination(buffers[0]));
+  ASSERT_EQ(Result::kInvalidOperation,
+            observer.ReleaseArgb32Destination(buffers[0]));
+  ASSERT_EQ(Result::kNotFound,
+            observer.ReleaseArgb32Destination(storage0.data() + 1));
+  observer.OnFrame(frame);
+  ASSERT_EQ(3u, frames.size());
+  ASSERT_EQ(buffers[0], frames[2].argb32_data_);
+
+  // Frame too large for the buffers -> dropped
+  observer.ReleaseArgb32Destination(buffers[0]);
+  observer.OnFrame(MakeBlackFrame(kWidth, kHeight * 2));
+  ASSERT_EQ(3u, frames.size());
+
+  // Unregistering reverts to internal buffers
+  ASSERT_EQ(Result::kSuccess,
+            observer.SetArgb32Destinations(nullptr, 0, 0, 0));
+  observer.OnFrame(frame);
+  ASSERT_EQ(4u, frames.size());
+  ASSERT_NE(nullptr, frames[3].buffer_handle_);
+}
+
+TEST(VideoFrameObserver, FitFrameSize) {
+  // No target or smaller frame -> unchanged
+  VideoFrameSize size = FitFrameSize(1280, 720, VideoFrameSize{});
+  ASSERT_EQ(1280, size.width_);
+  ASSERT_EQ(720, size.height_);
+  size = FitFrameSize(320, 180, VideoFrameSize{640, 480});
+  ASSERT_EQ(320, size.width_);
+  ASSERT_EQ(180, size.height_);
+  // Width-limited, aspect ratio preserved
+  size = FitFrameSize(1920, 1080, VideoFrameSize{320, 320});
+  ASSERT_EQ(320, size.width_);
+  ASSERT_EQ(180, size.height_);
+  // Height-limited, rounded down to even dimensions
+  size = FitFrameSize(1920, 1080, VideoFrameSize{1000, 101});
+  ASSERT_EQ(178, size.width_);
+  ASSERT_EQ(100, size.height_);
+}
+
+TEST(VideoFrameObserver, ScaledCallbacks) {
+  std::vector<Argb32VideoFrame> argb_frames;
+  std::vector<I420AVideoFrame> i420_frames;
+  MockVideoFrameObserver observer;
+  observer.SetCallback(Argb32FrameReadyCallback{
+      [](void* user_data, const Argb32VideoFrame& frame) {
+        static_cast<std::vector<Argb32VideoFrame>*>(user_data)->push_back(
+            frame);
+      },
+      &argb_frames});
+  observer.SetCallback(I420AFrameReadyCallback{
+      [](void* user_data, const I420AVideoFrame& frame) {
+        static_cast<std::vector<I420AVideoFrame>*>(user_data)->push_back(
+            frame);
+      },
+      &i420_frames});
+
+  // One callback at full resolution -> no pixel count limit
+  ASSERT_EQ(Result::kSuccess, observer.SetCallbackTargetSize(
+                                  VideoFrameFormat::kArgb32, 160, 120));
+  ASSERT_EQ(std::numeric_limits<int>::max(),
+            observer.GetSinkWants().max_pixel_count);
+  observer.OnFrame(MakeBlackFrame(640, 480));
+  ASSERT_EQ(160u, argb_frames.back().width_);
+  ASSERT_EQ(120u, argb_frames.back().height_);
+  ASSERT_EQ(160 * 4, argb_frames.back().stride_);
+  ASSERT_EQ(640u, i420_frames.back().width_);
+
+  // All callbacks with a target size -> largest one requested
+  ASSERT_EQ(Result::kSuccess, observer.SetCallbackTargetSize(
+                                  VideoFrameFormat::kI420A, 320, 240));
+  ASSERT_EQ(320 * 240, observer.GetSinkWants().max_pixel_count);
+  observer.OnFrame(MakeBlackFrame(640, 480));
+  ASSERT_EQ(320u, i420_frames.back().width_);
+  ASSERT_EQ(nullptr, i420_frames.back().adata_);
+
+  ASSERT_EQ(Result::kInvalidParameter,
+            observer.SetCallbackTargetSize(VideoFrameFormat::kNv12, -1, 0));
+}
+
+TEST(VideoFrameObserver, FrameTiming) {
+  std::vector<Argb32VideoFrame> argb_frames;
+  MockVideoFrameObserver observer;
+  observer.SetCallback(Argb32FrameReadyCallback{
+      [](void* user_data, const Argb32VideoFrame& frame) {
+        static_cast<std::vector<Argb32VideoFrame>*>(user_data)->push_back(
+            frame);
+      },
+      &argb_frames});
+
+  webrtc::VideoFrame frame = MakeBlackFrame(64, 48);
+  frame.set_timestamp(90000);
+  frame.set_ntp_time_ms(123456);
+  frame.set_timestamp_us(rtc::TimeMicros());
+  const int64_t before_us = rtc::TimeMicros();
+  observer.OnFrame(frame);
+  observer.OnFrame(frame);
+  ASSERT_EQ(2u, argb_frames.size());
+  const VideoFrameTiming& timing = argb_frames[0].timing_;
+  ASSERT_EQ(1, timing.frame_id_);
+  ASSERT_EQ(2, argb_frames[1].timing_.frame_id_);
+  ASSERT_EQ(90000u, timing.rtp_timestamp_);
+  ASSERT_EQ(123456, timing.ntp_time_ms_);
+  ASSERT_EQ(frame.timestamp_us(), timing.timestamp_us_);
+  ASSERT_LE(before_us, timing.received_time_us_);
+
+  // One sample per callback invocation
+  VideoFrameLatencyStats stats;
+  observer.GetLatencyStats(stats);
+  ASSERT_EQ(2u, stats.delivery_.count_);
+  ASSERT_EQ(2u, stats.callback_.count_);
+  ASSERT_LE(stats.delivery_.min_us_, stats.delivery_.max_us_);
+  observer.ResetLatencyStats();
+  observer.GetLatencyStats(stats);
+  ASSERT_EQ(0u, stats.delivery_.count_);
+  ASSERT_EQ(0, stats.delivery_.min_us_);
+}
+
+namespace {
+
+constexpr int kContentionFrameCount = 20000;
+
+/// Previous dispatch of VideoFrameObserver, for comparison: a mutex shared by
+/// SetCallback() and OnFrame(), held for the entire frame delivery.
+struct MutexDispatchObserver {
+  std::mutex mutex_;
+  MockVideoFrameObserver observer_;
+
+  void SetCallback(I420AFrameReadyCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observer_.SetCallback(callback);
+  }
+
+  void OnFrame(const webrtc::VideoFrame& frame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observer_.OnFrame(frame);
+  }
+};
+
+/// Dispatch of VideoFrameObserver with the atomic callback snapshot.
+struct SnapshotDispatchObserver {
+  MockVideoFrameObserver observer_;
+
+  void SetCallback(I420AFrameReadyCallback callback) {
+    observer_.SetCallback(callback);
+  }
+
+  void OnFrame(const webrtc::VideoFrame& frame) { observer_.OnFrame(frame); }
+};
+
+/// Measure the time the decoder thread stalls between entering OnFrame() and
+/// entering the frame callback, while another thread continuously
+/// re-registers the callback.
+template <typename Observer>
+DurationStats MeasureDispatchUnderContention(Observer& observer,
+                                             int& registration_count_out) {
+  const webrtc::VideoFrame frame = MakeBlackFrame(640, 480);
+
+  struct CallbackState {
+    Clock::time_point entered;
+    int call_count{0};
+  } state;
+  I420AFrameReadyCallback callback{
+      [](void* user_data, const I420AVideoFrame& /*frame*/) {
+        auto* const s = static_cast<CallbackState*>(user_data);
+        s->entered = Clock::now();
+        ++s->call_count;
+      },
+      &state};
+  observer.SetCallback(callback);
+
+  // Continuously replace the callback with an identical one.
+  std::atomic_bool stop{false};
+  std::atomic<int> registration_count{0};
+  std::thread writer([&]() {
+    while (!stop.load(std::memory_order_relaxed)) {
+      observer.SetCallback(callback);
+      registration_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  std::vector<Clock::duration> stalls;
+  stalls.reserve(kContentionFrameCount);
+  for (int i = 0; i < kContentionFrameCount; ++i) {
+    const Clock::time_point start = Clock::now();
+    observer.OnFrame(frame);
+    stalls.push_back(state.entered - start);
+  }
+  stop = true;
+  writer.join();
+  observer.SetCallback(I420AFrameReadyCallback{});
+
+  EXPECT_EQ(kContentionFrameCount, state.call_count);
+  registration_count_out = registration_count.load();
+  return ComputeStats(stalls);
+}
+
+}  // namespace
+
+// Benchmark the dispatch stall of OnFrame() under concurrent registrations.
+// With the previous mutex-based dispatch the decoder thread was serialized
+// with SetCallback(); it now only reads an atomic snapshot.
+TEST(VideoFrameObserver, CallbackContentionBenchmark) {
+  MutexDispatchObserver mutex_observer;
+  int mutex_registrations = 0;
+  const DurationStats mutex_stats =
+      MeasureDispatchUnderContention(mutex_observer, mutex_registrations);
+  SnapshotDispatchObserver snapshot_observer;
+  int snapshot_registrations = 0;
+  const DurationStats snapshot_stats =
+      MeasureDispatchUnderContention(snapshot_observer, snapshot_registrations);
+  printf(
+      "OnFrame() dispatch stall over %d frames with concurrent "
+      "registrations: mutex (%d registrations) mean=%.2fus p99=%.2fus "
+      "max=%.2fus; snapshot (%d registrations) mean=%.2fus p99=%.2fus "
+      "max=%.2fus\n",
+      kContentionFrameCount, mutex_registrations, mutex_stats.mean_us,
+      mutex_stats.p99_us, mutex_stats.max_us, snapshot_registrations,
+      snapshot_stats.mean_us, snapshot_stats.p99_us, snapshot_stats.max_us);
+}
+
+namespace {
+
+/// Create an I420 frame view with random content in the given buffer.
+I420AVideoFrame MakeRandomI420Frame(int width,
+                                    int height,
+                                    std::vector<uint8_t>& storage) {
+  const int chroma_width = (width + 1) / 2;
+  const int chroma_height = (height + 1) / 2;
+  const size_t ysize = static_cast<size_t>(width) * height;
+  const size_t csize = static_cast<size_t>(chroma_width) * chroma_height;
+  storage.resize(ysize + 2 * csize);
+  for (auto&& v : storage) {
+    v = static_cast<uint8_t>(rand() & 0xFF);
+  }
+  I420AVideoFrame frame{};
+  frame.width_ = width;
+  frame.height_ = height;
+  frame.ydata_ = storage.data();
+  frame.udata_ = storage.data() + ysize;
+  frame.vdata_ = storage.data() + ysize + csize;
+  frame.adata_ = nullptr;
+  frame.ystride_ = width;
+  frame.ustride_ = chroma_width;
+  frame.vstride_ = chroma_width;
+  frame.astride_ = 0;
+  return frame;
+}
+
+}  // namespace
+
+// Check that the striped conversion produces exactly the same output as the
+// single-threaded one, including for odd heights and alpha planes.
+TEST(VideoFrameObserver, ParallelConversionBitIdentical) {
+  const std::pair<int, int> kSizes[] = {{640, 481}, {1920, 1080}, {1279, 719}};
+  for (auto&& [width, height] : kSizes) {
+    std::vector<uint8_t> storage;
+    I420AVideoFrame frame = MakeRandomI420Frame(width, height, storage);
+    std::vector<uint8_t> alpha(static_cast<size_t>(width) * height, 0x7F);
+    for (bool with_alpha : {false, true}) {
+      frame.adata_ = (with_alpha ? alpha.data() : nullptr);
+      frame.astride_ = (with_alpha ? width : 0);
+      const int stride = width * 4;
+      std::vector<uint8_t> ref(static_cast<size_t>(stride) * height);
+      ConvertI420AToArgb32(frame, ref.data(), stride, 1);
+      for (int threads : {2, 3, 4, 8}) {
+        std::vector<uint8_t> out(ref.size(), 0);
+        ConvertI420AToArgb32(frame, out.data(), stride, threads);
+        ASSERT_EQ(0, memcmp(ref.data(), out.data(), ref.size()))
+            << width << "x" << height << " alpha=" << with_alpha
+            << " threads=" << threads;
+      }
+    }
+  }
+}
+
+// Check that the NV12, RGBA32, and BGR24 outputs split across threads match
+// the single-threaded conversion.
+TEST(VideoFrameObserver, ParallelConversionOtherFormatsBitIdentical) {
+  const std::pair<int, int> kSizes[] = {{640, 481}, {1920, 1080}};
+  for (auto&& [width, height] : kSizes) {
+    std::vector<uint8_t> storage;
+    const I420AVideoFrame frame = MakeRandomI420Frame(width, height, storage);
+    const int chroma_height = (height + 1) / 2;
+    const size_t nv12_size = static_cast<size_t>(width) * height +
+                             static_cast<size_t>(width) * chroma_height;
+    std::vector<uint8_t> ref_nv12(nv12_size);
+    std::vector<uint8_t> ref_rgba(static_cast<size_t>(width) * 4 * height);
+    std::vector<uint8_t> ref_bgr(static_cast<size_t>(width) * 3 * height);
+    uint8_t* const ref_uv = ref_nv12.data() + width * height;
+    ConvertI420AToNv12(frame, ref_nv12.data(), width, ref_uv, width, 1);
+    ConvertI420AToRgba32(frame, ref_rgba.data(), width * 4, 1);
+    ConvertI420AToBgr24(frame, ref_bgr.data(), width * 3, 1);
+    for (int threads : {2, 4}) {
+      std::vector<uint8_t> nv12(ref_nv12.size(), 0);
+      std::vector<uint8_t> rgba(ref_rgba.size(), 0);
+      std::vector<uint8_t> bgr(ref_bgr.size(), 0);
+      uint8_t* const uv = nv12.data() + width * height;
+      ConvertI420AToNv12(frame, nv12.data(), width, uv, width, threads);
+      ConvertI420AToRgba32(frame, rgba.data(), width * 4, threads);
+      ConvertI420AToBgr24(frame, bgr.data(), width * 3, threads);
+      ASSERT_EQ(ref_nv12, nv12) << width << "x" << height << " NV12";
+      ASSERT_EQ(ref_rgba, rgba) << width << "x" << height << " RGBA32";
+      ASSERT_EQ(ref_bgr, bgr) << width << "x" << height << " BGR24";
+    }
+  }
+}
+
+// Benchmark the I420 to ARGB32 conversion of 1080p and 4K frames with 1, 2, 4,
+// and 8 threads.
+TEST(VideoFrameObserver, ParallelConversionBenchmark) {
+  constexpr int kIterationCount = 50;
+  const std::pair<int, int> kSizes[] = {{1920, 1080}, {3840, 2160}};
+  for (auto&& [width, height] : kSizes) {
+    std::vector<uint8_t> storage;
+    const I420AVideoFrame frame = MakeRandomI420Frame(width, height, storage);
+    const int stride = width * 4;
+    std::vector<uint8_t> out(static_cast<size_t>(stride) * height);
+    for (int threads : {1, 2, 4, 8}) {
+      // Warm-up, including lazy creation of the worker pool
+      ConvertI420AToArgb32(frame, out.data(), stride, threads);
+      std::vector<Clock::duration> durations;
+      durations.reserve(kIterationCount);
+      for (int i = 0; i < kIterationCount; ++i) {
+        const Clock::time_point start = Clock::now();
+        ConvertI420AToArgb32(frame, out.data(), stride, threads);
+        durations.push_back(Clock::now() - start);
+      }
+      const DurationStats stats = ComputeStats(durations);
+      printf("I420->ARGB32 %dx%d with %d thread(s): mean=%.0fus p99=%.0fus\n",
+             width, height, threads, stats.mean_us, stats.p99_us);
+    }
+  }
 }
 
 #endif // #if 0
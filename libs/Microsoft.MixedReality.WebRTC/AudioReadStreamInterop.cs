@@ -9,6 +9,11 @@ namespace Microsoft.MixedReality.WebRTC.Interop
             EntryPoint = "mrsAudioReadStreamCreate")]
         public static extern uint Create(PeerConnectionHandle peerHandle, int bufferMs, ref IntPtr audioReadStream);
 
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsAudioReadStreamCreateWithResampleMode")]
+        public static extern uint CreateWithResampleMode(PeerConnectionHandle peerHandle, int bufferMs,
+            AudioResampleMode resampleMode, ref IntPtr audioReadStream);
+
         [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
             EntryPoint = "mrsAudioReadStreamRead")]
         public static extern uint Read(IntPtr audioReadStream, int sampleRate, float[] data, int dataLen, int numChannels);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Runtime.InteropServices;
 using Microsoft.MixedReality.WebRTC.Interop;
@@ -25,15 +26,14 @@ namespace Microsoft.MixedReality.WebRTC
         public uint RequestId;
 
         /// <summary>
-        /// Frame timestamp, in milliseconds. This corresponds to the time when the request
-        /// was made to the native video track source.
+        /// Frame timestamp, in milliseconds. This corresponds to the scheduled time of the
+        /// request, so consecutive timestamps are evenly spaced at the source frame rate.
         /// </summary>
         public long TimestampMs;
 
         /// <summary>
         /// Complete the current request by providing a video frame for it.
-        /// This must be used if the video track source was created with
-        /// <see cref="ExternalVideoTrackSource.CreateFromI420ACallback(I420AVideoFrameRequestDelegate)"/>.
+        /// This can be used with any source, whatever its frame encoding.
         /// </summary>
         /// <param name="frame">The video frame used to complete the request.</param>
         public void CompleteRequest(in I420AVideoFrame frame)
@@ -43,14 +43,65 @@ namespace Microsoft.MixedReality.WebRTC
 
         /// <summary>
         /// Complete the current request by providing a video frame for it.
-        /// This must be used if the video track source was created with
-        /// <see cref="ExternalVideoTrackSource.CreateFromArgb32Callback(Argb32VideoFrameRequestDelegate)"/>.
+        /// This can be used with any source, whatever its frame encoding.
         /// </summary>
         /// <param name="frame">The video frame used to complete the request.</param>
         public void CompleteRequest(in Argb32VideoFrame frame)
         {
             Source.CompleteFrameRequest(RequestId, TimestampMs, frame);
         }
+
+        /// <summary>
+        /// Complete the current request by providing a video frame for it, of which only the given
+        /// dirty regions changed since the previous frame provided with dirty regions. See
+        /// <see cref="ExternalVideoTrackSource.CompleteFrameRequest(uint, long, in Argb32VideoFrame, VideoRect[])"/>.
+        /// </summary>
+        /// <param name="frame">The entire video frame used to complete the request.</param>
+        /// <param name="dirtyRects">The regions of the frame which changed.</param>
+        public void CompleteRequest(in Argb32VideoFrame frame, VideoRect[] dirtyRects)
+        {
+            Source.CompleteFrameRequest(RequestId, TimestampMs, frame, dirtyRects);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a NV12 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteRequest(in Nv12VideoFrame frame)
+        {
+            Source.CompleteFrameRequest(RequestId, TimestampMs, frame);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a YUY2 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteRequest(in Yuy2VideoFrame frame)
+        {
+            Source.CompleteFrameRequest(RequestId, TimestampMs, frame);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a BGR24 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteRequest(in Bgr24VideoFrame frame)
+        {
+            Source.CompleteFrameRequest(RequestId, TimestampMs, frame);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a RGBA32 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteRequest(in Rgba32VideoFrame frame)
+        {
+            Source.CompleteFrameRequest(RequestId, TimestampMs, frame);
+        }
     }
 
     /// <summary>
@@ -67,6 +118,124 @@ namespace Microsoft.MixedReality.WebRTC
     /// <param name="request">The request to fulfill with a new ARGB32 video frame.</param>
     public delegate void Argb32VideoFrameRequestDelegate(in FrameRequest request);
 
+    /// <summary>
+    /// Policy of an external video track source for the frame requests whose deadline
+    /// passed while the source was late, for example because the capture thread was
+    /// not scheduled in time.
+    /// </summary>
+    public enum FrameSchedulePolicy : int
+    {
+        /// <summary>
+        /// Skip the missed frame requests, and resume with the next deadline in the future.
+        /// This keeps the latency low at the expense of the frame rate.
+        /// </summary>
+        Skip = 0,
+
+        /// <summary>
+        /// Issue the missed frame requests back-to-back to catch up with the schedule,
+        /// up to a few frames, so that the average frame rate is preserved.
+        /// </summary>
+        CatchUp = 1
+    }
+
+    /// <summary>
+    /// Policy of a push-mode external video track source for the frames pushed while the
+    /// source is still delivering a previous frame pushed from another thread.
+    /// </summary>
+    public enum PushFrameDropPolicy : int
+    {
+        /// <summary>
+        /// Drop the newly pushed frame and return immediately. This never blocks the producer,
+        /// at the expense of the frame rate.
+        /// </summary>
+        Drop = 0,
+
+        /// <summary>
+        /// Block the producer until the previous frame is delivered, then deliver the new frame.
+        /// This applies back-pressure to the producer.
+        /// </summary>
+        Wait = 1
+    }
+
+    /// <summary>
+    /// Policy of an external video track source for static frames, whose pixels are identical to
+    /// the ones of the previous frame, for example the frames of an idle screen being shared.
+    /// Static frames are detected with a hash of the frame, which is much cheaper than converting
+    /// and encoding it. A frame is always converted at least once per second, even if static.
+    /// </summary>
+    public enum StaticFramePolicy : int
+    {
+        /// <summary>
+        /// Convert and send all frames. This avoids the cost of hashing the frames for sources
+        /// which are rarely static, like camera captures.
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        /// Send static frames by repeating the previous frame, without converting them again.
+        /// Frames provided without copy are never repeated, to not delay the release of their memory.
+        /// </summary>
+        Repeat = 1,
+
+        /// <summary>
+        /// Drop static frames, so that the encoder does not encode them either.
+        /// </summary>
+        Drop = 2
+    }
+
+    /// <summary>
+    /// Video format currently wanted by the video tracks of an external video track source,
+    /// which is reduced when their encoders adapt to the CPU load or the available bandwidth.
+    /// Frames larger or more frequent than wanted are scaled down or dropped by the source, so
+    /// producing them in the wanted format to begin with avoids rendering pixels never sent.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct WantedVideoFormat
+    {
+        /// <summary>
+        /// Wanted frame width, in pixels.
+        /// </summary>
+        public int width;
+
+        /// <summary>
+        /// Wanted frame height, in pixels.
+        /// </summary>
+        public int height;
+
+        /// <summary>
+        /// Maximum wanted frame rate, in frames per second, or <see cref="int.MaxValue"/>
+        /// if the frame rate is not limited.
+        /// </summary>
+        public int maxFramerate;
+    }
+
+    /// <summary>
+    /// Rectangular region of a video frame, in pixels from the top left corner.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VideoRect
+    {
+        /// <summary>
+        /// Horizontal coordinate of the left edge of the region.
+        /// </summary>
+        public int x;
+
+        /// <summary>
+        /// Vertical coordinate of the top edge of the region.
+        /// </summary>
+        public int y;
+
+        /// <summary>
+        /// Width of the region.
+        /// </summary>
+        public int width;
+
+        /// <summary>
+        /// Height of the region.
+        /// </summary>
+        public int height;
+    }
+
     /// <summary>
     /// Video source for WebRTC video tracks based on a custom source
     /// of video frames managed by the user and external to the WebRTC
@@ -82,10 +251,37 @@ namespace Microsoft.MixedReality.WebRTC
     public class ExternalVideoTrackSource : IDisposable
     {
         /// <summary>
-        /// Once the external video track source is attached to some video track(s), this returns the peer connection
-        /// the video track(s) are part of. Otherwise this returns <c>null</c>.
+        /// Once the external video track source is attached to some video track(s), this returns the first peer
+        /// connection the video track(s) are part of. Otherwise this returns <c>null</c>.
         /// </summary>
-        public PeerConnection PeerConnection { get; private set; } = null;
+        /// <remarks>
+        /// A source can feed tracks on several peer connections; use <see cref="PeerConnections"/> to get all of them.
+        /// </remarks>
+        public PeerConnection PeerConnection
+        {
+            get
+            {
+                lock (_peerConnections)
+                {
+                    return (_peerConnections.Count > 0 ? _peerConnections[0] : null);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Snapshot of the peer connections the video track(s) attached to this source are part of. Each frame
+        /// produced by the source is converted once, and the same frame is sent to all of them.
+        /// </summary>
+        public IReadOnlyList<PeerConnection> PeerConnections
+        {
+            get
+            {
+                lock (_peerConnections)
+                {
+                    return _peerConnections.ToArray();
+                }
+            }
+        }
 
         /// <summary>
         /// Handle to the native ExternalVideoTrackSource object.
@@ -95,6 +291,11 @@ namespace Microsoft.MixedReality.WebRTC
         /// </remarks>
         internal ExternalVideoTrackSourceHandle _nativeHandle { get; private set; } = new ExternalVideoTrackSourceHandle();
 
+        /// <summary>
+        /// Peer connections with at least one video track attached to this source.
+        /// </summary>
+        private readonly List<PeerConnection> _peerConnections = new List<PeerConnection>();
+
         /// <summary>
         /// GC handle to frame request callback args keeping the delegate alive
         /// while the callback is registered with the native implementation.
@@ -121,6 +322,18 @@ namespace Microsoft.MixedReality.WebRTC
             return ExternalVideoTrackSourceInterop.CreateExternalVideoTrackSourceFromArgb32Callback(frameCallback);
         }
 
+        /// <summary>
+        /// Create a new external video track source delivering the frames pushed with
+        /// <see cref="PushFrame(long, in I420AVideoFrame)"/> or <see cref="PushFrame(long, in Argb32VideoFrame)"/>,
+        /// instead of requesting them from a callback. This allows a producer with its own clock to deliver
+        /// its frames as soon as they are available, without any request round trip.
+        /// </summary>
+        /// <returns>The newly created track source.</returns>
+        public static ExternalVideoTrackSource CreateForPush()
+        {
+            return ExternalVideoTrackSourceInterop.CreateExternalVideoTrackSourceForPush();
+        }
+
         internal ExternalVideoTrackSource(IntPtr frameRequestCallbackArgsHandle)
         {
             _frameRequestCallbackArgsHandle = frameRequestCallbackArgsHandle;
@@ -128,8 +341,7 @@ namespace Microsoft.MixedReality.WebRTC
 
         /// <summary>
         /// Complete the current request by providing a video frame for it.
-        /// This must be used if the video track source was created with
-        /// <see cref="CreateFromI420ACallback(I420AVideoFrameRequestDelegate)"/>.
+        /// This can be used with any source, whatever its frame encoding.
         /// </summary>
         /// <param name="requestId">The original request ID.</param>
         /// <param name="timestampMs">The video frame timestamp.</param>
@@ -141,8 +353,7 @@ namespace Microsoft.MixedReality.WebRTC
 
         /// <summary>
         /// Complete the current request by providing a video frame for it.
-        /// This must be used if the video track source was created with
-        /// <see cref="CreateFromArgb32Callback(Argb32VideoFrameRequestDelegate)"/>.
+        /// This can be used with any source, whatever its frame encoding.
         /// </summary>
         /// <param name="requestId">The original request ID.</param>
         /// <param name="timestampMs">The video frame timestamp.</param>
@@ -152,6 +363,290 @@ namespace Microsoft.MixedReality.WebRTC
             ExternalVideoTrackSourceInterop.CompleteFrameRequest(_nativeHandle, requestId, timestampMs, frame);
         }
 
+        /// <summary>
+        /// Complete the current request by providing a video frame for it, of which only the given
+        /// dirty regions changed since the previous frame provided with dirty regions. Only those
+        /// regions are converted into a persistent I420 frame, so that the cost of mostly static
+        /// frames, like user interfaces, scales with the changed area instead of the frame size.
+        /// The frame must still describe the entire frame, which is converted as a whole for the
+        /// first frame or if its size changed. This can be used with any source, whatever its
+        /// frame encoding.
+        /// </summary>
+        /// <param name="requestId">The original request ID.</param>
+        /// <param name="timestampMs">The video frame timestamp.</param>
+        /// <param name="frame">The entire video frame used to complete the request.</param>
+        /// <param name="dirtyRects">The regions of the frame which changed, clipped to the frame.</param>
+        public void CompleteFrameRequest(uint requestId, long timestampMs, in Argb32VideoFrame frame,
+            VideoRect[] dirtyRects)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_CompleteFrameRequestDirty(_nativeHandle,
+                requestId, timestampMs, frame, dirtyRects, dirtyRects?.Length ?? 0);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a NV12 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="requestId">The original request ID.</param>
+        /// <param name="timestampMs">The video frame timestamp.</param>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteFrameRequest(uint requestId, long timestampMs, in Nv12VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_CompleteFrameRequest(_nativeHandle,
+                requestId, timestampMs, frame);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a YUY2 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="requestId">The original request ID.</param>
+        /// <param name="timestampMs">The video frame timestamp.</param>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteFrameRequest(uint requestId, long timestampMs, in Yuy2VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_CompleteFrameRequest(_nativeHandle,
+                requestId, timestampMs, frame);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a BGR24 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="requestId">The original request ID.</param>
+        /// <param name="timestampMs">The video frame timestamp.</param>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteFrameRequest(uint requestId, long timestampMs, in Bgr24VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_CompleteFrameRequest(_nativeHandle,
+                requestId, timestampMs, frame);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing a RGBA32 video frame for it, which is
+        /// converted once to I420. This can be used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="requestId">The original request ID.</param>
+        /// <param name="timestampMs">The video frame timestamp.</param>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        public void CompleteFrameRequest(uint requestId, long timestampMs, in Rgba32VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_CompleteFrameRequest(_nativeHandle,
+                requestId, timestampMs, frame);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Complete the current request by providing an I420A video frame for it, without copying
+        /// the frame memory, which the encoder reads directly. The memory must remain valid and
+        /// unchanged until <paramref name="onReleased"/> is invoked, which happens exactly once,
+        /// on any thread, possibly before this call returns if the frame is not used. This can be
+        /// used with any source, whatever its frame encoding.
+        /// </summary>
+        /// <param name="requestId">The original request ID.</param>
+        /// <param name="timestampMs">The video frame timestamp.</param>
+        /// <param name="frame">The video frame used to complete the request.</param>
+        /// <param name="onReleased">Callback invoked once the frame memory can be reused.</param>
+        public void CompleteFrameRequestNoCopy(uint requestId, long timestampMs, in I420AVideoFrame frame,
+            Action onReleased)
+        {
+            ExternalVideoTrackSourceInterop.CompleteFrameRequestNoCopy(_nativeHandle, requestId, timestampMs,
+                frame, onReleased);
+        }
+
+        /// <summary>
+        /// Same as <see cref="PushFrame(long, in I420AVideoFrame)"/>, without copying the frame memory.
+        /// The memory must remain valid and unchanged until <paramref name="onReleased"/> is invoked,
+        /// as with <see cref="CompleteFrameRequestNoCopy(uint, long, in I420AVideoFrame, Action)"/>.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <param name="onReleased">Callback invoked once the frame memory can be reused.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrameNoCopy(long timestampMs, in I420AVideoFrame frame, Action onReleased)
+        {
+            return ExternalVideoTrackSourceInterop.PushFrameNoCopy(_nativeHandle, timestampMs, frame, onReleased);
+        }
+
+        /// <summary>
+        /// Push a new video frame to a source created with <see cref="CreateForPush"/>, to be delivered
+        /// synchronously to its video tracks with the given timestamp. The frame is dropped if its timestamp
+        /// is not strictly after the one of the last delivered frame, or if another frame is being delivered
+        /// and the drop policy of the source is <see cref="PushFrameDropPolicy.Drop"/>, or if the video
+        /// tracks do not want it, for example because their encoders reduced the frame rate; see
+        /// <see cref="GetWantedFormat(int, int)"/>.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in I420AVideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrame(_nativeHandle,
+                timestampMs, frame, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Push a new video frame to a source created with <see cref="CreateForPush"/>.
+        /// See <see cref="PushFrame(long, in I420AVideoFrame)"/> for details.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in Argb32VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrame(_nativeHandle,
+                timestampMs, frame, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Push a new video frame to a source created with <see cref="CreateForPush"/>, of which
+        /// only the given dirty regions changed, as with
+        /// <see cref="CompleteFrameRequest(uint, long, in Argb32VideoFrame, VideoRect[])"/>.
+        /// Since dropping the frame would lose its update, this waits for any frame being delivered
+        /// by another thread, whatever the drop policy of the source.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The entire video frame to deliver.</param>
+        /// <param name="dirtyRects">The regions of the frame which changed, clipped to the frame.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in Argb32VideoFrame frame, VideoRect[] dirtyRects)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrameDirty(_nativeHandle,
+                timestampMs, frame, dirtyRects, dirtyRects?.Length ?? 0, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Push a new NV12 video frame to a source created with <see cref="CreateForPush"/>, which is
+        /// converted once to I420. See <see cref="PushFrame(long, in I420AVideoFrame)"/> for details.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in Nv12VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrame(_nativeHandle,
+                timestampMs, frame, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Push a new YUY2 video frame to a source created with <see cref="CreateForPush"/>, which is
+        /// converted once to I420. See <see cref="PushFrame(long, in I420AVideoFrame)"/> for details.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in Yuy2VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrame(_nativeHandle,
+                timestampMs, frame, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Push a new BGR24 video frame to a source created with <see cref="CreateForPush"/>, which is
+        /// converted once to I420. See <see cref="PushFrame(long, in I420AVideoFrame)"/> for details.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in Bgr24VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrame(_nativeHandle,
+                timestampMs, frame, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Push a new RGBA32 video frame to a source created with <see cref="CreateForPush"/>, which is
+        /// converted once to I420. See <see cref="PushFrame(long, in I420AVideoFrame)"/> for details.
+        /// </summary>
+        /// <param name="timestampMs">The video frame timestamp, in milliseconds.</param>
+        /// <param name="frame">The video frame to deliver.</param>
+        /// <returns><c>true</c> if the frame was delivered, or <c>false</c> if it was dropped.</returns>
+        public bool PushFrame(long timestampMs, in Rgba32VideoFrame frame)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_PushFrame(_nativeHandle,
+                timestampMs, frame, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
+        /// <summary>
+        /// Set the policy of a push source for frames pushed while a previous frame is still being
+        /// delivered. The default is <see cref="PushFrameDropPolicy.Drop"/>.
+        /// </summary>
+        /// <param name="policy">The new drop policy.</param>
+        public void SetPushDropPolicy(PushFrameDropPolicy policy)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_SetPushDropPolicy(_nativeHandle, policy);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Set the rate at which frames are requested from the source, in frames per second.
+        /// Requests are scheduled against absolute deadlines, so the frame rate does not drift
+        /// over time. The default is 30 frames per second.
+        /// </summary>
+        /// <param name="frameRate">The new frame rate, in the ]0:1000] range.</param>
+        public void SetFrameRate(double frameRate)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_SetFrameRate(_nativeHandle, frameRate);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Set the policy of the source for frame requests whose deadline passed while the
+        /// source was late. The default is <see cref="FrameSchedulePolicy.Skip"/>.
+        /// </summary>
+        /// <param name="policy">The new schedule policy.</param>
+        public void SetSchedulePolicy(FrameSchedulePolicy policy)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_SetSchedulePolicy(_nativeHandle, policy);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Get the video format currently wanted by the video tracks of the source, for frames
+        /// whose resolution would otherwise be the given native resolution. The wanted resolution
+        /// preserves the native aspect ratio. This is cheap enough to be called for each frame,
+        /// for example from the frame request callback, to render at the wanted resolution.
+        /// </summary>
+        /// <param name="nativeWidth">Width of the frames produced without adaptation, in pixels.</param>
+        /// <param name="nativeHeight">Height of the frames produced without adaptation, in pixels.</param>
+        /// <returns>The wanted video format.</returns>
+        public WantedVideoFormat GetWantedFormat(int nativeWidth, int nativeHeight)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_GetWantedFormat(_nativeHandle,
+                nativeWidth, nativeHeight, out WantedVideoFormat format);
+            Utils.ThrowOnErrorCode(res);
+            return format;
+        }
+
+        /// <summary>
+        /// Set the policy of the source for static frames, identical to the previous frame.
+        /// The default is <see cref="StaticFramePolicy.None"/>.
+        /// </summary>
+        /// <param name="policy">The new static frame policy.</param>
+        public void SetStaticFramePolicy(StaticFramePolicy policy)
+        {
+            uint res = ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_SetStaticFramePolicy(_nativeHandle, policy);
+            Utils.ThrowOnErrorCode(res);
+        }
+
         /// <inheritdoc/>
         public void Dispose()
         {
@@ -160,13 +655,20 @@ namespace Microsoft.MixedReality.WebRTC
                 return;
             }
 
-            // Remove the tracks associated with this source from the peer connection, if any
-            PeerConnection?.RemoveLocalVideoTracksFromSource(this);
+            // Remove the tracks associated with this source from all peer connections, if any
+            foreach (var peer in PeerConnections)
+            {
+                peer.RemoveLocalVideoTracksFromSource(this);
+            }
             Debug.Assert(PeerConnection == null); // see OnTracksRemovedFromSource
 
             // Unregister and release the track callbacks
             ExternalVideoTrackSourceInterop.ExternalVideoTrackSource_Shutdown(_nativeHandle);
-            Utils.ReleaseWrapperRef(_frameRequestCallbackArgsHandle);
+            if (_frameRequestCallbackArgsHandle != IntPtr.Zero)
+            {
+                Utils.ReleaseWrapperRef(_frameRequestCallbackArgsHandle);
+                _frameRequestCallbackArgsHandle = IntPtr.Zero;
+            }
 
             // Destroy the native object. This may be delayed if a P/Invoke callback is underway,
             // but will be handled at some point anyway, even if the managed instance is gone.
@@ -180,20 +682,36 @@ namespace Microsoft.MixedReality.WebRTC
 
         internal void OnTracksAddedToSource(PeerConnection newConnection)
         {
-            Debug.Assert(PeerConnection == null);
             Debug.Assert(!_nativeHandle.IsClosed);
-            PeerConnection = newConnection;
-            var args = Utils.ToWrapper<ExternalVideoTrackSourceInterop.VideoFrameRequestCallbackArgs>(_frameRequestCallbackArgsHandle);
-            args.Peer = newConnection;
+            lock (_peerConnections)
+            {
+                // Multiple tracks from the same peer connection can share this source
+                if (!_peerConnections.Contains(newConnection))
+                {
+                    _peerConnections.Add(newConnection);
+                }
+            }
+            UpdateCallbackPeer();
         }
 
         internal void OnTracksRemovedFromSource(PeerConnection previousConnection)
         {
-            Debug.Assert(PeerConnection == previousConnection);
             Debug.Assert(!_nativeHandle.IsClosed);
-            var args = Utils.ToWrapper<ExternalVideoTrackSourceInterop.VideoFrameRequestCallbackArgs>(_frameRequestCallbackArgsHandle);
-            args.Peer = null;
-            PeerConnection = null;
+            lock (_peerConnections)
+            {
+                bool removed = _peerConnections.Remove(previousConnection);
+                Debug.Assert(removed);
+            }
+            UpdateCallbackPeer();
+        }
+
+        private void UpdateCallbackPeer()
+        {
+            if (_frameRequestCallbackArgsHandle != IntPtr.Zero) // push sources have no callback
+            {
+                var args = Utils.ToWrapper<ExternalVideoTrackSourceInterop.VideoFrameRequestCallbackArgs>(_frameRequestCallbackArgsHandle);
+                args.Peer = PeerConnection;
+            }
         }
     }
 }
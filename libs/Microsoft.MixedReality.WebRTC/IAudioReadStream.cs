@@ -4,6 +4,24 @@ using System.Text;
 
 namespace Microsoft.MixedReality.WebRTC
 {
+    /// <summary>
+    /// Sample format in which an audio read stream resamples the remote audio, when its sample
+    /// rate differs from the one read.
+    /// </summary>
+    public enum AudioResampleMode : int
+    {
+        /// <summary>
+        /// Resample 16-bit samples, then convert them to float.
+        /// </summary>
+        Int16 = 0,
+
+        /// <summary>
+        /// Convert samples to float, then resample them with a vectorized windowed-sinc resampler.
+        /// This avoids quantizing the resampled audio to 16 bits, at a higher CPU cost.
+        /// </summary>
+        Float = 1
+    }
+
     /// <summary>
     /// High level interface for consuming WebRTC audio streams.
     /// The implementation builds on top of the low-level AudioFrame callbacks
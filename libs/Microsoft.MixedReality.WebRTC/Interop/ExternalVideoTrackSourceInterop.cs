@@ -95,6 +95,20 @@ namespace Microsoft.MixedReality.WebRTC.Interop
             args.FrameRequestCallback.Invoke(in request);
         }
 
+        [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
+        public delegate void VideoFrameReleaseCallback(IntPtr userData);
+
+        [MonoPInvokeCallback(typeof(VideoFrameReleaseCallback))]
+        public static void ReleaseVideoFrameCallback(IntPtr userData)
+        {
+            var onReleased = Utils.ToWrapper<Action>(userData);
+            Utils.ReleaseWrapperRef(userData);
+            onReleased.Invoke();
+        }
+
+        // Keep the delegate alive for as long as native frames may reference it
+        private static readonly VideoFrameReleaseCallback _releaseVideoFrameCallback = ReleaseVideoFrameCallback;
+
         #endregion
 
 
@@ -129,6 +143,11 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         public static unsafe extern uint ExternalVideoTrackSource_CreateFromArgb32Callback(
             RequestExternalArgb32VideoFrameCallback callback, IntPtr userData, out ExternalVideoTrackSourceHandle sourceHandle);
 
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCreateForPush")]
+        public static unsafe extern uint ExternalVideoTrackSource_CreateForPush(
+            out ExternalVideoTrackSourceHandle sourceHandle);
+
         [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
             EntryPoint = "mrsExternalVideoTrackSourceFinishCreation")]
         public static unsafe extern uint ExternalVideoTrackSource_FinishCreation(ExternalVideoTrackSourceHandle sourceHandle);
@@ -152,6 +171,105 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         public static unsafe extern uint ExternalVideoTrackSource_CompleteFrameRequest(ExternalVideoTrackSourceHandle handle,
             uint requestId, long timestampMs, in Argb32VideoFrame frame);
 
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushI420AFrame")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrame(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in I420AVideoFrame frame, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushArgb32Frame")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrame(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in Argb32VideoFrame frame, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCompleteNv12FrameRequest")]
+        public static unsafe extern uint ExternalVideoTrackSource_CompleteFrameRequest(ExternalVideoTrackSourceHandle handle,
+            uint requestId, long timestampMs, in Nv12VideoFrame frame);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushNv12Frame")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrame(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in Nv12VideoFrame frame, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCompleteYuy2FrameRequest")]
+        public static unsafe extern uint ExternalVideoTrackSource_CompleteFrameRequest(ExternalVideoTrackSourceHandle handle,
+            uint requestId, long timestampMs, in Yuy2VideoFrame frame);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushYuy2Frame")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrame(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in Yuy2VideoFrame frame, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCompleteBgr24FrameRequest")]
+        public static unsafe extern uint ExternalVideoTrackSource_CompleteFrameRequest(ExternalVideoTrackSourceHandle handle,
+            uint requestId, long timestampMs, in Bgr24VideoFrame frame);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushBgr24Frame")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrame(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in Bgr24VideoFrame frame, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCompleteRgba32FrameRequest")]
+        public static unsafe extern uint ExternalVideoTrackSource_CompleteFrameRequest(ExternalVideoTrackSourceHandle handle,
+            uint requestId, long timestampMs, in Rgba32VideoFrame frame);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushRgba32Frame")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrame(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in Rgba32VideoFrame frame, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCompleteI420AFrameRequestNoCopy")]
+        public static unsafe extern uint ExternalVideoTrackSource_CompleteFrameRequestNoCopy(
+            ExternalVideoTrackSourceHandle handle, uint requestId, long timestampMs, in I420AVideoFrame frame,
+            VideoFrameReleaseCallback releaseCallback, IntPtr releaseUserData);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushI420AFrameNoCopy")]
+        public static unsafe extern uint ExternalVideoTrackSource_PushFrameNoCopy(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in I420AVideoFrame frame, VideoFrameReleaseCallback releaseCallback,
+            IntPtr releaseUserData, out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceSetPushDropPolicy")]
+        public static extern uint ExternalVideoTrackSource_SetPushDropPolicy(ExternalVideoTrackSourceHandle handle,
+            PushFrameDropPolicy policy);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceCompleteArgb32FrameRequestDirty")]
+        public static extern uint ExternalVideoTrackSource_CompleteFrameRequestDirty(
+            ExternalVideoTrackSourceHandle handle, uint requestId, long timestampMs, in Argb32VideoFrame frame,
+            [In] VideoRect[] dirtyRects, int dirtyRectCount);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourcePushArgb32FrameDirty")]
+        public static extern uint ExternalVideoTrackSource_PushFrameDirty(ExternalVideoTrackSourceHandle handle,
+            long timestampMs, in Argb32VideoFrame frame, [In] VideoRect[] dirtyRects, int dirtyRectCount,
+            out mrsBool dropped);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceSetFrameRate")]
+        public static extern uint ExternalVideoTrackSource_SetFrameRate(ExternalVideoTrackSourceHandle handle,
+            double frameRate);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceSetSchedulePolicy")]
+        public static extern uint ExternalVideoTrackSource_SetSchedulePolicy(ExternalVideoTrackSourceHandle handle,
+            FrameSchedulePolicy policy);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceGetWantedFormat")]
+        public static extern uint ExternalVideoTrackSource_GetWantedFormat(ExternalVideoTrackSourceHandle handle,
+            int nativeWidth, int nativeHeight, out WantedVideoFormat format);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsExternalVideoTrackSourceSetStaticFramePolicy")]
+        public static extern uint ExternalVideoTrackSource_SetStaticFramePolicy(ExternalVideoTrackSourceHandle handle,
+            StaticFramePolicy policy);
+
         [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
             EntryPoint = "mrsExternalVideoTrackSourceShutdown")]
         public static extern void ExternalVideoTrackSource_Shutdown(ExternalVideoTrackSourceHandle handle);
@@ -235,6 +353,17 @@ namespace Microsoft.MixedReality.WebRTC.Interop
             }
         }
 
+        public static ExternalVideoTrackSource CreateExternalVideoTrackSourceForPush()
+        {
+            // Push sources have no frame request callback to keep alive
+            var source = new ExternalVideoTrackSource(IntPtr.Zero);
+            uint res = ExternalVideoTrackSource_CreateForPush(out ExternalVideoTrackSourceHandle sourceHandle);
+            Utils.ThrowOnErrorCode(res);
+            source.OnCreated(sourceHandle);
+            ExternalVideoTrackSource_FinishCreation(sourceHandle);
+            return source;
+        }
+
         public static void CompleteFrameRequest(ExternalVideoTrackSourceHandle sourceHandle, uint requestId,
             long timestampMs, in I420AVideoFrame frame)
         {
@@ -242,6 +371,27 @@ namespace Microsoft.MixedReality.WebRTC.Interop
             Utils.ThrowOnErrorCode(res);
         }
 
+        public static void CompleteFrameRequestNoCopy(ExternalVideoTrackSourceHandle sourceHandle, uint requestId,
+            long timestampMs, in I420AVideoFrame frame, Action onReleased)
+        {
+            // The native implementation always invokes the callback exactly once, which releases this reference
+            var releaseRef = Utils.MakeWrapperRef(onReleased);
+            uint res = ExternalVideoTrackSource_CompleteFrameRequestNoCopy(sourceHandle, requestId, timestampMs,
+                frame, _releaseVideoFrameCallback, releaseRef);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        public static bool PushFrameNoCopy(ExternalVideoTrackSourceHandle sourceHandle, long timestampMs,
+            in I420AVideoFrame frame, Action onReleased)
+        {
+            // The native implementation always invokes the callback exactly once, which releases this reference
+            var releaseRef = Utils.MakeWrapperRef(onReleased);
+            uint res = ExternalVideoTrackSource_PushFrameNoCopy(sourceHandle, timestampMs, frame,
+                _releaseVideoFrameCallback, releaseRef, out mrsBool dropped);
+            Utils.ThrowOnErrorCode(res);
+            return !(bool)dropped;
+        }
+
         public static void CompleteFrameRequest(ExternalVideoTrackSourceHandle sourceHandle, uint requestId,
             long timestampMs, in Argb32VideoFrame frame)
         {
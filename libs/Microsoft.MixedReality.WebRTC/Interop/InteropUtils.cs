@@ -133,6 +133,20 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         public static unsafe extern void MemCpyStride(void* dst, int dst_stride, void* src, int src_stride,
             int elem_size, int elem_count);
 
+        /// <summary>
+        /// Retain a native video frame buffer to keep accessing its data after the frame callback returned.
+        /// </summary>
+        /// <param name="handle">Handle to the native buffer, as delivered with the frame.</param>
+        [DllImport(dllPath, CallingConvention = CallingConvention.StdCall, EntryPoint = "mrsVideoFrameBufferAddRef")]
+        public static extern void VideoFrameBufferAddRef(IntPtr handle);
+
+        /// <summary>
+        /// Release a native video frame buffer previously retained with <see cref="VideoFrameBufferAddRef(IntPtr)"/>.
+        /// </summary>
+        /// <param name="handle">Handle to the native buffer, as delivered with the frame.</param>
+        [DllImport(dllPath, CallingConvention = CallingConvention.StdCall, EntryPoint = "mrsVideoFrameBufferRemoveRef")]
+        public static extern void VideoFrameBufferRemoveRef(IntPtr handle);
+
         /// <summary>
         /// Helper to throw an exception based on an error code.
         /// </summary>
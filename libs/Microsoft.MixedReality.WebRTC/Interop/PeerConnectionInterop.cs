@@ -73,6 +73,10 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         private delegate void GetStatsDelegate(IntPtr peer, ref PeerConnection.StatsData stats);
         private delegate void TrackAddedDelegate(IntPtr peer, PeerConnection.TrackKind trackKind);
         private delegate void TrackRemovedDelegate(IntPtr peer, PeerConnection.TrackKind trackKind);
+        private delegate void RemoteVideoTrackAddedDelegate(IntPtr peer, IntPtr trackHandle, string trackId);
+        private delegate void RemoteVideoTrackRemovedDelegate(IntPtr peer, IntPtr trackHandle, string trackId);
+        private delegate void RemoteAudioTrackAddedDelegate(IntPtr peer, IntPtr trackHandle, string trackId);
+        private delegate void RemoteAudioTrackRemovedDelegate(IntPtr peer, IntPtr trackHandle, string trackId);
         private delegate void DataChannelMessageDelegate(IntPtr peer, IntPtr data, ulong size);
         private delegate void DataChannelBufferingDelegate(IntPtr peer, ulong previous, ulong current, ulong limit);
         private delegate void DataChannelStateDelegate(IntPtr peer, int state, int id);
@@ -166,6 +170,10 @@ namespace Microsoft.MixedReality.WebRTC.Interop
             public PeerConnectionStatsUpdatedCallback StatsUpdatedCallback;
             public PeerConnectionTrackAddedCallback TrackAddedCallback;
             public PeerConnectionTrackRemovedCallback TrackRemovedCallback;
+            public PeerConnectionRemoteVideoTrackAddedCallback RemoteVideoTrackAddedCallback;
+            public PeerConnectionRemoteVideoTrackRemovedCallback RemoteVideoTrackRemovedCallback;
+            public PeerConnectionRemoteAudioTrackAddedCallback RemoteAudioTrackAddedCallback;
+            public PeerConnectionRemoteAudioTrackRemovedCallback RemoteAudioTrackRemovedCallback;
             public LocalVideoTrackInterop.I420AVideoFrameUnmanagedCallback I420ALocalVideoFrameCallback;
             public LocalVideoTrackInterop.I420AVideoFrameUnmanagedCallback I420ARemoteVideoFrameCallback;
             public LocalVideoTrackInterop.Argb32VideoFrameUnmanagedCallback Argb32LocalVideoFrameCallback;
@@ -257,6 +265,40 @@ namespace Microsoft.MixedReality.WebRTC.Interop
             peer.OnTrackRemoved(trackKind);
         }
 
+        [MonoPInvokeCallback(typeof(RemoteVideoTrackAddedDelegate))]
+        public static void RemoteVideoTrackAddedCallback(IntPtr userData, IntPtr trackHandle, string trackId)
+        {
+            var peer = Utils.ToWrapper<PeerConnection>(userData);
+            // Take a reference to the native track for the lifetime of the wrapper
+            RemoteVideoTrackInterop.RemoteVideoTrack_AddRef(trackHandle);
+            var track = new RemoteVideoTrack(new RemoteVideoTrackHandle(trackHandle), peer, trackId);
+            peer.OnRemoteVideoTrackAdded(trackHandle, track);
+        }
+
+        [MonoPInvokeCallback(typeof(RemoteVideoTrackRemovedDelegate))]
+        public static void RemoteVideoTrackRemovedCallback(IntPtr userData, IntPtr trackHandle, string trackId)
+        {
+            var peer = Utils.ToWrapper<PeerConnection>(userData);
+            peer.OnRemoteVideoTrackRemoved(trackHandle);
+        }
+
+        [MonoPInvokeCallback(typeof(RemoteAudioTrackAddedDelegate))]
+        public static void RemoteAudioTrackAddedCallback(IntPtr userData, IntPtr trackHandle, string trackId)
+        {
+            var peer = Utils.ToWrapper<PeerConnection>(userData);
+            // Take a reference to the native track for the lifetime of the wrapper
+            RemoteAudioTrackInterop.RemoteAudioTrack_AddRef(trackHandle);
+            var track = new RemoteAudioTrack(new RemoteAudioTrackHandle(trackHandle), peer, trackId);
+            peer.OnRemoteAudioTrackAdded(trackHandle, track);
+        }
+
+        [MonoPInvokeCallback(typeof(RemoteAudioTrackRemovedDelegate))]
+        public static void RemoteAudioTrackRemovedCallback(IntPtr userData, IntPtr trackHandle, string trackId)
+        {
+            var peer = Utils.ToWrapper<PeerConnection>(userData);
+            peer.OnRemoteAudioTrackRemoved(trackHandle);
+        }
+
         [MonoPInvokeCallback(typeof(LocalVideoTrackInterop.I420AVideoFrameUnmanagedCallback))]
         public static void I420ARemoteVideoFrameCallback(IntPtr userData, ref I420AVideoFrame frame)
         {
@@ -486,6 +528,22 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
         public delegate void PeerConnectionTrackRemovedCallback(IntPtr userData, PeerConnection.TrackKind trackKind);
 
+        [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
+        public delegate void PeerConnectionRemoteVideoTrackAddedCallback(IntPtr userData, IntPtr trackHandle,
+            string trackId);
+
+        [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
+        public delegate void PeerConnectionRemoteVideoTrackRemovedCallback(IntPtr userData, IntPtr trackHandle,
+            string trackId);
+
+        [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
+        public delegate void PeerConnectionRemoteAudioTrackAddedCallback(IntPtr userData, IntPtr trackHandle,
+            string trackId);
+
+        [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
+        public delegate void PeerConnectionRemoteAudioTrackRemovedCallback(IntPtr userData, IntPtr trackHandle,
+            string trackId);
+
         [UnmanagedFunctionPointer(CallingConvention.StdCall, CharSet = CharSet.Ansi)]
         public delegate void AudioFrameUnmanagedCallback(IntPtr userData, ref AudioFrame frame);
 
@@ -585,6 +643,30 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         public static extern void PeerConnection_RegisterTrackRemovedCallback(PeerConnectionHandle peerHandle,
             PeerConnectionTrackRemovedCallback callback, IntPtr userData);
 
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionRegisterRemoteVideoTrackAddedCallback")]
+        public static extern void PeerConnection_RegisterRemoteVideoTrackAddedCallback(
+            PeerConnectionHandle peerHandle, PeerConnectionRemoteVideoTrackAddedCallback callback,
+            IntPtr userData);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionRegisterRemoteVideoTrackRemovedCallback")]
+        public static extern void PeerConnection_RegisterRemoteVideoTrackRemovedCallback(
+            PeerConnectionHandle peerHandle, PeerConnectionRemoteVideoTrackRemovedCallback callback,
+            IntPtr userData);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionRegisterRemoteAudioTrackAddedCallback")]
+        public static extern void PeerConnection_RegisterRemoteAudioTrackAddedCallback(
+            PeerConnectionHandle peerHandle, PeerConnectionRemoteAudioTrackAddedCallback callback,
+            IntPtr userData);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionRegisterRemoteAudioTrackRemovedCallback")]
+        public static extern void PeerConnection_RegisterRemoteAudioTrackRemovedCallback(
+            PeerConnectionHandle peerHandle, PeerConnectionRemoteAudioTrackRemovedCallback callback,
+            IntPtr userData);
+
         [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
             EntryPoint = "mrsPeerConnectionRegisterDataChannelAddedCallback")]
         public static extern void PeerConnection_RegisterDataChannelAddedCallback(PeerConnectionHandle peerHandle,
@@ -605,6 +687,30 @@ namespace Microsoft.MixedReality.WebRTC.Interop
         public static extern void PeerConnection_RegisterArgb32RemoteVideoFrameCallback(PeerConnectionHandle peerHandle,
             LocalVideoTrackInterop.Argb32VideoFrameUnmanagedCallback callback, IntPtr userData);
 
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionSetRemoteVideoFrameTargetSize")]
+        public static extern uint PeerConnection_SetRemoteVideoFrameTargetSize(PeerConnectionHandle peerHandle,
+            VideoFrameFormat format, int width, int height);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionSetRemoteVideoDeliveryMode")]
+        public static extern uint PeerConnection_SetRemoteVideoDeliveryMode(PeerConnectionHandle peerHandle,
+            VideoFrameDeliveryMode mode);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionPollRemoteVideoFrame")]
+        public static extern int PeerConnection_PollRemoteVideoFrame(PeerConnectionHandle peerHandle);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionSetArgb32RemoteVideoFrameDestinations")]
+        public static extern uint PeerConnection_SetArgb32RemoteVideoFrameDestinations(PeerConnectionHandle peerHandle,
+            IntPtr[] buffers, int count, ulong size, int stride);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsPeerConnectionReleaseArgb32RemoteVideoFrameDestination")]
+        public static extern uint PeerConnection_ReleaseArgb32RemoteVideoFrameDestination(PeerConnectionHandle peerHandle,
+            IntPtr buffer);
+
         [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
             EntryPoint = "mrsPeerConnectionRegisterLocalAudioFrameCallback")]
         public static extern void PeerConnection_RegisterLocalAudioFrameCallback(PeerConnectionHandle peerHandle,
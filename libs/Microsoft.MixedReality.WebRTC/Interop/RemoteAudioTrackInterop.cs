@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Microsoft.MixedReality.WebRTC.Interop
+{
+    /// <summary>
+    /// Handle to a native remote audio track object.
+    /// </summary>
+    internal sealed class RemoteAudioTrackHandle : SafeHandle
+    {
+        /// <summary>
+        /// Check if the current handle is invalid, which means it is not referencing
+        /// an actual native object. Note that a valid handle only means that the internal
+        /// handle references a native object, but does not guarantee that the native
+        /// object is still accessible. It is only safe to access the native object if
+        /// the handle is not closed, which implies it being valid.
+        /// </summary>
+        public override bool IsInvalid
+        {
+            get
+            {
+                return (handle == IntPtr.Zero);
+            }
+        }
+
+        /// <summary>
+        /// Default constructor for an invalid handle.
+        /// </summary>
+        public RemoteAudioTrackHandle() : base(IntPtr.Zero, ownsHandle: true)
+        {
+        }
+
+        /// <summary>
+        /// Constructor for a valid handle referencing the given native object.
+        /// </summary>
+        /// <param name="handle">The valid internal handle to the native object.</param>
+        public RemoteAudioTrackHandle(IntPtr handle) : base(IntPtr.Zero, ownsHandle: true)
+        {
+            SetHandle(handle);
+        }
+
+        /// <summary>
+        /// Release the native object while the handle is being closed.
+        /// </summary>
+        /// <returns>Return <c>true</c> if the native object was successfully released.</returns>
+        protected override bool ReleaseHandle()
+        {
+            RemoteAudioTrackInterop.RemoteAudioTrack_RemoveRef(handle);
+            return true;
+        }
+    }
+
+    internal class RemoteAudioTrackInterop
+    {
+        #region Native functions
+
+        // Note - This is used before the RemoteAudioTrackHandle is created, to take ownership
+        // of a reference to the native object.
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsRemoteAudioTrackAddRef")]
+        public static unsafe extern void RemoteAudioTrack_AddRef(IntPtr handle);
+
+        // Note - This is used during SafeHandle.ReleaseHandle(), so cannot use RemoteAudioTrackHandle
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsRemoteAudioTrackRemoveRef")]
+        public static unsafe extern void RemoteAudioTrack_RemoveRef(IntPtr handle);
+
+        [DllImport(Utils.dllPath, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Ansi,
+            EntryPoint = "mrsRemoteAudioTrackCreateReadStream")]
+        public static extern uint RemoteAudioTrack_CreateReadStream(RemoteAudioTrackHandle trackHandle,
+            int bufferMs, AudioResampleMode resampleMode, ref IntPtr audioReadStream);
+
+        #endregion
+    }
+}
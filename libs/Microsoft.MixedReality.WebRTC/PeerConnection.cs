@@ -604,6 +604,30 @@ namespace Microsoft.MixedReality.WebRTC
         /// </summary>
         public event Action<TrackKind> TrackRemoved;
 
+        /// <summary>
+        /// Event that occurs when a remote video track is added to the current connection.
+        /// The track delivers its own frames, separately from any other remote video track.
+        /// </summary>
+        public event Action<RemoteVideoTrack> RemoteVideoTrackAdded;
+
+        /// <summary>
+        /// Event that occurs when a remote video track is removed from the current connection.
+        /// The track is disposed by the peer connection after the event handlers returned.
+        /// </summary>
+        public event Action<RemoteVideoTrack> RemoteVideoTrackRemoved;
+
+        /// <summary>
+        /// Event that occurs when a remote audio track is added to the current connection.
+        /// The track delivers its own audio, separately from any other remote audio track.
+        /// </summary>
+        public event Action<RemoteAudioTrack> RemoteAudioTrackAdded;
+
+        /// <summary>
+        /// Event that occurs when a remote audio track is removed from the current connection.
+        /// The track is disposed by the peer connection after the event handlers returned.
+        /// </summary>
+        public event Action<RemoteAudioTrack> RemoteAudioTrackRemoved;
+
         /// <summary>
         /// Event that occurs when a video frame from a remote peer has been
         /// received and is available for render.
@@ -664,6 +688,18 @@ namespace Microsoft.MixedReality.WebRTC
         /// </summary>
         private object _openCloseLock = new object();
 
+        /// <summary>
+        /// Remote video tracks currently part of the connection, indexed by native handle.
+        /// </summary>
+        private readonly Dictionary<IntPtr, RemoteVideoTrack> _remoteVideoTracks =
+            new Dictionary<IntPtr, RemoteVideoTrack>();
+
+        /// <summary>
+        /// Remote audio tracks currently part of the connection, indexed by native handle.
+        /// </summary>
+        private readonly Dictionary<IntPtr, RemoteAudioTrack> _remoteAudioTracks =
+            new Dictionary<IntPtr, RemoteAudioTrack>();
+
         private PeerConnectionInterop.InteropCallbacks _interopCallbacks;
         private PeerConnectionInterop.PeerCallbackArgs _peerCallbackArgs;
 
@@ -740,6 +776,10 @@ namespace Microsoft.MixedReality.WebRTC
                     RenegotiationNeededCallback = PeerConnectionInterop.RenegotiationNeededCallback,
                     TrackAddedCallback = PeerConnectionInterop.TrackAddedCallback,
                     TrackRemovedCallback = PeerConnectionInterop.TrackRemovedCallback,
+                    RemoteVideoTrackAddedCallback = PeerConnectionInterop.RemoteVideoTrackAddedCallback,
+                    RemoteVideoTrackRemovedCallback = PeerConnectionInterop.RemoteVideoTrackRemovedCallback,
+                    RemoteAudioTrackAddedCallback = PeerConnectionInterop.RemoteAudioTrackAddedCallback,
+                    RemoteAudioTrackRemovedCallback = PeerConnectionInterop.RemoteAudioTrackRemovedCallback,
                     I420ARemoteVideoFrameCallback = PeerConnectionInterop.I420ARemoteVideoFrameCallback,
                     Argb32RemoteVideoFrameCallback = PeerConnectionInterop.Argb32RemoteVideoFrameCallback,
                     LocalAudioFrameCallback = PeerConnectionInterop.LocalAudioFrameCallback,
@@ -837,6 +877,14 @@ namespace Microsoft.MixedReality.WebRTC
                             _nativePeerhandle, _peerCallbackArgs.TrackAddedCallback, self);
                         PeerConnectionInterop.PeerConnection_RegisterTrackRemovedCallback(
                             _nativePeerhandle, _peerCallbackArgs.TrackRemovedCallback, self);
+                        PeerConnectionInterop.PeerConnection_RegisterRemoteVideoTrackAddedCallback(
+                            _nativePeerhandle, _peerCallbackArgs.RemoteVideoTrackAddedCallback, self);
+                        PeerConnectionInterop.PeerConnection_RegisterRemoteVideoTrackRemovedCallback(
+                            _nativePeerhandle, _peerCallbackArgs.RemoteVideoTrackRemovedCallback, self);
+                        PeerConnectionInterop.PeerConnection_RegisterRemoteAudioTrackAddedCallback(
+                            _nativePeerhandle, _peerCallbackArgs.RemoteAudioTrackAddedCallback, self);
+                        PeerConnectionInterop.PeerConnection_RegisterRemoteAudioTrackRemovedCallback(
+                            _nativePeerhandle, _peerCallbackArgs.RemoteAudioTrackRemovedCallback, self);
                         PeerConnectionInterop.PeerConnection_RegisterDataChannelAddedCallback(
                             _nativePeerhandle, _peerCallbackArgs.DataChannelAddedCallback, self);
                         PeerConnectionInterop.PeerConnection_RegisterDataChannelRemovedCallback(
@@ -904,6 +952,14 @@ namespace Microsoft.MixedReality.WebRTC
                     _nativePeerhandle, null, IntPtr.Zero);
                 PeerConnectionInterop.PeerConnection_RegisterTrackRemovedCallback(
                     _nativePeerhandle, null, IntPtr.Zero);
+                PeerConnectionInterop.PeerConnection_RegisterRemoteVideoTrackAddedCallback(
+                    _nativePeerhandle, null, IntPtr.Zero);
+                PeerConnectionInterop.PeerConnection_RegisterRemoteVideoTrackRemovedCallback(
+                    _nativePeerhandle, null, IntPtr.Zero);
+                PeerConnectionInterop.PeerConnection_RegisterRemoteAudioTrackAddedCallback(
+                    _nativePeerhandle, null, IntPtr.Zero);
+                PeerConnectionInterop.PeerConnection_RegisterRemoteAudioTrackRemovedCallback(
+                    _nativePeerhandle, null, IntPtr.Zero);
                 PeerConnectionInterop.PeerConnection_RegisterDataChannelAddedCallback(
                     _nativePeerhandle, null, IntPtr.Zero);
                 PeerConnectionInterop.PeerConnection_RegisterDataChannelRemovedCallback(
@@ -944,6 +1000,31 @@ namespace Microsoft.MixedReality.WebRTC
             _nativePeerhandle.Close();
             }
 
+            // Dispose of the remote video and audio tracks, which the native connection detached on close
+            // without notifying, since the callbacks were unregistered above.
+            List<RemoteVideoTrack> remoteVideoTracks;
+            lock (_remoteVideoTracks)
+            {
+                remoteVideoTracks = new List<RemoteVideoTrack>(_remoteVideoTracks.Values);
+                _remoteVideoTracks.Clear();
+            }
+            foreach (var track in remoteVideoTracks)
+            {
+                track.OnTrackRemoved(this);
+                track.Dispose();
+            }
+            List<RemoteAudioTrack> remoteAudioTracks;
+            lock (_remoteAudioTracks)
+            {
+                remoteAudioTracks = new List<RemoteAudioTrack>(_remoteAudioTracks.Values);
+                _remoteAudioTracks.Clear();
+            }
+            foreach (var track in remoteAudioTracks)
+            {
+                track.OnTrackRemoved(this);
+                track.Dispose();
+            }
+
             // Complete shutdown sequence and re-enable InitializeAsync()
             lock (_openCloseLock)
             {
@@ -1073,6 +1154,10 @@ namespace Microsoft.MixedReality.WebRTC
         /// </summary>
         /// <param name="trackName">Name of the new track.</param>
         /// <param name="externalSource">External source providing the frames for the track.</param>
+        /// <remarks>
+        /// The same source can be used to add tracks to several peer connections. Each frame is then converted
+        /// once, and the same frame buffer is sent to all the tracks.
+        /// </remarks>
         public LocalVideoTrack AddCustomLocalVideoTrack(string trackName, ExternalVideoTrackSource externalSource)
         {
             ThrowIfConnectionNotOpen();
@@ -1109,8 +1194,8 @@ namespace Microsoft.MixedReality.WebRTC
         /// </summary>
         /// <param name="source">The video track source.</param>
         /// <remarks>
-        /// Currently there is a 1:1 mapping between tracks and sources (source sharing is not available),
-        /// therefore this is equivalent to <see cref="RemoveLocalVideoTrack(LocalVideoTrack)"/>.
+        /// This only removes the tracks of this peer connection. If the source also feeds tracks on other
+        /// peer connections, those are left untouched and the source keeps producing frames for them.
         /// </remarks>
         public void RemoveLocalVideoTracksFromSource(ExternalVideoTrackSource source)
         {
@@ -1119,6 +1204,91 @@ namespace Microsoft.MixedReality.WebRTC
             source.OnTracksRemovedFromSource(this);
         }
 
+        /// <summary>
+        /// Set the maximum dimensions of the remote video frames delivered in the given format.
+        /// Larger frames are scaled down, preserving their aspect ratio, before being converted,
+        /// so that small views like thumbnails only pay for the pixels they display. When all
+        /// frame events in use have a target size, the remote video tracks are also requested
+        /// to lower their resolution accordingly.
+        /// </summary>
+        /// <param name="format">Format of the frame event to configure, e.g.
+        /// <see cref="VideoFrameFormat.Argb32"/> for <see cref="Argb32RemoteVideoFrameReady"/>.</param>
+        /// <param name="width">Maximum frame width in pixels, or zero for the decoded resolution.</param>
+        /// <param name="height">Maximum frame height in pixels, or zero for the decoded resolution.</param>
+        /// <exception xref="InvalidOperationException">The peer connection is not initialized.</exception>
+        public void SetRemoteVideoFrameTargetSize(VideoFrameFormat format, uint width, uint height)
+        {
+            ThrowIfConnectionNotOpen();
+            uint res = PeerConnectionInterop.PeerConnection_SetRemoteVideoFrameTargetSize(_nativePeerhandle,
+                format, (int)width, (int)height);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Set the delivery mode of the remote video frames to <see cref="I420ARemoteVideoFrameReady"/>
+        /// and <see cref="Argb32RemoteVideoFrameReady"/>. In <see cref="VideoFrameDeliveryMode.Polled"/>
+        /// mode, the WebRTC decoder thread only keeps the latest frame, which is converted and delivered
+        /// when calling <see cref="PollRemoteVideoFrame"/>, typically once per render loop iteration.
+        /// </summary>
+        /// <param name="mode">The new delivery mode.</param>
+        /// <exception xref="InvalidOperationException">The peer connection is not initialized.</exception>
+        public void SetRemoteVideoDeliveryMode(VideoFrameDeliveryMode mode)
+        {
+            ThrowIfConnectionNotOpen();
+            uint res = PeerConnectionInterop.PeerConnection_SetRemoteVideoDeliveryMode(_nativePeerhandle, mode);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// In <see cref="VideoFrameDeliveryMode.Polled"/> delivery mode, fire the remote video frame events
+        /// on the calling thread for the latest frame received since the previous call, if any.
+        /// </summary>
+        /// <returns><c>true</c> if a frame was delivered, or <c>false</c> if no new frame was available.</returns>
+        /// <exception xref="InvalidOperationException">The peer connection is not initialized.</exception>
+        public bool PollRemoteVideoFrame()
+        {
+            ThrowIfConnectionNotOpen();
+            return (PeerConnectionInterop.PeerConnection_PollRemoteVideoFrame(_nativePeerhandle) != 0);
+        }
+
+        /// <summary>
+        /// Register a ring of application-owned buffers into which remote video frames are converted directly
+        /// before being delivered to <see cref="Argb32RemoteVideoFrameReady"/>, instead of into an internal buffer.
+        /// This avoids copying the frame data, for example when the buffers are persistently mapped staging buffers.
+        /// The <see cref="Argb32VideoFrame.data"/> field of each frame points into one of the buffers, which is then
+        /// reserved until released with <see cref="ReleaseArgb32RemoteVideoFrameDestination(IntPtr)"/>. Frames
+        /// arriving while all buffers are reserved, or which do not fit into a buffer, are dropped.
+        /// </summary>
+        /// <param name="buffers">
+        /// Pointers to the destination buffers, which must remain valid until unregistered, or <c>null</c> or an
+        /// empty array to revert to internal buffers.
+        /// </param>
+        /// <param name="size">Size of each buffer, in bytes.</param>
+        /// <param name="stride">Stride in bytes between rows of the converted frames.</param>
+        /// <exception xref="InvalidOperationException">The peer connection is not initialized.</exception>
+        public void SetArgb32RemoteVideoFrameDestinations(IntPtr[] buffers, ulong size, int stride)
+        {
+            ThrowIfConnectionNotOpen();
+            int count = (buffers != null ? buffers.Length : 0);
+            uint res = PeerConnectionInterop.PeerConnection_SetArgb32RemoteVideoFrameDestinations(_nativePeerhandle,
+                buffers, count, size, stride);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Release a buffer registered with <see cref="SetArgb32RemoteVideoFrameDestinations(IntPtr[], ulong, int)"/>
+        /// once done with the frame it holds, so that it can receive a new frame. This can be called from any thread.
+        /// </summary>
+        /// <param name="buffer">Pointer to the buffer, as passed in <see cref="Argb32VideoFrame.data"/>.</param>
+        /// <exception xref="InvalidOperationException">The peer connection is not initialized.</exception>
+        public void ReleaseArgb32RemoteVideoFrameDestination(IntPtr buffer)
+        {
+            ThrowIfConnectionNotOpen();
+            uint res = PeerConnectionInterop.PeerConnection_ReleaseArgb32RemoteVideoFrameDestination(_nativePeerhandle,
+                buffer);
+            Utils.ThrowOnErrorCode(res);
+        }
+
         /// <summary>
         /// Enable or disable the local audio track associated with this peer connection.
         /// Disable audio tracks are still active, but are silent.
@@ -1154,12 +1324,19 @@ namespace Microsoft.MixedReality.WebRTC
             PeerConnectionInterop.PeerConnection_RemoveLocalAudioTrack(_nativePeerhandle);
         }
 
-        class AudioReadStream : IAudioReadStream
+        internal class AudioReadStream : IAudioReadStream
         {
             IntPtr _nativeStreamHandle = IntPtr.Zero;
-            internal AudioReadStream(PeerConnectionHandle peerHandle, int bufferMs)
+            internal AudioReadStream(PeerConnectionHandle peerHandle, int bufferMs, AudioResampleMode resampleMode)
             {
-                uint res = AudioReadStreamInterop.Create(peerHandle, bufferMs, ref _nativeStreamHandle);
+                uint res = AudioReadStreamInterop.CreateWithResampleMode(peerHandle, bufferMs, resampleMode,
+                    ref _nativeStreamHandle);
+                Utils.ThrowOnErrorCode(res);
+            }
+            internal AudioReadStream(RemoteAudioTrackHandle trackHandle, int bufferMs, AudioResampleMode resampleMode)
+            {
+                uint res = RemoteAudioTrackInterop.RemoteAudioTrack_CreateReadStream(trackHandle, bufferMs,
+                    resampleMode, ref _nativeStreamHandle);
                 Utils.ThrowOnErrorCode(res);
             }
             ~AudioReadStream()
@@ -1192,10 +1369,20 @@ namespace Microsoft.MixedReality.WebRTC
         /// The implementation builds on top of the low-level AudioFrame callbacks
         /// and handles all buffering and resampling.
         /// </summary>
-        /// <param name="bufferMs">Size of the buffer in milliseconds or -1 for default.</param>
-        public IAudioReadStream CreateAudioReadStream(int bufferMs = -1)
+        /// <param name="bufferMs">
+        /// Size of the buffer in milliseconds or -1 for the default of 60 ms. The stream compensates the clock drift
+        /// between WebRTC and the reader to keep the buffer half full, so buffers of 40 to 60 ms are
+        /// enough to absorb the jitter of both sides.
+        /// </param>
+        /// <param name="resampleMode">Sample format in which the audio is resampled, if needed.</param>
+        /// <remarks>
+        /// The stream reads the audio of all remote audio tracks, interleaved. To read the audio of
+        /// each remote track separately, use <see cref="RemoteAudioTrack.CreateAudioReadStream"/>.
+        /// </remarks>
+        public IAudioReadStream CreateAudioReadStream(int bufferMs = -1,
+            AudioResampleMode resampleMode = AudioResampleMode.Int16)
         {
-            return new AudioReadStream(_nativePeerhandle, bufferMs);
+            return new AudioReadStream(_nativePeerhandle, bufferMs, resampleMode);
         }
 
         #endregion
@@ -2131,6 +2318,56 @@ namespace Microsoft.MixedReality.WebRTC
             TrackRemoved?.Invoke(trackKind);
         }
 
+        internal void OnRemoteVideoTrackAdded(IntPtr trackHandle, RemoteVideoTrack track)
+        {
+            lock (_remoteVideoTracks)
+            {
+                _remoteVideoTracks.Add(trackHandle, track);
+            }
+            RemoteVideoTrackAdded?.Invoke(track);
+        }
+
+        internal void OnRemoteVideoTrackRemoved(IntPtr trackHandle)
+        {
+            RemoteVideoTrack track;
+            lock (_remoteVideoTracks)
+            {
+                if (!_remoteVideoTracks.TryGetValue(trackHandle, out track))
+                {
+                    return;
+                }
+                _remoteVideoTracks.Remove(trackHandle);
+            }
+            track.OnTrackRemoved(this);
+            RemoteVideoTrackRemoved?.Invoke(track);
+            track.Dispose();
+        }
+
+        internal void OnRemoteAudioTrackAdded(IntPtr trackHandle, RemoteAudioTrack track)
+        {
+            lock (_remoteAudioTracks)
+            {
+                _remoteAudioTracks.Add(trackHandle, track);
+            }
+            RemoteAudioTrackAdded?.Invoke(track);
+        }
+
+        internal void OnRemoteAudioTrackRemoved(IntPtr trackHandle)
+        {
+            RemoteAudioTrack track;
+            lock (_remoteAudioTracks)
+            {
+                if (!_remoteAudioTracks.TryGetValue(trackHandle, out track))
+                {
+                    return;
+                }
+                _remoteAudioTracks.Remove(trackHandle);
+            }
+            track.OnTrackRemoved(this);
+            RemoteAudioTrackRemoved?.Invoke(track);
+            track.Dispose();
+        }
+
         internal void OnI420ARemoteVideoFrameReady(in I420AVideoFrame frame)
         {
             MainEventSource.Log.I420ARemoteVideoFrameReady(frame.width, frame.height);
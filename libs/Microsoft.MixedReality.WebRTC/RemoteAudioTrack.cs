@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+using System;
+using Microsoft.MixedReality.WebRTC.Interop;
+
+namespace Microsoft.MixedReality.WebRTC
+{
+    /// <summary>
+    /// Audio track receiving audio frames from the remote peer.
+    /// </summary>
+    /// <remarks>
+    /// Each remote audio track delivers its own audio, separately from other remote audio tracks
+    /// of the same peer connection, so that the audio of several remote participants can be read
+    /// and spatialized separately instead of being interleaved.
+    /// Instances are created by the peer connection, and made available through the
+    /// <see cref="PeerConnection.RemoteAudioTrackAdded"/> event, and disposed by the peer connection
+    /// once removed.
+    /// </remarks>
+    public class RemoteAudioTrack : IDisposable
+    {
+        /// <summary>
+        /// Peer connection this audio track is part of, if any.
+        /// This is <c>null</c> after the track has been removed from the peer connection.
+        /// </summary>
+        public PeerConnection PeerConnection { get; private set; }
+
+        /// <summary>
+        /// Track name, which is the track ID negotiated with the remote peer. This property is immutable.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Handle to the native RemoteAudioTrack object.
+        /// </summary>
+        /// <remarks>
+        /// In native land this is a <code>Microsoft::MixedReality::WebRTC::RemoteAudioTrackHandle</code>.
+        /// </remarks>
+        internal RemoteAudioTrackHandle _nativeHandle { get; private set; } = new RemoteAudioTrackHandle();
+
+        internal RemoteAudioTrack(RemoteAudioTrackHandle nativeHandle, PeerConnection peer, string trackName)
+        {
+            _nativeHandle = nativeHandle;
+            PeerConnection = peer;
+            Name = trackName;
+        }
+
+        /// <summary>
+        /// Create a stream reading the audio of this track alone, with the same buffering and
+        /// resampling as <see cref="PeerConnection.CreateAudioReadStream"/>. Only one stream
+        /// per track receives audio at a time. The stream reads silence once the track is removed.
+        /// </summary>
+        /// <param name="bufferMs">Size of the buffer in milliseconds or -1 for the default of 60 ms.</param>
+        /// <param name="resampleMode">Sample format in which the audio is resampled, if needed.</param>
+        public IAudioReadStream CreateAudioReadStream(int bufferMs = -1,
+            AudioResampleMode resampleMode = AudioResampleMode.Int16)
+        {
+            return new PeerConnection.AudioReadStream(_nativeHandle, bufferMs, resampleMode);
+        }
+
+        /// <inheritdoc/>
+        public void Dispose()
+        {
+            if (_nativeHandle.IsClosed)
+            {
+                return;
+            }
+
+            // Release the native object. The native track stays alive as long as the peer
+            // connection or an audio read stream still references it.
+            _nativeHandle.Dispose();
+        }
+
+        internal void OnTrackRemoved(PeerConnection previousConnection)
+        {
+            if (PeerConnection == previousConnection)
+            {
+                PeerConnection = null;
+            }
+        }
+    }
+}
@@ -0,0 +1,375 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+using System;
+using System.Threading;
+using Microsoft.MixedReality.WebRTC.Interop;
+
+namespace Microsoft.MixedReality.WebRTC
+{
+    /// <summary>
+    /// Video track receiving video frames from the remote peer.
+    /// </summary>
+    /// <remarks>
+    /// Each remote video track delivers its own frames, separately from other remote video tracks
+    /// of the same peer connection, with its own output formats, target sizes, and delivery mode.
+    /// Instances are created by the peer connection, and made available through the
+    /// <see cref="PeerConnection.RemoteVideoTrackAdded"/> event, and disposed by the peer connection
+    /// once removed.
+    /// </remarks>
+    public class RemoteVideoTrack : IDisposable
+    {
+        /// <summary>
+        /// Peer connection this video track is part of, if any.
+        /// This is <c>null</c> after the track has been removed from the peer connection.
+        /// </summary>
+        public PeerConnection PeerConnection { get; private set; }
+
+        /// <summary>
+        /// Track name, which is the track ID negotiated with the remote peer. This property is immutable.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Event that occurs when a video frame has been received from the remote peer on this track
+        /// and is available for render.
+        /// </summary>
+        /// <remarks>
+        /// The native layer only converts and marshals frames to I420A while this event has at least
+        /// one handler.
+        /// </remarks>
+        public event I420AVideoFrameDelegate I420AVideoFrameReady
+        {
+            add
+            {
+                UpdateHandlers(ref _i420aVideoFrameReady, value, add: true);
+                UpdateCallbackRegistrations();
+            }
+            remove
+            {
+                UpdateHandlers(ref _i420aVideoFrameReady, value, add: false);
+                UpdateCallbackRegistrations();
+            }
+        }
+
+        /// <summary>
+        /// Event that occurs when a video frame has been received from the remote peer on this track
+        /// and is available for render.
+        /// </summary>
+        /// <remarks>
+        /// The native layer only converts and marshals frames to ARGB32 while this event has at least
+        /// one handler.
+        /// </remarks>
+        public event Argb32VideoFrameDelegate Argb32VideoFrameReady
+        {
+            add
+            {
+                UpdateHandlers(ref _argb32VideoFrameReady, value, add: true);
+                UpdateCallbackRegistrations();
+            }
+            remove
+            {
+                UpdateHandlers(ref _argb32VideoFrameReady, value, add: false);
+                UpdateCallbackRegistrations();
+            }
+        }
+
+        /// <summary>
+        /// Handle to the native RemoteVideoTrack object.
+        /// </summary>
+        /// <remarks>
+        /// In native land this is a <code>Microsoft::MixedReality::WebRTC::RemoteVideoTrackHandle</code>.
+        /// </remarks>
+        internal RemoteVideoTrackHandle _nativeHandle { get; private set; } = new RemoteVideoTrackHandle();
+
+        /// <summary>
+        /// Handle to self for interop callbacks. This adds a reference to the current object, preventing
+        /// it from being garbage-collected.
+        /// </summary>
+        private IntPtr _selfHandle = IntPtr.Zero;
+
+        /// <summary>
+        /// Callback arguments to ensure delegates registered with the native layer don't go out of scope.
+        /// </summary>
+        private RemoteVideoTrackInterop.InteropCallbackArgs _interopCallbackArgs;
+
+        /// <summary>
+        /// Lock serializing the registration of the native frame callbacks. The frame event handlers
+        /// themselves are updated lock-free, like field-like events, so that a handler can be added or
+        /// removed from inside a frame event without waiting for this lock.
+        /// </summary>
+        private readonly object _frameReadyLock = new object();
+
+        /// <summary>
+        /// Backing field of <see cref="I420AVideoFrameReady"/>.
+        /// </summary>
+        private I420AVideoFrameDelegate _i420aVideoFrameReady;
+
+        /// <summary>
+        /// Backing field of <see cref="Argb32VideoFrameReady"/>.
+        /// </summary>
+        private Argb32VideoFrameDelegate _argb32VideoFrameReady;
+
+        /// <summary>
+        /// Is the native I420A frame callback currently registered?
+        /// </summary>
+        private bool _i420aCallbackRegistered = false;
+
+        /// <summary>
+        /// Is the native ARGB32 frame callback currently registered?
+        /// </summary>
+        private bool _argb32CallbackRegistered = false;
+
+        /// <summary>
+        /// Number of frame events of this track currently being invoked. The native layer does not allow
+        /// changing a frame callback from inside a frame callback, so changes to the handlers made while
+        /// a frame event is being invoked are deferred until the event returns.
+        /// </summary>
+        private int _frameReadyDepth = 0;
+
+        /// <summary>
+        /// Non-zero if a change to the frame event handlers was deferred and the native registrations
+        /// still need to be updated.
+        /// </summary>
+        private int _callbackUpdatePending = 0;
+
+        internal RemoteVideoTrack(RemoteVideoTrackHandle nativeHandle, PeerConnection peer, string trackName)
+        {
+            _nativeHandle = nativeHandle;
+            PeerConnection = peer;
+            Name = trackName;
+            _interopCallbackArgs = new RemoteVideoTrackInterop.InteropCallbackArgs()
+            {
+                Track = this,
+                I420AFrameCallback = RemoteVideoTrackInterop.I420AFrameCallback,
+                Argb32FrameCallback = RemoteVideoTrackInterop.Argb32FrameCallback,
+            };
+            _selfHandle = Utils.MakeWrapperRef(this);
+        }
+
+        /// <summary>
+        /// Atomically add or remove <paramref name="value"/> to or from the handlers in <paramref name="field"/>.
+        /// </summary>
+        private static void UpdateHandlers<T>(ref T field, T value, bool add) where T : Delegate
+        {
+            T current = field;
+            T previous;
+            do
+            {
+                previous = current;
+                T updated = (T)(add ? Delegate.Combine(previous, value) : Delegate.Remove(previous, value));
+                current = Interlocked.CompareExchange(ref field, updated, previous);
+            }
+            while (current != previous);
+        }
+
+        /// <summary>
+        /// Register the native frame callback of each format whose frame event has a handler, and
+        /// unregister the others, so that the native layer only converts and marshals frames to formats
+        /// actually in use. If a frame event is being invoked, the update is deferred and applied from
+        /// the thread pool once the event returns; see <see cref="EndFrameEvent"/>.
+        /// </summary>
+        private void UpdateCallbackRegistrations()
+        {
+            // Flag the update before checking the depth, so that a frame event returning concurrently
+            // either sees the flag or lets this call see a zero depth.
+            Interlocked.Exchange(ref _callbackUpdatePending, 1);
+            if (Volatile.Read(ref _frameReadyDepth) > 0)
+            {
+                return;
+            }
+            Interlocked.Exchange(ref _callbackUpdatePending, 0);
+            lock (_frameReadyLock)
+            {
+                if (_nativeHandle.IsClosed)
+                {
+                    return;
+                }
+                UpdateI420ACallbackRegistration();
+                UpdateArgb32CallbackRegistration();
+            }
+        }
+
+        /// <summary>
+        /// Register the native I420A frame callback if <see cref="I420AVideoFrameReady"/> has a handler,
+        /// or unregister it otherwise. Must be called with <see cref="_frameReadyLock"/> held.
+        /// </summary>
+        private void UpdateI420ACallbackRegistration()
+        {
+            bool needed = (_i420aVideoFrameReady != null);
+            if (needed == _i420aCallbackRegistered)
+            {
+                return;
+            }
+            if (needed)
+            {
+                RemoteVideoTrackInterop.RemoteVideoTrack_RegisterI420AFrameCallback(
+                    _nativeHandle, _interopCallbackArgs.I420AFrameCallback, _selfHandle);
+            }
+            else
+            {
+                RemoteVideoTrackInterop.RemoteVideoTrack_RegisterI420AFrameCallback(_nativeHandle, null, IntPtr.Zero);
+            }
+            _i420aCallbackRegistered = needed;
+        }
+
+        /// <summary>
+        /// Same as <see cref="UpdateI420ACallbackRegistration"/> for <see cref="Argb32VideoFrameReady"/>.
+        /// </summary>
+        private void UpdateArgb32CallbackRegistration()
+        {
+            bool needed = (_argb32VideoFrameReady != null);
+            if (needed == _argb32CallbackRegistered)
+            {
+                return;
+            }
+            if (needed)
+            {
+                RemoteVideoTrackInterop.RemoteVideoTrack_RegisterArgb32FrameCallback(
+                    _nativeHandle, _interopCallbackArgs.Argb32FrameCallback, _selfHandle);
+            }
+            else
+            {
+                RemoteVideoTrackInterop.RemoteVideoTrack_RegisterArgb32FrameCallback(_nativeHandle, null, IntPtr.Zero);
+            }
+            _argb32CallbackRegistered = needed;
+        }
+
+        /// <summary>
+        /// Set the size the frames of this track are scaled to before being delivered in the given format.
+        /// See <see cref="PeerConnection.SetRemoteVideoFrameTargetSize"/> for details.
+        /// </summary>
+        /// <param name="format">Format of the frame event to configure.</param>
+        /// <param name="width">Maximum width of the delivered frames, or zero to disable scaling.</param>
+        /// <param name="height">Maximum height of the delivered frames, or zero to disable scaling.</param>
+        public void SetFrameTargetSize(VideoFrameFormat format, int width, int height)
+        {
+            uint res = RemoteVideoTrackInterop.RemoteVideoTrack_SetFrameTargetSize(_nativeHandle, format, width, height);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// Set the delivery mode of the frame events of this track.
+        /// See <see cref="PeerConnection.SetRemoteVideoDeliveryMode"/> for details.
+        /// </summary>
+        /// <param name="mode">The new delivery mode.</param>
+        public void SetDeliveryMode(VideoFrameDeliveryMode mode)
+        {
+            uint res = RemoteVideoTrackInterop.RemoteVideoTrack_SetDeliveryMode(_nativeHandle, mode);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <summary>
+        /// In <see cref="VideoFrameDeliveryMode.Polled"/> mode, fire the frame events for the latest
+        /// frame received on this track, if any, on the calling thread.
+        /// </summary>
+        /// <returns>Return <c>true</c> if a new frame was delivered.</returns>
+        public bool PollFrame()
+        {
+            return (RemoteVideoTrackInterop.RemoteVideoTrack_PollFrame(_nativeHandle) != 0);
+        }
+
+        /// <summary>
+        /// Get the latency statistics of the frames delivered to the frame events of this track,
+        /// since the track was added or the statistics were last reset.
+        /// </summary>
+        /// <returns>The latency statistics of the track.</returns>
+        public VideoFrameLatencyStats GetLatencyStats()
+        {
+            uint res = RemoteVideoTrackInterop.RemoteVideoTrack_GetLatencyStats(_nativeHandle, out VideoFrameLatencyStats stats);
+            Utils.ThrowOnErrorCode(res);
+            return stats;
+        }
+
+        /// <summary>
+        /// Reset the latency statistics returned by <see cref="GetLatencyStats"/>.
+        /// </summary>
+        public void ResetLatencyStats()
+        {
+            uint res = RemoteVideoTrackInterop.RemoteVideoTrack_ResetLatencyStats(_nativeHandle);
+            Utils.ThrowOnErrorCode(res);
+        }
+
+        /// <inheritdoc/>
+        public void Dispose()
+        {
+            if (_nativeHandle.IsClosed)
+            {
+                return;
+            }
+
+            // Unregister interop callbacks, under the lock so that no concurrent change to the frame
+            // events registers them again.
+            lock (_frameReadyLock)
+            {
+                if (_i420aCallbackRegistered)
+                {
+                    RemoteVideoTrackInterop.RemoteVideoTrack_RegisterI420AFrameCallback(_nativeHandle, null, IntPtr.Zero);
+                    _i420aCallbackRegistered = false;
+                }
+                if (_argb32CallbackRegistered)
+                {
+                    RemoteVideoTrackInterop.RemoteVideoTrack_RegisterArgb32FrameCallback(_nativeHandle, null, IntPtr.Zero);
+                    _argb32CallbackRegistered = false;
+                }
+                if (_selfHandle != IntPtr.Zero)
+                {
+                    Utils.ReleaseWrapperRef(_selfHandle);
+                    _selfHandle = IntPtr.Zero;
+                    _interopCallbackArgs = null;
+                }
+
+                // Release the native object. The native track stays alive as long as the peer
+                // connection still references it.
+                _nativeHandle.Dispose();
+            }
+        }
+
+        internal void OnI420AFrameReady(in I420AVideoFrame frame)
+        {
+            Interlocked.Increment(ref _frameReadyDepth);
+            try
+            {
+                _i420aVideoFrameReady?.Invoke(in frame);
+            }
+            finally
+            {
+                EndFrameEvent();
+            }
+        }
+
+        internal void OnArgb32FrameReady(in Argb32VideoFrame frame)
+        {
+            Interlocked.Increment(ref _frameReadyDepth);
+            try
+            {
+                _argb32VideoFrameReady?.Invoke(in frame);
+            }
+            finally
+            {
+                EndFrameEvent();
+            }
+        }
+
+        /// <summary>
+        /// Leave a frame event, and apply any change to the handlers deferred while it was invoked.
+        /// The update is queued to the thread pool since the native frame callback has not returned yet.
+        /// </summary>
+        private void EndFrameEvent()
+        {
+            if ((Interlocked.Decrement(ref _frameReadyDepth) == 0)
+                && (Interlocked.Exchange(ref _callbackUpdatePending, 0) != 0))
+            {
+                ThreadPool.QueueUserWorkItem(_ => UpdateCallbackRegistrations());
+            }
+        }
+
+        internal void OnTrackRemoved(PeerConnection previousConnection)
+        {
+            if (PeerConnection == previousConnection)
+            {
+                PeerConnection = null;
+            }
+        }
+    }
+}
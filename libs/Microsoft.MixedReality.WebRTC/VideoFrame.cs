@@ -2,10 +2,160 @@
 // Licensed under the MIT License.
 
 using System;
+using System.Runtime.InteropServices;
 using Microsoft.MixedReality.WebRTC.Interop;
 
 namespace Microsoft.MixedReality.WebRTC
 {
+    /// <summary>
+    /// Format of the video frames delivered to a video frame callback.
+    /// </summary>
+    public enum VideoFrameFormat : int
+    {
+        /// <summary>
+        /// I420 with optional alpha plane, see <see cref="I420AVideoFrame"/>.
+        /// </summary>
+        I420A = 0,
+
+        /// <summary>
+        /// 32-bit ARGB, see <see cref="Argb32VideoFrame"/>.
+        /// </summary>
+        Argb32 = 1,
+
+        /// <summary>
+        /// NV12 biplanar YUV.
+        /// </summary>
+        Nv12 = 2,
+
+        /// <summary>
+        /// 32-bit RGBA, with R first and A last in memory.
+        /// </summary>
+        Rgba32 = 3,
+
+        /// <summary>
+        /// 24-bit BGR, with B first and R last in memory.
+        /// </summary>
+        Bgr24 = 4,
+
+        /// <summary>
+        /// I420 packed into a single contiguous memory block.
+        /// </summary>
+        I420Packed = 5
+    }
+
+    /// <summary>
+    /// Delivery mode of the video frames to the video frame events.
+    /// </summary>
+    public enum VideoFrameDeliveryMode : int
+    {
+        /// <summary>
+        /// Events are fired on the thread producing the frames, like the WebRTC decoder thread,
+        /// as soon as each frame is available.
+        /// </summary>
+        Inline = 0,
+
+        /// <summary>
+        /// Only the latest frame is kept until the application polls for it, and events are fired
+        /// on the polling thread. Frames replaced by a newer one before being polled are never converted.
+        /// </summary>
+        Polled = 1
+    }
+
+    /// <summary>
+    /// Timing metadata of a video frame, to correlate it with the frame sent by the remote peer
+    /// and measure latency. All local times use the same monotonic clock as the native WebRTC library.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VideoFrameTiming
+    {
+        /// <summary>
+        /// Sequence number assigned to each frame received by a track, starting from 1.
+        /// Gaps indicate frames dropped before delivery.
+        /// </summary>
+        public long frameId;
+
+        /// <summary>
+        /// Local time at which the frame is expected to be rendered, in microseconds, as set by the decoder.
+        /// </summary>
+        public long timestampUs;
+
+        /// <summary>
+        /// Capture time of the frame on the sender, in milliseconds since the NTP epoch, or zero until
+        /// the sender clock is estimated from RTCP reports.
+        /// </summary>
+        public long ntpTimeMs;
+
+        /// <summary>
+        /// Local time at which the decoded frame was received, in microseconds.
+        /// </summary>
+        public long receivedTimeUs;
+
+        /// <summary>
+        /// RTP timestamp of the frame, in units of the 90 kHz RTP video clock.
+        /// </summary>
+        public uint rtpTimestamp;
+    }
+
+    /// <summary>
+    /// Histogram of latency samples. Bucket #0 counts samples below 64 microseconds, bucket #i
+    /// counts samples in [2^(i+5), 2^(i+6)) microseconds, and the last bucket counts all samples
+    /// of 2^20 microseconds (about 1 second) and above.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VideoLatencyHistogram
+    {
+        /// <summary>
+        /// Number of buckets of the histogram.
+        /// </summary>
+        public const int BucketCount = 16;
+
+        /// <summary>
+        /// Total number of samples.
+        /// </summary>
+        public ulong count;
+
+        /// <summary>
+        /// Sum of all samples, in microseconds.
+        /// </summary>
+        public long sumUs;
+
+        /// <summary>
+        /// Smallest sample, in microseconds, or zero if there is no sample.
+        /// </summary>
+        public long minUs;
+
+        /// <summary>
+        /// Largest sample, in microseconds, or zero if there is no sample.
+        /// </summary>
+        public long maxUs;
+
+        /// <summary>
+        /// Number of samples in each bucket.
+        /// </summary>
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = BucketCount)]
+        public ulong[] buckets;
+    }
+
+    /// <summary>
+    /// Latency statistics of the frames delivered by a video track, with one sample per
+    /// frame event invocation.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VideoFrameLatencyStats
+    {
+        /// <summary>
+        /// Time from receiving the decoded frame to invoking a frame event, which includes scaling
+        /// and conversion, and in <see cref="VideoFrameDeliveryMode.Polled"/> mode the time spent
+        /// waiting to be polled.
+        /// </summary>
+        public VideoLatencyHistogram delivery;
+
+        /// <summary>
+        /// Time spent inside the frame events.
+        /// </summary>
+        public VideoLatencyHistogram callback;
+    }
+
     /// <summary>
     /// Single video frame encoded in I420A format (triplanar YUV with optional alpha plane).
     /// See e.g. https://wiki.videolan.org/YUV/#I420 for details.
@@ -73,6 +223,17 @@ namespace Microsoft.MixedReality.WebRTC
         /// </summary>
         public int strideA;
 
+        /// <summary>
+        /// Optional handle to the native buffer holding the frame data, or <c>IntPtr.Zero</c>
+        /// if the frame cannot be retained. This is ignored for frames passed to the native library.
+        /// </summary>
+        public IntPtr bufferHandle;
+
+        /// <summary>
+        /// Timing metadata of the frame. This is ignored for frames passed to the native library.
+        /// </summary>
+        public VideoFrameTiming timing;
+
         /// <summary>
         /// Copy the frame content to a <xref href="System.Byte"/>[] buffer as a contiguous block of memory
         /// containing the Y, U, and V planes one after another, and the alpha plane at the end if present.
@@ -148,6 +309,98 @@ namespace Microsoft.MixedReality.WebRTC
         /// Stride in bytes between the ARGB rows.
         /// </summary>
         public int stride;
+
+        /// <summary>
+        /// Optional handle to the native buffer holding the frame data, or <c>IntPtr.Zero</c>
+        /// if the frame cannot be retained. This is ignored for frames passed to the native library.
+        /// </summary>
+        public IntPtr bufferHandle;
+
+        /// <summary>
+        /// Timing metadata of the frame. This is ignored for frames passed to the native library.
+        /// </summary>
+        public VideoFrameTiming timing;
+
+        /// <summary>
+        /// Retain the frame data beyond the callback which delivered the frame, without copying it.
+        /// </summary>
+        /// <returns>The retained frame, which must be disposed as soon as possible to allow the
+        /// native buffer to be reused, or <c>null</c> if the frame cannot be retained.</returns>
+        public RetainedArgb32VideoFrame Retain()
+        {
+            if (bufferHandle == IntPtr.Zero)
+            {
+                return null;
+            }
+            return new RetainedArgb32VideoFrame(this);
+        }
+    }
+
+    /// <summary>
+    /// ARGB-encoded video frame retained with <see cref="Argb32VideoFrame.Retain"/>, whose data remains
+    /// valid until the object is disposed. Disposing can be done from any thread.
+    /// </summary>
+    public sealed class RetainedArgb32VideoFrame : IDisposable
+    {
+        /// <summary>
+        /// Frame width, in pixels.
+        /// </summary>
+        public readonly uint width;
+
+        /// <summary>
+        /// Frame height, in pixels.
+        /// </summary>
+        public readonly uint height;
+
+        /// <summary>
+        /// Pointer to the data buffer containing the ARBG data for each pixel, valid until disposed.
+        /// </summary>
+        public IntPtr Data { get; private set; }
+
+        /// <summary>
+        /// Stride in bytes between the ARGB rows.
+        /// </summary>
+        public readonly int stride;
+
+        /// <summary>
+        /// Timing metadata of the frame.
+        /// </summary>
+        public readonly VideoFrameTiming timing;
+
+        private IntPtr _bufferHandle;
+
+        internal RetainedArgb32VideoFrame(in Argb32VideoFrame frame)
+        {
+            width = frame.width;
+            height = frame.height;
+            Data = frame.data;
+            stride = frame.stride;
+            timing = frame.timing;
+            _bufferHandle = frame.bufferHandle;
+            Utils.VideoFrameBufferAddRef(_bufferHandle);
+        }
+
+        ~RetainedArgb32VideoFrame()
+        {
+            Release();
+        }
+
+        /// <inheritdoc/>
+        public void Dispose()
+        {
+            Release();
+            GC.SuppressFinalize(this);
+        }
+
+        private void Release()
+        {
+            IntPtr handle = System.Threading.Interlocked.Exchange(ref _bufferHandle, IntPtr.Zero);
+            if (handle != IntPtr.Zero)
+            {
+                Data = IntPtr.Zero;
+                Utils.VideoFrameBufferRemoveRef(handle);
+            }
+        }
     }
 
     /// <summary>
@@ -156,4 +409,176 @@ namespace Microsoft.MixedReality.WebRTC
     /// </summary>
     /// <param name="frame">The newly available ARGB-encoded video frame.</param>
     public delegate void Argb32VideoFrameDelegate(in Argb32VideoFrame frame);
+
+    /// <summary>
+    /// Single video frame encoded in NV12 biplanar format, to be passed to an
+    /// <see cref="ExternalVideoTrackSource"/>.
+    /// 
+    /// The frame has a full resolution Y plane followed by a half resolution plane of
+    /// interleaved U and V samples, with U first.
+    /// </summary>
+    public ref struct Nv12VideoFrame
+    {
+        /// <summary>
+        /// Frame width, in pixels.
+        /// </summary>
+        public uint width;
+
+        /// <summary>
+        /// Frame height, in pixels.
+        /// </summary>
+        public uint height;
+
+        /// <summary>
+        /// Pointer to the Y plane buffer.
+        /// </summary>
+        public IntPtr dataY;
+
+        /// <summary>
+        /// Pointer to the interleaved UV plane buffer.
+        /// </summary>
+        public IntPtr dataUV;
+
+        /// <summary>
+        /// Stride in bytes between rows of the Y plane.
+        /// </summary>
+        public int strideY;
+
+        /// <summary>
+        /// Stride in bytes between rows of the UV plane.
+        /// </summary>
+        public int strideUV;
+
+        /// <summary>
+        /// Optional handle to the native buffer holding the frame data. This is ignored for frames
+        /// passed to the native library.
+        /// </summary>
+        public IntPtr bufferHandle;
+
+        /// <summary>
+        /// Timing metadata of the frame. This is ignored for frames passed to the native library.
+        /// </summary>
+        public VideoFrameTiming timing;
+    }
+
+    /// <summary>
+    /// Single video frame encoded in YUY2 packed 4:2:2 format, to be passed to an
+    /// <see cref="ExternalVideoTrackSource"/>.
+    /// 
+    /// Each pair of pixels is stored as the (Y0, U, Y1, V) sequence of bytes in memory.
+    /// </summary>
+    public ref struct Yuy2VideoFrame
+    {
+        /// <summary>
+        /// Frame width, in pixels.
+        /// </summary>
+        public uint width;
+
+        /// <summary>
+        /// Frame height, in pixels.
+        /// </summary>
+        public uint height;
+
+        /// <summary>
+        /// Pointer to the data buffer containing the YUY2 data.
+        /// </summary>
+        public IntPtr data;
+
+        /// <summary>
+        /// Stride in bytes between the YUY2 rows.
+        /// </summary>
+        public int stride;
+
+        /// <summary>
+        /// Optional handle to the native buffer holding the frame data. This is ignored for frames
+        /// passed to the native library.
+        /// </summary>
+        public IntPtr bufferHandle;
+
+        /// <summary>
+        /// Timing metadata of the frame. This is ignored for frames passed to the native library.
+        /// </summary>
+        public VideoFrameTiming timing;
+    }
+
+    /// <summary>
+    /// Single video frame encoded in BGR interleaved format (24 bits per pixel), to be passed to an
+    /// <see cref="ExternalVideoTrackSource"/>.
+    /// 
+    /// Each pixel is stored as the (B, G, R) sequence of bytes in memory, with B first.
+    /// </summary>
+    public ref struct Bgr24VideoFrame
+    {
+        /// <summary>
+        /// Frame width, in pixels.
+        /// </summary>
+        public uint width;
+
+        /// <summary>
+        /// Frame height, in pixels.
+        /// </summary>
+        public uint height;
+
+        /// <summary>
+        /// Pointer to the data buffer containing the BGR data for each pixel.
+        /// </summary>
+        public IntPtr data;
+
+        /// <summary>
+        /// Stride in bytes between the BGR rows.
+        /// </summary>
+        public int stride;
+
+        /// <summary>
+        /// Optional handle to the native buffer holding the frame data. This is ignored for frames
+        /// passed to the native library.
+        /// </summary>
+        public IntPtr bufferHandle;
+
+        /// <summary>
+        /// Timing metadata of the frame. This is ignored for frames passed to the native library.
+        /// </summary>
+        public VideoFrameTiming timing;
+    }
+
+    /// <summary>
+    /// Single video frame encoded in RGBA interleaved format (32 bits per pixel), to be passed to an
+    /// <see cref="ExternalVideoTrackSource"/>.
+    /// 
+    /// Each pixel is stored as the (R, G, B, A) sequence of bytes in memory, with R first
+    /// and A last.
+    /// </summary>
+    public ref struct Rgba32VideoFrame
+    {
+        /// <summary>
+        /// Frame width, in pixels.
+        /// </summary>
+        public uint width;
+
+        /// <summary>
+        /// Frame height, in pixels.
+        /// </summary>
+        public uint height;
+
+        /// <summary>
+        /// Pointer to the data buffer containing the RGBA data for each pixel.
+        /// </summary>
+        public IntPtr data;
+
+        /// <summary>
+        /// Stride in bytes between the RGBA rows.
+        /// </summary>
+        public int stride;
+
+        /// <summary>
+        /// Optional handle to the native buffer holding the frame data. This is ignored for frames
+        /// passed to the native library.
+        /// </summary>
+        public IntPtr bufferHandle;
+
+        /// <summary>
+        /// Timing metadata of the frame. This is ignored for frames passed to the native library.
+        /// </summary>
+        public VideoFrameTiming timing;
+    }
 }